@@ -128,6 +128,10 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+
+	// Returns a read-only view of the whole file if it can be mapped in memory, nullptr otherwise.
+	// The view stays valid until the file is closed.
+	virtual const uint8_t *map_memory() { return nullptr; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -31,6 +31,7 @@
 #include "file_access_compressed.h"
 
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
@@ -58,41 +59,218 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 		}                                                   \
 	}
 
+struct FileAccessCompressedWriteBlocks {
+	const uint8_t *src = nullptr;
+	uint64_t total = 0;
+	uint32_t block_size = 0;
+	Compression::Mode mode = Compression::MODE_ZSTD;
+
+	struct Block {
+		Vector<uint8_t> data;
+		int size = 0;
+	};
+	LocalVector<Block> blocks;
+};
+
+void FileAccessCompressed::_compress_block(void *p_userdata, uint32_t p_index) {
+	FileAccessCompressedWriteBlocks *wb = (FileAccessCompressedWriteBlocks *)p_userdata;
+	uint64_t from = (uint64_t)p_index * wb->block_size;
+	uint32_t bl = MIN((uint64_t)wb->block_size, wb->total - from);
+
+	FileAccessCompressedWriteBlocks::Block &block = wb->blocks[p_index];
+	block.data.resize(Compression::get_max_compressed_buffer_size(bl, wb->mode));
+	block.size = Compression::compress(block.data.ptrw(), &wb->src[from], bl, wb->mode);
+}
+
+void FileAccessCompressed::_decompress_block(void *p_slot) {
+	BlockSlot *slot = (BlockSlot *)p_slot;
+	if (slot->size == 0) {
+		// Version 1 files end with an empty block when the size is a multiple of the block size.
+		slot->result = 0;
+		return;
+	}
+	slot->result = Compression::decompress(slot->data.ptrw(), slot->size, slot->compressed.ptr(), slot->compressed.size(), slot->mode);
+}
+
+uint32_t FileAccessCompressed::_get_block_size(uint32_t p_block) const {
+	if (p_block + 1 < read_block_count) {
+		return block_size;
+	}
+	return read_total - (uint64_t)p_block * block_size;
+}
+
+bool FileAccessCompressed::_read_compressed_block(BlockSlot &r_slot, uint32_t p_block) const {
+	const ReadBlock &rb = read_blocks[p_block];
+	r_slot.block = UINT32_MAX;
+	r_slot.mode = cmode;
+	r_slot.size = _get_block_size(p_block);
+	if (r_slot.data.size() < (int)block_size) {
+		r_slot.data.resize(block_size);
+	}
+	r_slot.compressed.resize(rb.csize);
+
+	f->seek(rb.offset);
+	ERR_FAIL_COND_V_MSG(f->get_buffer(r_slot.compressed.ptrw(), rb.csize) != rb.csize, false, "Compressed file is truncated.");
+	r_slot.block = p_block;
+	return true;
+}
+
+void FileAccessCompressed::_wait_for_slot(BlockSlot &r_slot) const {
+	if (r_slot.task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(r_slot.task_id);
+		r_slot.task_id = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+FileAccessCompressed::BlockSlot *FileAccessCompressed::_get_free_slot(uint32_t p_window_begin) const {
+	// Any slot holding a block outside of the read-ahead window can be reused.
+	for (BlockSlot &slot : block_slots) {
+		if (slot.block == UINT32_MAX || slot.block < p_window_begin || slot.block > p_window_begin + READ_AHEAD_BLOCKS) {
+			_wait_for_slot(slot);
+			slot.block = UINT32_MAX;
+			return &slot;
+		}
+	}
+	return nullptr;
+}
+
+bool FileAccessCompressed::_load_block(uint32_t p_block, bool p_read_ahead) const {
+	// The slot holding the current block may be reused below.
+	read_ptr = nullptr;
+
+	BlockSlot *slot = nullptr;
+	for (BlockSlot &s : block_slots) {
+		if (s.block == p_block) {
+			slot = &s;
+			break;
+		}
+	}
+
+	if (slot) {
+		_wait_for_slot(*slot);
+	} else {
+		slot = _get_free_slot(p_block);
+		ERR_FAIL_NULL_V(slot, false);
+		if (!_read_compressed_block(*slot, p_block)) {
+			return false;
+		}
+		_decompress_block(slot);
+	}
+
+	if (slot->result == -1) {
+		slot->block = UINT32_MAX;
+		ERR_FAIL_V_MSG(false, "Compressed file is corrupt.");
+	}
+
+	read_ptr = slot->data.ptr();
+	read_block = p_block;
+	read_block_size = slot->size;
+	read_pos = 0;
+
+	if (p_read_ahead && read_ahead) {
+		// Reading is sequential, decompress the next blocks on the WorkerThreadPool while this one is read.
+		for (uint32_t i = 1; i <= READ_AHEAD_BLOCKS && p_block + i < read_block_count; i++) {
+			uint32_t next = p_block + i;
+			bool loaded = false;
+			for (const BlockSlot &s : block_slots) {
+				if (s.block == next) {
+					loaded = true;
+					break;
+				}
+			}
+			if (loaded) {
+				continue;
+			}
+
+			BlockSlot *next_slot = _get_free_slot(p_block);
+			if (!next_slot || !_read_compressed_block(*next_slot, next)) {
+				break;
+			}
+			next_slot->task_id = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessCompressed::_decompress_block, next_slot, true, "FileAccessCompressed read-ahead");
+		}
+	}
+
+	return true;
+}
+
+bool FileAccessCompressed::_next_block() const {
+	uint32_t next = read_block + 1;
+	if (next >= read_block_count || _get_block_size(next) == 0) {
+		return false;
+	}
+	return _load_block(next, true);
+}
+
 Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	f = p_base;
-	cmode = (Compression::Mode)f->get_32();
+	uint32_t mode_version = f->get_32();
+	uint32_t version = mode_version >> FORMAT_VERSION_SHIFT;
+	cmode = (Compression::Mode)(mode_version & ((1 << FORMAT_VERSION_SHIFT) - 1));
 	block_size = f->get_32();
 	if (block_size == 0) {
 		f.unref();
 		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Can't open compressed file '" + p_base->get_path() + "' with block size 0, it is corrupted.");
 	}
-	read_total = f->get_32();
-	uint32_t bc = (read_total / block_size) + 1;
-	uint64_t acc_ofs = f->get_position() + bc * 4;
-	uint32_t max_bs = 0;
+
+	uint32_t bc = 0;
+	uint64_t acc_ofs = 0;
+	uint64_t blocks_end = 0;
+	if (version == 0) {
+		// Version 1, the block size table follows the header.
+		read_total = f->get_32();
+		bc = (read_total / block_size) + 1;
+		acc_ofs = f->get_position() + bc * 4;
+		blocks_end = f->get_length();
+	} else if (version == FORMAT_VERSION) {
+		// The block size table and the total size are in the footer, so the file could be written in a single pass.
+		acc_ofs = f->get_position();
+		uint64_t len = f->get_length();
+		if (len < acc_ofs + 16) {
+			f.unref();
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Can't open compressed file '" + p_base->get_path() + "', it is truncated.");
+		}
+		f->seek(len - 16);
+		read_total = f->get_64();
+		bc = f->get_32();
+		blocks_end = len - 16 - (uint64_t)bc * 4;
+		if ((uint64_t)bc * 4 > len - 16 - acc_ofs || bc != (read_total + block_size - 1) / block_size) {
+			f.unref();
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Can't open compressed file '" + p_base->get_path() + "' with an invalid block index, it is corrupted.");
+		}
+		f->seek(blocks_end);
+	} else {
+		f.unref();
+		ERR_FAIL_V_MSG(ERR_FILE_UNRECOGNIZED, vformat("Can't open compressed file '%s' with unsupported format version %d.", p_base->get_path(), version));
+	}
+
+	read_blocks.resize(bc);
+	ReadBlock *rbw = read_blocks.ptrw();
 	for (uint32_t i = 0; i < bc; i++) {
-		ReadBlock rb;
-		rb.offset = acc_ofs;
-		rb.csize = f->get_32();
-		acc_ofs += rb.csize;
-		max_bs = MAX(max_bs, rb.csize);
-		read_blocks.push_back(rb);
-	}
-
-	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
-	at_end = false;
-	read_eof = false;
-	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
+		rbw[i].offset = acc_ofs;
+		rbw[i].csize = f->get_32();
+		acc_ofs += rbw[i].csize;
+	}
+	if (acc_ofs > blocks_end) {
+		read_blocks.clear();
+		f.unref();
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Can't open compressed file '" + p_base->get_path() + "' with blocks past its end, it is corrupted.");
+	}
 
-	int ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
+	read_block_count = bc;
+	read_ahead = block_size >= READ_AHEAD_MIN_BLOCK_SIZE && bc > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0;
+	read_eof = false;
 	read_block = 0;
+	read_block_size = 0;
 	read_pos = 0;
+	read_ptr = nullptr;
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	at_end = read_total == 0;
+	if (!at_end && !_load_block(0, false)) {
+		_close();
+		return ERR_FILE_CORRUPT;
+	}
+
+	return OK;
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -137,44 +315,50 @@ void FileAccessCompressed::_close() {
 	}
 
 	if (writing) {
-		//save block table and all compressed blocks
+		// Compress all blocks, then write them followed by the block size table.
 
 		CharString mgc = magic.utf8();
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
+		f->store_32(cmode | (FORMAT_VERSION << FORMAT_VERSION_SHIFT)); //write compression mode and version 4
 		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		uint32_t bc = (write_max / block_size) + 1;
 
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
+		FileAccessCompressedWriteBlocks wb;
+		wb.src = write_ptr;
+		wb.total = write_max;
+		wb.block_size = block_size;
+		wb.mode = cmode;
+		uint32_t bc = (write_max + block_size - 1) / block_size;
+		wb.blocks.resize(bc);
+
+		if (bc > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&FileAccessCompressed::_compress_block, &wb, bc, -1, true, "FileAccessCompressed compress");
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < bc; i++) {
+				_compress_block(&wb, i);
+			}
 		}
 
-		Vector<int> block_sizes;
 		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
+			f->store_buffer(wb.blocks[i].data.ptr(), wb.blocks[i].size);
 		}
-
-		f->seek(16); //ok write block sizes
 		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
+			f->store_32(wb.blocks[i].size); //compressed sizes
 		}
-		f->seek_end();
+		f->store_64(write_max); //max amount of data written 8
+		f->store_32(bc); //block count 4
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
 
 		buffer.clear();
 
 	} else {
-		comp_buffer.clear();
-		buffer.clear();
+		for (BlockSlot &slot : block_slots) {
+			_wait_for_slot(slot);
+			slot.block = UINT32_MAX;
+			slot.compressed.clear();
+			slot.data.clear();
+		}
+		read_ptr = nullptr;
 		read_blocks.clear();
 	}
 	f.unref();
@@ -216,13 +400,11 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			at_end = false;
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
-			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+			if (block_idx != read_block || !read_ptr) {
+				if (!_load_block(block_idx, false)) {
+					at_end = true;
+					return;
+				}
 			}
 
 			read_pos = p_position % block_size;
@@ -243,6 +425,8 @@ uint64_t FileAccessCompressed::get_position() const {
 	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
 	if (writing) {
 		return write_pos;
+	} else if (at_end) {
+		return read_total;
 	} else {
 		return (uint64_t)read_block * block_size + read_pos;
 	}
@@ -278,21 +462,8 @@ uint8_t FileAccessCompressed::get_8() const {
 	uint8_t ret = read_ptr[read_pos];
 
 	read_pos++;
-	if (read_pos >= read_block_size) {
-		read_block++;
-
-		if (read_block < read_block_count) {
-			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			int total = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			ERR_FAIL_COND_V_MSG(total == -1, 0, "Compressed file is corrupt.");
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-			read_pos = 0;
-
-		} else {
-			read_block--;
-			at_end = true;
-		}
+	if (read_pos >= read_block_size && !_next_block()) {
+		at_end = true;
 	}
 
 	return ret;
@@ -308,28 +479,19 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
-
-			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
-
-			} else {
-				read_block--;
-				at_end = true;
-				if (i + 1 < p_length) {
-					read_eof = true;
-				}
-				return i + 1;
+	uint64_t dst_ofs = 0;
+	while (dst_ofs < p_length) {
+		uint64_t to_copy = MIN(p_length - dst_ofs, (uint64_t)(read_block_size - read_pos));
+		memcpy(&p_dst[dst_ofs], &read_ptr[read_pos], to_copy);
+		dst_ofs += to_copy;
+		read_pos += to_copy;
+
+		if (read_pos >= read_block_size && !_next_block()) {
+			at_end = true;
+			if (dst_ofs < p_length) {
+				read_eof = true;
 			}
+			return dst_ofs;
 		}
 	}
 
@@ -355,6 +517,19 @@ void FileAccessCompressed::store_8(uint8_t p_dest) {
 	write_ptr[write_pos++] = p_dest;
 }
 
+void FileAccessCompressed::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!writing, "File has not been opened in write mode.");
+	ERR_FAIL_COND(!p_src && p_length > 0);
+
+	if (p_length == 0) {
+		return;
+	}
+	WRITE_FIT(p_length);
+	memcpy(&write_ptr[write_pos], p_src, p_length);
+	write_pos += p_length;
+}
+
 bool FileAccessCompressed::file_exists(const String &p_name) {
 	Ref<FileAccess> fa = FileAccess::open(p_name, FileAccess::READ);
 	if (fa.is_null()) {
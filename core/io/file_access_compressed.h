@@ -33,8 +33,18 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 
 class FileAccessCompressed : public FileAccess {
+	enum {
+		// Version 1 stores the table of block sizes before the blocks, version 2 stores it after them,
+		// followed by a footer with the 64-bit total size. Versions other than 1 are stored along the mode.
+		FORMAT_VERSION = 2,
+		FORMAT_VERSION_SHIFT = 16,
+		READ_AHEAD_BLOCKS = 4, // Decompressed on the WorkerThreadPool while the current one is read.
+		READ_AHEAD_MIN_BLOCK_SIZE = 16384, // Smaller blocks are faster to decompress inline.
+	};
+
 	Compression::Mode cmode = Compression::MODE_ZSTD;
 	bool writing = false;
 	uint64_t write_pos = 0;
@@ -50,8 +60,20 @@ class FileAccessCompressed : public FileAccess {
 		uint64_t offset;
 	};
 
-	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	// A decompressed block, either the one being read or one being read ahead.
+	struct BlockSlot {
+		uint32_t block = UINT32_MAX;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		Vector<uint8_t> compressed;
+		Vector<uint8_t> data;
+		uint32_t size = 0;
+		int result = 0;
+	};
+
+	mutable BlockSlot block_slots[READ_AHEAD_BLOCKS + 1];
+	bool read_ahead = false;
+	mutable const uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -61,12 +83,20 @@ class FileAccessCompressed : public FileAccess {
 
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
-	Ref<FileAccess> f;
-
+	mutable Ref<FileAccess> f;
+
+	static void _decompress_block(void *p_slot);
+	static void _compress_block(void *p_userdata, uint32_t p_index);
+	uint32_t _get_block_size(uint32_t p_block) const;
+	bool _read_compressed_block(BlockSlot &r_slot, uint32_t p_block) const;
+	void _wait_for_slot(BlockSlot &r_slot) const;
+	BlockSlot *_get_free_slot(uint32_t p_window_begin) const;
+	bool _load_block(uint32_t p_block, bool p_read_ahead) const;
+	bool _next_block() const;
 	void _close();
 
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 65536);
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
@@ -90,6 +120,7 @@ public:
 
 	virtual void flush() override;
 	virtual void store_8(uint8_t p_dest) override; ///< store a byte
+	virtual void store_buffer(const uint8_t *p_src, uint64_t p_length) override; ///< store an array of bytes
 
 	virtual bool file_exists(const String &p_name) override; ///< return true if a file exists
 
@@ -31,6 +31,7 @@
 #include "file_access_pack.h"
 
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/version.h"
@@ -122,6 +123,9 @@ PackedData::~PackedData() {
 		memdelete(sources[i]);
 	}
 	_free_packed_dirs(root);
+	if (singleton == this) {
+		singleton = nullptr;
+	}
 }
 
 //////////////////////////////////////////////////////////////////
@@ -132,6 +136,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		return false;
 	}
 
+	Ref<FileAccess> pack_file = f; // f is replaced when the directory is encrypted.
 	bool pck_header_found = false;
 
 	// Search for the header at the start offset - standalone PCK file.
@@ -250,11 +255,31 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
 	}
 
+	if (PackedData::get_singleton()->is_memory_mapping_enabled()) {
+		MappedPack mapped;
+		mapped.data = pack_file->map_memory();
+		if (mapped.data) {
+			mapped.file = pack_file;
+			mapped_packs_lock.write_lock();
+			mapped_packs[p_path] = mapped;
+			mapped_packs_lock.write_unlock();
+		}
+	}
+
 	return true;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
-	return memnew(FileAccessPack(p_path, *p_file));
+	const uint8_t *mapped_data = nullptr;
+	if (!p_file->encrypted) {
+		mapped_packs_lock.read_lock();
+		const MappedPack *mapped = mapped_packs.getptr(p_file->pack);
+		if (mapped) {
+			mapped_data = mapped->data;
+		}
+		mapped_packs_lock.read_unlock();
+	}
+	return memnew(FileAccessPack(p_path, *p_file, mapped_data));
 }
 
 //////////////////////////////////////////////////////////////////
@@ -265,7 +290,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -273,7 +300,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -281,7 +308,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!data) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -302,18 +331,48 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (data) {
+		return data[pos++];
+	}
 	pos++;
 	return f->get_8();
 }
 
+uint16_t FileAccessPack::get_16() const {
+	if (!data || pos + 2 > pf.size) {
+		return FileAccess::get_16();
+	}
+	uint16_t value = decode_uint16(data + pos);
+	pos += 2;
+	return big_endian ? BSWAP16(value) : value;
+}
+
+uint32_t FileAccessPack::get_32() const {
+	if (!data || pos + 4 > pf.size) {
+		return FileAccess::get_32();
+	}
+	uint32_t value = decode_uint32(data + pos);
+	pos += 4;
+	return big_endian ? BSWAP32(value) : value;
+}
+
+uint64_t FileAccessPack::get_64() const {
+	if (!data || pos + 8 > pf.size) {
+		return FileAccess::get_64();
+	}
+	uint64_t value = decode_uint64(data + pos);
+	pos += 8;
+	return big_endian ? BSWAP64(value) : value;
+}
+
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -326,21 +385,28 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	uint64_t read_pos = pos;
 	pos += p_length;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (data) {
+		memcpy(p_dst, data + read_pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -368,11 +434,22 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	data = nullptr;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_mapped_pack) :
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+	off = pf.offset;
+
+	if (p_mapped_pack) {
+		// The pack stays mapped as long as its source exists, read from it without any syscall.
+		data = p_mapped_pack + pf.offset;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
@@ -394,8 +471,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
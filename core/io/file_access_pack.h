@@ -33,6 +33,7 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/rw_lock.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -104,6 +105,7 @@ private:
 
 	static PackedData *singleton;
 	bool disabled = false;
+	bool memory_mapping = sizeof(void *) == 8; // Packs are mapped whole, which needs a large address space.
 
 	void _free_packed_dirs(PackedDir *p_dir);
 
@@ -114,6 +116,11 @@ public:
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	// When enabled, packs added afterwards are memory mapped if the platform supports it,
+	// and their unencrypted files are read straight from the mapping.
+	void set_memory_mapping_enabled(bool p_enabled) { memory_mapping = p_enabled; }
+	_FORCE_INLINE_ bool is_memory_mapping_enabled() const { return memory_mapping; }
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
@@ -135,6 +142,14 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	struct MappedPack {
+		Ref<FileAccess> file; // Keeps the mapping alive.
+		const uint8_t *data = nullptr;
+	};
+
+	RWLock mapped_packs_lock;
+	HashMap<String, MappedPack> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -146,6 +161,7 @@ class FileAccessPack : public FileAccess {
 	mutable uint64_t pos;
 	mutable bool eof;
 	uint64_t off;
+	const uint8_t *data = nullptr; // Contents of the file inside a memory mapped pack, read directly instead of through f.
 
 	Ref<FileAccess> f;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
@@ -164,9 +180,14 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint8_t get_8() const override;
+	virtual uint16_t get_16() const override;
+	virtual uint32_t get_32() const override;
+	virtual uint64_t get_64() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
 
+	virtual const uint8_t *map_memory() override { return data; }
+
 	virtual void set_big_endian(bool p_big_endian) override;
 
 	virtual Error get_error() const override;
@@ -180,7 +201,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_mapped_pack = nullptr);
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
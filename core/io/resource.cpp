@@ -32,6 +32,7 @@
 
 #include "core/core_string_names.h"
 #include "core/io/file_access.h"
+#include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
 #include "core/object/script_language.h"
@@ -361,6 +362,68 @@ uint32_t Resource::hash_edited_version() const {
 
 #endif
 
+uint32_t Resource::hash_content() const {
+	uint32_t hash = get_class_name().hash();
+
+	List<PropertyInfo> plist;
+	get_property_list(&plist);
+
+	for (const PropertyInfo &E : plist) {
+		if (E.usage & PROPERTY_USAGE_STORAGE) {
+			// Sub-resources hash by instance, they are expected to be shared already.
+			hash = hash_murmur3_one_32(E.name.hash(), hash);
+			hash = hash_murmur3_one_32(get(E.name).hash(), hash);
+		}
+	}
+
+	return hash_fmix32(hash);
+}
+
+bool Resource::is_content_equal(const Ref<Resource> &p_resource) const {
+	ERR_FAIL_COND_V(p_resource.is_null(), false);
+	if (p_resource->get_class_name() != get_class_name()) {
+		return false;
+	}
+
+	List<PropertyInfo> plist;
+	get_property_list(&plist);
+	List<PropertyInfo> other_plist;
+	p_resource->get_property_list(&other_plist);
+	if (plist.size() != other_plist.size()) {
+		return false;
+	}
+
+	for (const PropertyInfo &E : plist) {
+		if (E.usage & PROPERTY_USAGE_STORAGE) {
+			bool valid = false;
+			Variant other = p_resource->get(E.name, &valid);
+			if (!valid || !get(E.name).hash_compare(other)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+uint64_t Resource::get_content_size() const {
+	uint64_t size = 0;
+
+	List<PropertyInfo> plist;
+	get_property_list(&plist);
+
+	for (const PropertyInfo &E : plist) {
+		if (E.usage & PROPERTY_USAGE_STORAGE) {
+			int len = 0;
+			if (encode_variant(get(E.name), nullptr, len, false) == OK) {
+				size += len;
+			}
+		}
+	}
+
+	return size;
+}
+
 void Resource::set_local_to_scene(bool p_enable) {
 	local_to_scene = p_enable;
 }
@@ -464,6 +527,17 @@ Resource::Resource() :
 		remapped_list(this) {}
 
 Resource::~Resource() {
+	if (content_shared) {
+		ResourceCache::lock.lock();
+		LocalVector<Resource *> *bucket = ResourceCache::shared_resources.getptr(content_hash);
+		if (bucket) {
+			bucket->erase(this);
+			if (bucket->is_empty()) {
+				ResourceCache::shared_resources.erase(content_hash);
+			}
+		}
+		ResourceCache::lock.unlock();
+	}
 	if (!path_cache.is_empty()) {
 		ResourceCache::lock.lock();
 		ResourceCache::resources.erase(path_cache);
@@ -479,6 +553,10 @@ HashMap<String, Resource *> ResourceCache::resources;
 HashMap<String, HashMap<String, String>> ResourceCache::resource_path_cache;
 #endif
 
+HashMap<uint32_t, LocalVector<Resource *>> ResourceCache::shared_resources;
+uint64_t ResourceCache::shared_bytes_saved = 0;
+uint32_t ResourceCache::shared_hit_count = 0;
+
 Mutex ResourceCache::lock;
 #ifdef TOOLS_ENABLED
 RWLock ResourceCache::path_cache_lock;
@@ -495,6 +573,7 @@ void ResourceCache::clear() {
 	}
 
 	resources.clear();
+	shared_resources.clear();
 }
 
 bool ResourceCache::has(const String &p_path) {
@@ -572,3 +651,73 @@ int ResourceCache::get_cached_resource_count() {
 
 	return rc;
 }
+
+Ref<Resource> ResourceCache::get_shared(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND_V(p_resource.is_null(), p_resource);
+	if (p_resource->content_shared) {
+		return p_resource;
+	}
+
+	uint32_t hash = p_resource->hash_content();
+
+	// Take references under the lock, but compare outside of it, as getting properties may run arbitrary code.
+	LocalVector<Ref<Resource>> candidates;
+	lock.lock();
+	LocalVector<Resource *> *bucket = shared_resources.getptr(hash);
+	if (bucket) {
+		for (Resource *E : *bucket) {
+			Ref<Resource> ref = Ref<Resource>(E);
+			if (ref.is_valid()) { // May be in the process of being deleted otherwise.
+				candidates.push_back(ref);
+			}
+		}
+	}
+	lock.unlock();
+
+	for (const Ref<Resource> &E : candidates) {
+		if (E->is_content_equal(p_resource)) {
+			uint64_t size = p_resource->get_content_size();
+			lock.lock();
+			shared_hit_count++;
+			shared_bytes_saved += size;
+			lock.unlock();
+			return E;
+		}
+	}
+
+	Ref<Resource> res = p_resource;
+	lock.lock();
+	res->content_shared = true;
+	res->content_hash = hash;
+	shared_resources[hash].push_back(res.operator->());
+	lock.unlock();
+
+	return res;
+}
+
+int ResourceCache::get_shared_resource_count() {
+	lock.lock();
+	int rc = 0;
+	for (const KeyValue<uint32_t, LocalVector<Resource *>> &E : shared_resources) {
+		rc += E.value.size();
+	}
+	lock.unlock();
+
+	return rc;
+}
+
+uint32_t ResourceCache::get_shared_hit_count() {
+	lock.lock();
+	uint32_t count = shared_hit_count;
+	lock.unlock();
+
+	return count;
+}
+
+uint64_t ResourceCache::get_shared_bytes_saved() {
+	lock.lock();
+	uint64_t saved = shared_bytes_saved;
+	lock.unlock();
+
+	return saved;
+}
@@ -34,6 +34,7 @@
 #include "core/io/resource_uid.h"
 #include "core/object/class_db.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 
@@ -75,6 +76,9 @@ private:
 
 	SelfList<Resource> remapped_list;
 
+	bool content_shared = false;
+	uint32_t content_hash = 0;
+
 protected:
 	void emit_changed();
 
@@ -137,6 +141,10 @@ public:
 
 	void set_as_translation_remapped(bool p_remapped);
 
+	uint32_t hash_content() const;
+	bool is_content_equal(const Ref<Resource> &p_resource) const;
+	uint64_t get_content_size() const;
+
 	virtual RID get_rid() const; // some resources may offer conversion to RID
 
 #ifdef TOOLS_ENABLED
@@ -158,6 +166,9 @@ class ResourceCache {
 	static HashMap<String, HashMap<String, String>> resource_path_cache; // Each tscn has a set of resource paths and IDs.
 	static RWLock path_cache_lock;
 #endif // TOOLS_ENABLED
+	static HashMap<uint32_t, LocalVector<Resource *>> shared_resources; // Keyed by content hash.
+	static uint64_t shared_bytes_saved;
+	static uint32_t shared_hit_count;
 	friend void unregister_core_types();
 	static void clear();
 	friend void register_core_types();
@@ -167,6 +178,11 @@ public:
 	static Ref<Resource> get_ref(const String &p_path);
 	static void get_cached_resources(List<Ref<Resource>> *p_resources);
 	static int get_cached_resource_count();
+
+	static Ref<Resource> get_shared(const Ref<Resource> &p_resource);
+	static int get_shared_resource_count();
+	static uint32_t get_shared_hit_count();
+	static uint64_t get_shared_bytes_saved();
 };
 
 #endif // RESOURCE_H
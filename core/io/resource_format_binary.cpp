@@ -31,6 +31,7 @@
 #include "resource_format_binary.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/image.h"
@@ -92,9 +93,16 @@ enum {
 	// Version 3: changed nodepath encoding.
 	// Version 4: new string ID for ext/subresources, breaks forward compat.
 	// Version 5: Ability to store script class in the header.
-	FORMAT_VERSION = 5,
+	// Version 6: numeric packed arrays stored as aligned little-endian blobs, optionally compressed per block.
+	FORMAT_VERSION = 6,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_PACKED_ARRAY_BLOBS = 6,
+	PACKED_ARRAY_BLOB_RAW = 0,
+	PACKED_ARRAY_BLOB_ZSTD_BLOCKS = 1,
+	PACKED_ARRAY_BLOB_ALIGNMENT = 16, // Relative to the start of the file, so blobs can be used in place from a memory mapped file.
+	PACKED_ARRAY_BLOB_BLOCK_SIZE = 256 * 1024,
+	PACKED_ARRAY_BLOB_MIN_COMPRESS_SIZE = 4096, // Smaller blobs are always stored raw.
 };
 
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
@@ -106,7 +114,90 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
-static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
+Error ResourceLoaderBinary::_read_packed_array_blob(uint8_t *p_dst, uint64_t p_size) {
+	if (ver_format < FORMAT_VERSION_PACKED_ARRAY_BLOBS) {
+		f->get_buffer(p_dst, p_size);
+		return OK;
+	}
+
+	uint32_t encoding = f->get_32();
+	switch (encoding) {
+		case PACKED_ARRAY_BLOB_RAW: {
+			uint32_t padding = f->get_32();
+			ERR_FAIL_COND_V(padding >= PACKED_ARRAY_BLOB_ALIGNMENT, ERR_FILE_CORRUPT);
+			f->seek(f->get_position() + padding);
+			ERR_FAIL_COND_V(f->get_buffer(p_dst, p_size) != p_size, ERR_FILE_CORRUPT);
+		} break;
+		case PACKED_ARRAY_BLOB_ZSTD_BLOCKS: {
+			uint32_t block_size = f->get_32();
+			ERR_FAIL_COND_V(block_size == 0, ERR_FILE_CORRUPT);
+			// Decompress straight from the file contents when they are mapped in memory.
+			const uint8_t *mapped = f->map_memory();
+			LocalVector<uint8_t> block_buffer;
+
+			for (uint64_t ofs = 0; ofs < p_size; ofs += block_size) {
+				uint32_t uncompressed_size = MIN(uint64_t(block_size), p_size - ofs);
+				uint32_t stored_size = f->get_32();
+				if (stored_size == uncompressed_size) {
+					// Didn't compress well, stored raw.
+					ERR_FAIL_COND_V(f->get_buffer(p_dst + ofs, stored_size) != stored_size, ERR_FILE_CORRUPT);
+					continue;
+				}
+
+				const uint8_t *src;
+				uint64_t position = f->get_position();
+				if (mapped) {
+					ERR_FAIL_COND_V(position + stored_size > f->get_length(), ERR_FILE_CORRUPT);
+					src = mapped + position;
+					f->seek(position + stored_size);
+				} else {
+					block_buffer.resize(stored_size);
+					ERR_FAIL_COND_V(f->get_buffer(block_buffer.ptr(), stored_size) != stored_size, ERR_FILE_CORRUPT);
+					src = block_buffer.ptr();
+				}
+				int decompressed = Compression::decompress(p_dst + ofs, uncompressed_size, src, stored_size, Compression::MODE_ZSTD);
+				ERR_FAIL_COND_V(decompressed != int(uncompressed_size), ERR_FILE_CORRUPT);
+			}
+		} break;
+		default: {
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Unknown packed array encoding: " + itos(encoding) + ".");
+		}
+	}
+	return OK;
+}
+
+Error ResourceLoaderBinary::_read_reals(real_t *dst, size_t count) {
+	if (ver_format >= FORMAT_VERSION_PACKED_ARRAY_BLOBS) {
+		if (f->real_is_double == (sizeof(real_t) == 8)) {
+			const Error err = _read_packed_array_blob((uint8_t *)dst, count * sizeof(real_t));
+			ERR_FAIL_COND_V(err != OK, err);
+#ifdef BIG_ENDIAN_ENABLED
+			for (size_t i = 0; i < count; i++) {
+				if constexpr (sizeof(real_t) == 8) {
+					((uint64_t *)dst)[i] = BSWAP64(((uint64_t *)dst)[i]);
+				} else {
+					((uint32_t *)dst)[i] = BSWAP32(((uint32_t *)dst)[i]);
+				}
+			}
+#endif
+		} else {
+			// Saved with a different real_t precision, decode to a temporary buffer and convert.
+			const size_t file_real_size = f->real_is_double ? sizeof(double) : sizeof(float);
+			LocalVector<uint8_t> buffer;
+			buffer.resize(count * file_real_size);
+			const Error err = _read_packed_array_blob(buffer.ptr(), buffer.size());
+			ERR_FAIL_COND_V(err != OK, err);
+			for (size_t i = 0; i < count; i++) {
+				if (f->real_is_double) {
+					dst[i] = decode_double(&buffer[i * file_real_size]);
+				} else {
+					dst[i] = decode_float(&buffer[i * file_real_size]);
+				}
+			}
+		}
+		return OK;
+	}
+
 	if (f->real_is_double) {
 		if constexpr (sizeof(real_t) == 8) {
 			// Ideal case with double-precision
@@ -445,23 +536,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
-						if (external_resources[erindex].cache.is_null()) {
-							//cache not here yet, wait for it?
-							if (use_sub_threads) {
-								Error err;
-								external_resources.write[erindex].cache = ResourceLoader::load_threaded_get(external_resources[erindex].path, &err);
-
-								if (err != OK || external_resources[erindex].cache.is_null()) {
-									if (!ResourceLoader::get_abort_on_missing_resources()) {
-										ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
-									} else {
-										error = ERR_FILE_MISSING_DEPENDENCIES;
-										ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[erindex].path + ".");
-									}
-								}
-							}
-						}
-
+						// With sub-threads, dependencies were already joined in load().
 						r_v = external_resources[erindex].cache;
 					}
 
@@ -513,8 +588,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<uint8_t> array;
 			array.resize(len);
 			uint8_t *w = array.ptrw();
-			f->get_buffer(w, len);
-			_advance_padding(len);
+			if (ver_format < FORMAT_VERSION_PACKED_ARRAY_BLOBS) {
+				f->get_buffer(w, len);
+				_advance_padding(len);
+			} else {
+				const Error err = _read_packed_array_blob(w, len);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
 
 			r_v = array;
 
@@ -525,7 +605,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<int32_t> array;
 			array.resize(len);
 			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
+			const Error err = _read_packed_array_blob((uint8_t *)w, len * sizeof(int32_t));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -544,7 +625,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<int64_t> array;
 			array.resize(len);
 			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
+			const Error err = _read_packed_array_blob((uint8_t *)w, len * sizeof(int64_t));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -563,7 +645,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<float> array;
 			array.resize(len);
 			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
+			const Error err = _read_packed_array_blob((uint8_t *)w, len * sizeof(float));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -582,7 +665,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<double> array;
 			array.resize(len);
 			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
+			const Error err = _read_packed_array_blob((uint8_t *)w, len * sizeof(double));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -614,7 +698,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			Vector2 *w = array.ptrw();
 			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 2);
+			const Error err = _read_reals(reinterpret_cast<real_t *>(w), len * 2);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
@@ -627,7 +711,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			Vector3 *w = array.ptrw();
 			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 3);
+			const Error err = _read_reals(reinterpret_cast<real_t *>(w), len * 3);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
@@ -641,7 +725,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
-			f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
+			const Error err = _read_packed_array_blob((uint8_t *)w, len * sizeof(float) * 4);
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -710,6 +795,23 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	if (use_sub_threads) {
+		// All dependencies were requested above so they load in parallel, join them before any subresource is built.
+		for (int i = 0; i < external_resources.size(); i++) {
+			Error err;
+			external_resources.write[i].cache = ResourceLoader::load_threaded_get(external_resources[i].path, &err);
+
+			if (err != OK || external_resources[i].cache.is_null()) {
+				if (!ResourceLoader::get_abort_on_missing_resources()) {
+					ResourceLoader::notify_dependency_error(local_path, external_resources[i].path, external_resources[i].type);
+				} else {
+					error = ERR_FILE_MISSING_DEPENDENCIES;
+					ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[i].path + ".");
+				}
+			}
+		}
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
@@ -861,6 +963,11 @@ Error ResourceLoaderBinary::load() {
 		res->set_edited(false);
 #endif
 
+		if (!main && !missing_resource && cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceLoader::is_sharing_subresources()) {
+			res = ResourceLoader::get_shared_subresource(res);
+			internal_index_cache[path] = res;
+		}
+
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
 		}
@@ -1524,11 +1631,46 @@ ResourceUID::ID ResourceFormatLoaderBinary::get_resource_uid(const String &p_pat
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 
-void ResourceFormatSaverBinaryInstance::_pad_buffer(Ref<FileAccess> f, int p_bytes) {
-	int extra = 4 - (p_bytes % 4);
-	if (extra < 4) {
-		for (int i = 0; i < extra; i++) {
-			f->store_8(0); //pad to 32
+void ResourceFormatSaverBinaryInstance::_store_packed_array_blob(Ref<FileAccess> f, const uint8_t *p_data, uint64_t p_size, uint32_t p_word_size) {
+#ifdef BIG_ENDIAN_ENABLED
+	// Blobs are always little-endian.
+	LocalVector<uint8_t> swapped;
+	swapped.resize(p_size);
+	for (uint64_t i = 0; i < p_size; i += p_word_size) {
+		for (uint32_t j = 0; j < p_word_size; j++) {
+			swapped[i + j] = p_data[i + p_word_size - 1 - j];
+		}
+	}
+	p_data = swapped.ptr();
+#endif
+
+	if (!compress_packed_arrays || p_size < PACKED_ARRAY_BLOB_MIN_COMPRESS_SIZE) {
+		f->store_32(PACKED_ARRAY_BLOB_RAW);
+		uint64_t data_position = f->get_position() + 4;
+		uint32_t padding = (PACKED_ARRAY_BLOB_ALIGNMENT - (data_position % PACKED_ARRAY_BLOB_ALIGNMENT)) % PACKED_ARRAY_BLOB_ALIGNMENT;
+		f->store_32(padding);
+		for (uint32_t i = 0; i < padding; i++) {
+			f->store_8(0);
+		}
+		f->store_buffer(p_data, p_size);
+		return;
+	}
+
+	f->store_32(PACKED_ARRAY_BLOB_ZSTD_BLOCKS);
+	f->store_32(PACKED_ARRAY_BLOB_BLOCK_SIZE);
+
+	LocalVector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(PACKED_ARRAY_BLOB_BLOCK_SIZE, Compression::MODE_ZSTD));
+	for (uint64_t ofs = 0; ofs < p_size; ofs += PACKED_ARRAY_BLOB_BLOCK_SIZE) {
+		uint32_t block_size = MIN(uint64_t(PACKED_ARRAY_BLOB_BLOCK_SIZE), p_size - ofs);
+		int compressed_size = Compression::compress(compressed.ptr(), p_data + ofs, block_size, Compression::MODE_ZSTD);
+		if (compressed_size <= 0 || uint32_t(compressed_size) >= block_size) {
+			// Not worth it, store the block raw, which the loader recognizes by its size.
+			f->store_32(block_size);
+			f->store_buffer(p_data + ofs, block_size);
+		} else {
+			f->store_32(compressed_size);
+			f->store_buffer(compressed.ptr(), compressed_size);
 		}
 	}
 }
@@ -1840,9 +1982,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<uint8_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const uint8_t *r = arr.ptr();
-			f->store_buffer(r, len);
-			_pad_buffer(f, len);
+			_store_packed_array_blob(f, arr.ptr(), len, 1);
 
 		} break;
 		case Variant::PACKED_INT32_ARRAY: {
@@ -1850,10 +1990,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int32_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const int32_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_32(r[i]);
-			}
+			_store_packed_array_blob(f, (const uint8_t *)arr.ptr(), len * sizeof(int32_t), sizeof(int32_t));
 
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
@@ -1861,10 +1998,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int64_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const int64_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_64(r[i]);
-			}
+			_store_packed_array_blob(f, (const uint8_t *)arr.ptr(), len * sizeof(int64_t), sizeof(int64_t));
 
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
@@ -1872,10 +2006,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<float> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const float *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i]);
-			}
+			_store_packed_array_blob(f, (const uint8_t *)arr.ptr(), len * sizeof(float), sizeof(float));
 
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
@@ -1883,10 +2014,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<double> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const double *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_double(r[i]);
-			}
+			_store_packed_array_blob(f, (const uint8_t *)arr.ptr(), len * sizeof(double), sizeof(double));
 
 		} break;
 		case Variant::PACKED_STRING_ARRAY: {
@@ -1905,12 +2033,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector3> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Vector3 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-			}
+			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
+			_store_packed_array_blob(f, (const uint8_t *)arr.ptr(), len * sizeof(Vector3), sizeof(real_t));
 
 		} break;
 		case Variant::PACKED_VECTOR2_ARRAY: {
@@ -1918,11 +2042,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector2> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Vector2 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-			}
+			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
+			_store_packed_array_blob(f, (const uint8_t *)arr.ptr(), len * sizeof(Vector2), sizeof(real_t));
 
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
@@ -1930,13 +2051,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Color> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Color *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i].r);
-				f->store_float(r[i].g);
-				f->store_float(r[i].b);
-				f->store_float(r[i].a);
-			}
+			static_assert(sizeof(Color) == 4 * sizeof(float));
+			_store_packed_array_blob(f, (const uint8_t *)arr.ptr(), len * sizeof(Color), sizeof(float));
 
 		} break;
 		default: {
@@ -2082,6 +2198,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 	bundle_resources = p_flags & ResourceSaver::FLAG_BUNDLE_RESOURCES;
 	big_endian = p_flags & ResourceSaver::FLAG_SAVE_BIG_ENDIAN;
 	takeover_paths = p_flags & ResourceSaver::FLAG_REPLACE_SUBRESOURCE_PATHS;
+	compress_packed_arrays = p_flags & ResourceSaver::FLAG_COMPRESS_PACKED_ARRAYS;
 
 	if (!p_path.begins_with("res://")) {
 		takeover_paths = false;
@@ -231,14 +231,30 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 }
 
 void ResourceLoader::_thread_load_function(void *p_userdata) {
-	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
-	load_task.loader_id = Thread::get_caller_id();
+	// The pool task only knows the path, as a thread waiting for the load may have run it
+	// and released the task already.
+	String *local_path = (String *)p_userdata;
 
-	if (load_task.cond_var) {
-		//this is an actual thread, so wait for Ok from semaphore
-		thread_load_semaphore->wait(); //wait until its ok to start loading
+	thread_load_mutex->lock();
+	ThreadLoadTask *load_task = thread_load_tasks.getptr(*local_path);
+	memdelete(local_path);
+	if (!load_task || load_task->started) {
+		thread_load_mutex->unlock();
+		return;
 	}
+	load_task->started = true;
+	thread_load_mutex->unlock();
+
+	_run_load_task(*load_task);
+}
+
+void ResourceLoader::_run_load_task(ThreadLoadTask &load_task) {
+	load_task.loader_id = Thread::get_caller_id();
+
+	print_lt("START: " + load_task.local_path);
+	load_paths_stack.push_back(load_task.local_path);
 	load_task.resource = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
+	load_paths_stack.resize(load_paths_stack.size() - 1);
 
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
 
@@ -248,17 +264,8 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	} else {
 		load_task.status = THREAD_LOAD_LOADED;
 	}
+	print_lt("END: " + load_task.local_path);
 	if (load_task.cond_var) {
-		if (load_task.start_next && thread_waiting_count > 0) {
-			thread_waiting_count--;
-			//thread loading count remains constant, this ends but another one begins
-			thread_load_semaphore->post();
-		} else {
-			thread_loading_count--; //no threads waiting, just reduce loading count
-		}
-
-		print_lt("END: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
-
 		load_task.cond_var->notify_all();
 		memdelete(load_task.cond_var);
 		load_task.cond_var = nullptr;
@@ -346,11 +353,6 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 
 		{ //must check if resource is already loaded before attempting to load it in a thread
 
-			if (load_task.loader_id == Thread::get_caller_id()) {
-				thread_load_mutex->unlock();
-				ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Attempted to load a resource already being loaded from this thread, cyclic reference?");
-			}
-
 			Ref<Resource> existing = ResourceCache::get_ref(local_path);
 
 			if (existing.is_valid()) {
@@ -371,20 +373,20 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	ThreadLoadTask &load_task = thread_load_tasks[local_path];
 
 	if (load_task.resource.is_null()) { //needs to be loaded in thread
+		print_lt("REQUEST: " + local_path);
 
-		load_task.cond_var = memnew(ConditionVariable);
-		if (thread_loading_count < thread_load_max) {
-			thread_loading_count++;
-			thread_load_semaphore->post(); //we have free threads, so allow one
-		} else {
-			thread_waiting_count++;
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		if (pool->get_thread_count() == 0) {
+			// No worker threads available (yet), load in this thread instead.
+			load_task.started = true;
+			thread_load_mutex->unlock();
+			_run_load_task(load_task);
+			return OK;
 		}
 
-		print_lt("REQUEST: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
-
-		load_task.thread = memnew(Thread);
-		load_task.thread->start(_thread_load_function, &thread_load_tasks[local_path]);
-		load_task.loader_id = load_task.thread->get_id();
+		// Dependencies requested by another load are scheduled at high priority, so all the ones of
+		// a resource fan out across the pool at once instead of each taking a low priority slot.
+		load_task.task_id = pool->add_native_task(&ResourceLoader::_thread_load_function, memnew(String(local_path)), !p_source_resource.is_empty(), "Load " + local_path);
 	}
 
 	thread_load_mutex->unlock();
@@ -434,10 +436,67 @@ ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const
 	return status;
 }
 
+bool ResourceLoader::_is_load_cyclic(const String &p_local_path) {
+	// Waiting for a load is a cycle if it's suspended lower on this thread, or if the thread running it
+	// is itself blocked, maybe through other threads, on one of those.
+	String path = p_local_path;
+	for (uint32_t i = 0; i <= thread_load_tasks.size() && !path.is_empty(); i++) {
+		if (load_paths_stack.find(path) != -1) {
+			return true;
+		}
+		const ThreadLoadTask *load_task = thread_load_tasks.getptr(path);
+		if (!load_task) {
+			return false;
+		}
+		path = load_task->waiting_for;
+	}
+	return false;
+}
+
+void ResourceLoader::_free_finished_pool_tasks() {
+	// Pool tasks are only waited for once they completed, so this never picks up other tasks
+	// while a load is suspended on this thread.
+	LocalVector<WorkerThreadPool::TaskID> finished;
+	thread_load_mutex->lock();
+	uint32_t i = 0;
+	while (i < pool_tasks_to_free.size()) {
+		if (WorkerThreadPool::get_singleton()->is_task_completed(pool_tasks_to_free[i])) {
+			finished.push_back(pool_tasks_to_free[i]);
+			pool_tasks_to_free.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
+	thread_load_mutex->unlock();
+
+	for (const WorkerThreadPool::TaskID &task_id : finished) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+}
+
 Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 	String local_path = _validate_local_path(p_path);
 
+	_free_finished_pool_tasks();
+
+	thread_load_mutex->lock();
+	ThreadLoadTask *pending_task = thread_load_tasks.getptr(local_path);
+	if (pending_task && !pending_task->started) {
+		// Still queued on the pool, so run it here instead of waiting for it. Waiting through the pool would
+		// have this thread run unrelated tasks meanwhile, stacked on top of the loads already suspended on it,
+		// and those could need one of them.
+		pending_task->started = true;
+		thread_load_mutex->unlock();
+		_run_load_task(*pending_task);
+	} else {
+		thread_load_mutex->unlock();
+	}
+
 	MutexLock thread_load_lock(*thread_load_mutex);
+	return _load_threaded_get_locked(local_path, thread_load_lock, r_error);
+}
+
+Ref<Resource> ResourceLoader::_load_threaded_get_locked(const String &local_path, MutexLock<SafeBinaryMutex<BINARY_MUTEX_TAG>> &thread_load_lock, Error *r_error) {
 	if (!thread_load_tasks.has(local_path)) {
 		if (r_error) {
 			*r_error = ERR_INVALID_PARAMETER;
@@ -448,55 +507,34 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 	ThreadLoadTask &load_task = thread_load_tasks[local_path];
 
 	if (load_task.status == THREAD_LOAD_IN_PROGRESS) {
-		if (load_task.loader_id == Thread::get_caller_id()) {
-			// Load is in progress, but it's precisely this thread the one in charge.
-			// That means this is a cyclic load.
+		if (_is_load_cyclic(local_path)) {
+			// The load can't finish before this one, it's a cyclic load.
 			if (r_error) {
 				*r_error = ERR_BUSY;
 			}
 			return Ref<Resource>();
 		} else if (!load_task.cond_var) {
-			// Load is in progress, but a condition variable was never created for it.
-			// That happens when a load has been initiated with subthreads disabled,
-			// but now another load thread needs to interact with this one (either
-			// because of subthreads being used this time, or because it's simply a
-			// threaded load running on a different thread).
-			// Since we want to be notified when the load ends, we must create the
-			// condition variable now.
+			// Load is in progress on another thread, but a condition variable was never created for it.
+			// Since we want to be notified when the load ends, we must create the condition variable now.
 			load_task.cond_var = memnew(ConditionVariable);
 		}
 	}
 
 	//cond var still exists, meaning it's still loading, request poll
 	if (load_task.cond_var) {
-		{
-			// As we got a cond var, this means we are going to have to wait
-			// until the sub-resource is done loading
-			//
-			// As this thread will become 'blocked' we should "exchange" its
-			// active status with a waiting one, to ensure load continues.
-			//
-			// This ensures loading is never blocked and that is also within
-			// the maximum number of active threads.
-
-			if (thread_waiting_count > 0) {
-				thread_waiting_count--;
-				thread_loading_count++;
-				thread_load_semaphore->post();
-
-				load_task.start_next = false; //do not start next since we are doing it here
-			}
+		// The load runs on another thread, so wait until it notifies the end of the load. Every load it waits
+		// for is either running too or run by the thread waiting for it, so this doesn't stall the pool.
+		print_lt("GET: waiting for " + local_path);
 
-			thread_suspended_count++;
-
-			print_lt("GET: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+		for (const String &path : load_paths_stack) {
+			thread_load_tasks.getptr(path)->waiting_for = local_path;
 		}
-
 		do {
 			load_task.cond_var->wait(thread_load_lock);
 		} while (load_task.cond_var); // In case of spurious wakeup.
-
-		thread_suspended_count--;
+		for (const String &path : load_paths_stack) {
+			thread_load_tasks.getptr(path)->waiting_for = String();
+		}
 
 		if (!thread_load_tasks.has(local_path)) { //may have been erased during unlock and this was always an invalid call
 			if (r_error) {
@@ -514,9 +552,9 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 	load_task.requests--;
 
 	if (load_task.requests == 0) {
-		if (load_task.thread) { //thread may not have been used
-			load_task.thread->wait_to_finish();
-			memdelete(load_task.thread);
+		if (load_task.task_id != WorkerThreadPool::INVALID_TASK_ID) {
+			// The pool may not have run its task yet, if a waiting thread ran the load instead.
+			pool_tasks_to_free.push_back(load_task.task_id);
 		}
 		thread_load_tasks.erase(local_path);
 	}
@@ -575,9 +613,12 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 
 		thread_load_tasks[local_path] = load_task;
 
+		ThreadLoadTask &new_task = thread_load_tasks[local_path];
+		new_task.started = true;
+
 		thread_load_mutex->unlock();
 
-		_thread_load_function(&thread_load_tasks[local_path]);
+		_run_load_task(new_task);
 
 		return load_threaded_get(p_path, r_error);
 
@@ -956,32 +997,48 @@ void ResourceLoader::clear_translation_remaps() {
 }
 
 void ResourceLoader::clear_thread_load_tasks() {
-	thread_load_mutex->lock();
+	LocalVector<WorkerThreadPool::TaskID> tasks_to_await;
 
-	for (KeyValue<String, ResourceLoader::ThreadLoadTask> &E : thread_load_tasks) {
-		switch (E.value.status) {
-			case ResourceLoader::ThreadLoadStatus::THREAD_LOAD_LOADED: {
-				E.value.resource = Ref<Resource>();
-			} break;
-
-			case ResourceLoader::ThreadLoadStatus::THREAD_LOAD_IN_PROGRESS: {
-				if (E.value.thread != nullptr) {
-					E.value.thread->wait_to_finish();
-					memdelete(E.value.thread);
-					E.value.thread = nullptr;
-				}
-				E.value.resource = Ref<Resource>();
-			} break;
+	{
+		MutexLock thread_load_lock(*thread_load_mutex);
+
+		// Loads still in progress access their task data, so it can only be cleared once they finish.
+		// They run either on the pool or on a thread waiting for them, so they finish without help.
+		LocalVector<String> paths_in_progress;
+		for (const KeyValue<String, ResourceLoader::ThreadLoadTask> &E : thread_load_tasks) {
+			if (E.value.status == ResourceLoader::ThreadLoadStatus::THREAD_LOAD_IN_PROGRESS && E.value.started) {
+				paths_in_progress.push_back(E.key);
+			}
+		}
+		for (const String &path : paths_in_progress) {
+			ThreadLoadTask *load_task = thread_load_tasks.getptr(path);
+			if (!load_task || load_task->status != ResourceLoader::ThreadLoadStatus::THREAD_LOAD_IN_PROGRESS) {
+				continue;
+			}
+			if (!load_task->cond_var) {
+				load_task->cond_var = memnew(ConditionVariable);
+			}
+			do {
+				load_task->cond_var->wait(thread_load_lock);
+			} while (thread_load_tasks.has(path) && load_task->cond_var);
+		}
 
-			case ResourceLoader::ThreadLoadStatus::THREAD_LOAD_FAILED:
-			default: {
-				// do nothing
+		for (KeyValue<String, ResourceLoader::ThreadLoadTask> &E : thread_load_tasks) {
+			E.value.resource = Ref<Resource>();
+			if (E.value.task_id != WorkerThreadPool::INVALID_TASK_ID) {
+				pool_tasks_to_free.push_back(E.value.task_id);
 			}
 		}
+		thread_load_tasks.clear();
+
+		tasks_to_await = pool_tasks_to_free;
+		pool_tasks_to_free.clear();
 	}
-	thread_load_tasks.clear();
 
-	thread_load_mutex->unlock();
+	// With the loads gone, the pool tasks that didn't start yet do nothing once they run.
+	for (const WorkerThreadPool::TaskID &task_id : tasks_to_await) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
 }
 
 void ResourceLoader::load_path_remaps() {
@@ -1047,6 +1104,14 @@ void ResourceLoader::set_create_missing_resources_if_class_unavailable(bool p_en
 	create_missing_resources_if_class_unavailable = p_enable;
 }
 
+Ref<Resource> ResourceLoader::get_shared_subresource(const Ref<Resource> &p_resource) {
+	if (!share_subresources || p_resource.is_null() || p_resource->is_local_to_scene() || !p_resource->get_script().is_null()) {
+		// Scripts and scene-local resources are expected to hold per-instance state.
+		return p_resource;
+	}
+	return ResourceCache::get_shared(p_resource);
+}
+
 void ResourceLoader::add_custom_loaders() {
 	// Custom loaders registration exploits global class names
 
@@ -1080,16 +1145,10 @@ void ResourceLoader::remove_custom_loaders() {
 
 void ResourceLoader::initialize() {
 	thread_load_mutex = memnew(SafeBinaryMutex<BINARY_MUTEX_TAG>);
-	thread_load_max = OS::get_singleton()->get_processor_count();
-	thread_loading_count = 0;
-	thread_waiting_count = 0;
-	thread_suspended_count = 0;
-	thread_load_semaphore = memnew(Semaphore);
 }
 
 void ResourceLoader::finalize() {
 	memdelete(thread_load_mutex);
-	memdelete(thread_load_semaphore);
 }
 
 ResourceLoadErrorNotify ResourceLoader::err_notify = nullptr;
@@ -1100,18 +1159,15 @@ void *ResourceLoader::dep_err_notify_ud = nullptr;
 
 bool ResourceLoader::create_missing_resources_if_class_unavailable = false;
 bool ResourceLoader::abort_on_missing_resource = true;
+bool ResourceLoader::share_subresources = false;
 bool ResourceLoader::timestamp_on_load = false;
 
 template <>
 thread_local uint32_t SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG>::count = 0;
 SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG> *ResourceLoader::thread_load_mutex = nullptr;
 HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
-Semaphore *ResourceLoader::thread_load_semaphore = nullptr;
-
-int ResourceLoader::thread_loading_count = 0;
-int ResourceLoader::thread_waiting_count = 0;
-int ResourceLoader::thread_suspended_count = 0;
-int ResourceLoader::thread_load_max = 0;
+LocalVector<WorkerThreadPool::TaskID> ResourceLoader::pool_tasks_to_free;
+thread_local LocalVector<String> ResourceLoader::load_paths_stack;
 
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
@@ -34,7 +34,7 @@
 #include "core/io/resource.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/script_language.h"
-#include "core/os/semaphore.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 
 class ConditionVariable;
@@ -120,6 +120,7 @@ private:
 	static DependencyErrorNotify dep_err_notify;
 	static bool abort_on_missing_resource;
 	static bool create_missing_resources_if_class_unavailable;
+	static bool share_subresources;
 	static HashMap<String, Vector<String>> translation_remaps;
 	static HashMap<String, String> path_remaps;
 
@@ -138,8 +139,10 @@ private:
 	static Ref<ResourceFormatLoader> _find_custom_resource_format_loader(String path);
 
 	struct ThreadLoadTask {
-		Thread *thread = nullptr;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID; // Set if queued on the worker pool.
+		bool started = false; // Either the pool task or a thread waiting for the load runs it, whichever comes first.
 		Thread::ID loader_id = 0;
+		String waiting_for; // Load the thread running this one is blocked on, if any.
 		ConditionVariable *cond_var = nullptr;
 		String local_path;
 		String remapped_path;
@@ -151,19 +154,19 @@ private:
 		Ref<Resource> resource;
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
-		bool start_next = true;
 		int requests = 0;
 		HashSet<String> sub_tasks;
 	};
 
 	static void _thread_load_function(void *p_userdata);
+	static void _run_load_task(ThreadLoadTask &p_load_task);
+	static bool _is_load_cyclic(const String &p_local_path);
+	static void _free_finished_pool_tasks();
+	static Ref<Resource> _load_threaded_get_locked(const String &local_path, MutexLock<SafeBinaryMutex<BINARY_MUTEX_TAG>> &thread_load_lock, Error *r_error);
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> *thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
-	static Semaphore *thread_load_semaphore;
-	static int thread_waiting_count;
-	static int thread_loading_count;
-	static int thread_suspended_count;
-	static int thread_load_max;
+	static LocalVector<WorkerThreadPool::TaskID> pool_tasks_to_free; // Of loads no longer tracked, freed once the pool is done with them.
+	static thread_local LocalVector<String> load_paths_stack; // Loads running on this thread, innermost last.
 
 	static float _dependency_get_progress(const String &p_path);
 
@@ -237,6 +240,11 @@ public:
 	static void set_create_missing_resources_if_class_unavailable(bool p_enable);
 	_FORCE_INLINE_ static bool is_creating_missing_resources_if_class_unavailable_enabled() { return create_missing_resources_if_class_unavailable; }
 
+	// Built-in sub-resources with identical contents are loaded as a single shared instance, which must not be modified.
+	static void set_share_subresources(bool p_enable) { share_subresources = p_enable; }
+	_FORCE_INLINE_ static bool is_sharing_subresources() { return share_subresources; }
+	static Ref<Resource> get_shared_subresource(const Ref<Resource> &p_resource);
+
 	static void initialize();
 	static void finalize();
 };
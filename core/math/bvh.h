@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -71,6 +72,13 @@ public:
 		_thread_safe = p_enable;
 	}
 
+	// allow finding the pairs of the changed items on the WorkerThreadPool,
+	// when there are enough of them for it to be worthwhile
+	void params_set_threaded_pairing(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		_threaded_pairing = p_enable;
+	}
+
 	// these 2 are crucial for fine tuning, and can be applied manually
 	// see the variable declarations for more info.
 	void params_set_node_expansion(real_t p_value) {
@@ -435,7 +443,10 @@ private:
 			return;
 		}
 
-		BOUNDS bb;
+		if (_threaded_pairing && changed_items.size() >= THREADED_PAIRING_MIN_ITEMS) {
+			_check_for_collisions_threaded(p_full_check);
+			return;
+		}
 
 		typename BVHTREE_CLASS::CullParams params;
 
@@ -480,6 +491,97 @@ private:
 		_reset();
 	}
 
+	// Same result as above, in the same order. The tree is not modified while pairing,
+	// so the culls for all the changed items are done up front on the WorkerThreadPool,
+	// each chunk of items writing the candidates to its own list. The pair and unpair
+	// callbacks then run on this thread, item by item, exactly as in the serial version.
+	void _check_for_collisions_threaded(bool p_full_check) {
+		uint32_t num_chunks = (changed_items.size() + THREADED_PAIRING_CHUNK_SIZE - 1) / THREADED_PAIRING_CHUNK_SIZE;
+		if (_pairing_chunks.size() < num_chunks) {
+			_pairing_chunks.resize(num_chunks);
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_find_pairing_candidates, nullptr, num_chunks, -1, true, SNAME("BVHPairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t c = 0; c < num_chunks; c++) {
+			const PairingChunk &chunk = _pairing_chunks[c];
+			uint32_t first_item = c * THREADED_PAIRING_CHUNK_SIZE;
+			uint32_t candidate = 0;
+
+			for (uint32_t i = 0; i < chunk.item_ends.size(); i++) {
+				const BVHHandle &h = changed_items[first_item + i];
+
+				BVHABB_CLASS abb;
+				abb.from(tree._pairs[h.id()].expanded_aabb);
+				_find_leavers(h, abb, p_full_check);
+
+				for (; candidate < chunk.item_ends[i]; candidate++) {
+					BVHHandle h_collidee;
+					h_collidee.set_id(chunk.candidates[candidate]);
+					_collide(h, h_collidee);
+				}
+			}
+		}
+		_reset();
+	}
+
+	void _find_pairing_candidates(uint32_t p_chunk, void *p_userdata) {
+		PairingChunk &chunk = _pairing_chunks[p_chunk];
+		chunk.candidates.clear();
+		chunk.item_ends.clear();
+
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		uint32_t first_item = p_chunk * THREADED_PAIRING_CHUNK_SIZE;
+		uint32_t end_item = MIN(first_item + THREADED_PAIRING_CHUNK_SIZE, changed_items.size());
+
+		for (uint32_t n = first_item; n < end_item; n++) {
+			const BVHHandle &h = changed_items[n];
+			tree.item_fill_cullparams(h, params);
+			params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+			uint32_t first_hit = chunk.candidates.size();
+			tree.cull_aabb_hits(params, chunk.candidates);
+
+			// Drop the hits that _collide() would reject before looking at any pairs,
+			// so only the checks that depend on the pair state are left for the serial part.
+			uint32_t num_candidates = first_hit;
+			for (uint32_t hit = first_hit; hit < chunk.candidates.size(); hit++) {
+				uint32_t ref_id = chunk.candidates[hit];
+
+				// don't collide against ourself
+				if (ref_id == h.id()) {
+					continue;
+				}
+
+				BVHHandle ha = h;
+				BVHHandle hb;
+				hb.set_id(ref_id);
+				tree._handle_sort(ha, hb);
+
+				const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(ha);
+				const typename BVHTREE_CLASS::ItemExtra &exb = _get_extra(hb);
+
+				if (!USER_PAIR_TEST_FUNCTION::user_pair_check(exa.userdata, exb.userdata)) {
+					continue;
+				}
+				if ((exa.userdata == exb.userdata) && exa.userdata) {
+					continue;
+				}
+
+				chunk.candidates[num_candidates++] = ref_id;
+			}
+			chunk.candidates.resize(num_candidates);
+			chunk.item_ends.push_back(num_candidates);
+		}
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +875,21 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// for threaded pairing, the candidates found for each chunk of changed items,
+	// and the end of the candidates for each item within the chunk
+	struct PairingChunk {
+		LocalVector<uint32_t, uint32_t, true> candidates;
+		LocalVector<uint32_t, uint32_t, true> item_ends;
+	};
+
+	enum {
+		THREADED_PAIRING_CHUNK_SIZE = 64,
+		THREADED_PAIRING_MIN_ITEMS = 256,
+	};
+
+	LocalVector<PairingChunk> _pairing_chunks;
+	bool _threaded_pairing = false;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
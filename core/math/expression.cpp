@@ -35,6 +35,7 @@
 #include "core/object/class_db.h"
 #include "core/object/ref_counted.h"
 #include "core/os/os.h"
+#include "core/variant/variant_internal.h"
 #include "core/variant/variant_parser.h"
 
 Error Expression::_get_token(Token &r_token) {
@@ -1467,6 +1468,526 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 	return false;
 }
 
+void Expression::_clear_program() {
+	program.clear();
+	program_operands.clear();
+	program_constants.clear();
+	program_result = 0;
+	program_registers = 0;
+	program_inputs = 0;
+	program_max_operands = 0;
+}
+
+int Expression::_add_constant(const Variant &p_value) {
+	program_constants.push_back(p_value);
+	return ((program_constants.size() - 1) << ADDR_BITS) | ADDR_CONSTANT;
+}
+
+int Expression::_add_instruction(Instruction &p_instruction, const LocalVector<int> &p_operands) {
+	p_instruction.target = program_registers++;
+	p_instruction.operands = program_operands.size();
+	p_instruction.operand_count = p_operands.size();
+	for (const int &operand : p_operands) {
+		program_operands.push_back(operand);
+	}
+	program_max_operands = MAX(program_max_operands, (int)p_operands.size());
+	program.push_back(p_instruction);
+	return (p_instruction.target << ADDR_BITS) | ADDR_REGISTER;
+}
+
+bool Expression::_compile_operands(const Vector<ENode *> &p_nodes, LocalVector<int> &r_operands) {
+	bool all_constant = true;
+	for (int i = 0; i < p_nodes.size(); i++) {
+		int address = _compile_node(p_nodes[i]);
+		all_constant = all_constant && (address & ADDR_MASK) == ADDR_CONSTANT;
+		r_operands.push_back(address);
+	}
+	return all_constant;
+}
+
+int Expression::_compile_node(ENode *p_node) {
+	// Operands are compiled before the instruction that uses them, so the program
+	// evaluates in the same order as the tree walker and fails on the same error.
+	// Subtrees whose operands are all constant are folded when they can't have side effects;
+	// if folding fails, the instruction is kept so the error is reported on execution.
+#define CONSTANT_VALUE(m_address) program_constants[(m_address) >> ADDR_BITS]
+
+	switch (p_node->type) {
+		case Expression::ENode::TYPE_INPUT: {
+			const Expression::InputNode *in = static_cast<const Expression::InputNode *>(p_node);
+			program_inputs = MAX(program_inputs, in->index + 1);
+			return (in->index << ADDR_BITS) | ADDR_INPUT;
+		}
+		case Expression::ENode::TYPE_CONSTANT: {
+			const Expression::ConstantNode *c = static_cast<const Expression::ConstantNode *>(p_node);
+			return _add_constant(c->value);
+		}
+		case Expression::ENode::TYPE_SELF: {
+			Instruction instruction;
+			instruction.opcode = OPCODE_SELF;
+			return _add_instruction(instruction, LocalVector<int>());
+		}
+		case Expression::ENode::TYPE_OPERATOR: {
+			const Expression::OperatorNode *op = static_cast<const Expression::OperatorNode *>(p_node);
+
+			LocalVector<int> operands;
+			operands.push_back(_compile_node(op->nodes[0]));
+			operands.push_back(op->nodes[1] ? _compile_node(op->nodes[1]) : _add_constant(Variant()));
+
+			if ((operands[0] & ADDR_MASK) == ADDR_CONSTANT && (operands[1] & ADDR_MASK) == ADDR_CONSTANT) {
+				bool valid = true;
+				Variant ret;
+				Variant::evaluate(op->op, CONSTANT_VALUE(operands[0]), CONSTANT_VALUE(operands[1]), ret, valid);
+				if (valid) {
+					return _add_constant(ret);
+				}
+			}
+
+			Instruction instruction;
+			instruction.opcode = OPCODE_OPERATOR;
+			instruction.op = op->op;
+			return _add_instruction(instruction, operands);
+		}
+		case Expression::ENode::TYPE_INDEX: {
+			const Expression::IndexNode *index = static_cast<const Expression::IndexNode *>(p_node);
+
+			LocalVector<int> operands;
+			operands.push_back(_compile_node(index->base));
+			operands.push_back(_compile_node(index->index));
+
+			if ((operands[0] & ADDR_MASK) == ADDR_CONSTANT && (operands[1] & ADDR_MASK) == ADDR_CONSTANT) {
+				bool valid = false;
+				Variant ret = CONSTANT_VALUE(operands[0]).get(CONSTANT_VALUE(operands[1]), &valid);
+				if (valid) {
+					return _add_constant(ret);
+				}
+			}
+
+			Instruction instruction;
+			instruction.opcode = OPCODE_INDEX;
+			return _add_instruction(instruction, operands);
+		}
+		case Expression::ENode::TYPE_NAMED_INDEX: {
+			const Expression::NamedIndexNode *index = static_cast<const Expression::NamedIndexNode *>(p_node);
+
+			LocalVector<int> operands;
+			operands.push_back(_compile_node(index->base));
+
+			if ((operands[0] & ADDR_MASK) == ADDR_CONSTANT) {
+				bool valid = false;
+				Variant ret = CONSTANT_VALUE(operands[0]).get_named(index->name, valid);
+				if (valid) {
+					return _add_constant(ret);
+				}
+			}
+
+			Instruction instruction;
+			instruction.opcode = OPCODE_NAMED_INDEX;
+			instruction.name = index->name;
+			return _add_instruction(instruction, operands);
+		}
+		case Expression::ENode::TYPE_ARRAY: {
+			const Expression::ArrayNode *array = static_cast<const Expression::ArrayNode *>(p_node);
+
+			// Never folded, every execution returns a new array.
+			LocalVector<int> operands;
+			_compile_operands(array->array, operands);
+
+			Instruction instruction;
+			instruction.opcode = OPCODE_ARRAY;
+			return _add_instruction(instruction, operands);
+		}
+		case Expression::ENode::TYPE_DICTIONARY: {
+			const Expression::DictionaryNode *dictionary = static_cast<const Expression::DictionaryNode *>(p_node);
+
+			LocalVector<int> operands;
+			_compile_operands(dictionary->dict, operands);
+
+			Instruction instruction;
+			instruction.opcode = OPCODE_DICTIONARY;
+			return _add_instruction(instruction, operands);
+		}
+		case Expression::ENode::TYPE_CONSTRUCTOR: {
+			const Expression::ConstructorNode *constructor = static_cast<const Expression::ConstructorNode *>(p_node);
+
+			LocalVector<int> operands;
+			bool all_constant = _compile_operands(constructor->arguments, operands);
+
+			// Only value types, anything from Object onwards is shared by reference.
+			if (all_constant && constructor->data_type < Variant::OBJECT) {
+				const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * MAX(1u, operands.size()));
+				for (uint32_t i = 0; i < operands.size(); i++) {
+					argp[i] = &CONSTANT_VALUE(operands[i]);
+				}
+
+				Variant ret;
+				Callable::CallError ce;
+				Variant::construct(constructor->data_type, ret, argp, operands.size(), ce);
+				if (ce.error == Callable::CallError::CALL_OK) {
+					return _add_constant(ret);
+				}
+			}
+
+			Instruction instruction;
+			instruction.opcode = OPCODE_CONSTRUCT;
+			instruction.data_type = constructor->data_type;
+			return _add_instruction(instruction, operands);
+		}
+		case Expression::ENode::TYPE_BUILTIN_FUNC: {
+			const Expression::BuiltinFuncNode *bifunc = static_cast<const Expression::BuiltinFuncNode *>(p_node);
+
+			LocalVector<int> operands;
+			bool all_constant = _compile_operands(bifunc->arguments, operands);
+
+			// Math functions are pure, unlike the random and general ones.
+			if (all_constant && Variant::get_utility_function_type(bifunc->func) == Variant::UTILITY_FUNC_TYPE_MATH) {
+				const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * MAX(1u, operands.size()));
+				for (uint32_t i = 0; i < operands.size(); i++) {
+					argp[i] = &CONSTANT_VALUE(operands[i]);
+				}
+
+				Variant ret;
+				Callable::CallError ce;
+				Variant::call_utility_function(bifunc->func, &ret, argp, operands.size(), ce);
+				if (ce.error == Callable::CallError::CALL_OK) {
+					return _add_constant(ret);
+				}
+			}
+
+			Instruction instruction;
+			instruction.opcode = OPCODE_CALL_UTILITY;
+			instruction.name = bifunc->func;
+			instruction.utility_func = Variant::get_validated_utility_function(bifunc->func);
+			instruction.cache_has_return = Variant::has_utility_function_return_value(bifunc->func);
+			return _add_instruction(instruction, operands);
+		}
+		case Expression::ENode::TYPE_CALL: {
+			const Expression::CallNode *call = static_cast<const Expression::CallNode *>(p_node);
+
+			// Method calls are never folded, even const methods can have side effects (e.g. Callable.call()).
+			LocalVector<int> operands;
+			operands.push_back(_compile_node(call->base));
+			_compile_operands(call->arguments, operands);
+
+			Instruction instruction;
+			instruction.opcode = OPCODE_CALL;
+			instruction.name = call->method;
+			return _add_instruction(instruction, operands);
+		}
+	}
+
+#undef CONSTANT_VALUE
+
+	ERR_FAIL_V(_add_constant(Variant()));
+}
+
+void Expression::_update_cache(Instruction &p_instruction, const Variant **p_operands) {
+	p_instruction.cache_types.resize(p_instruction.operand_count);
+
+	// Validated calls skip all type checks and conversions, so they are only used when
+	// every operand has exactly the expected type. Objects always take the checked path,
+	// since they may have been freed.
+	bool has_object = false;
+	for (int i = 0; i < p_instruction.operand_count; i++) {
+		p_instruction.cache_types[i] = p_operands[i]->get_type();
+		has_object = has_object || p_instruction.cache_types[i] == Variant::OBJECT;
+	}
+	const Variant::Type *types = p_instruction.cache_types.ptr();
+
+	switch (p_instruction.opcode) {
+		case OPCODE_OPERATOR: {
+			p_instruction.operator_func = nullptr;
+			if (has_object) {
+				break;
+			}
+
+			// Division and modulo of integers check for zero, and shifts for negative amounts;
+			// the validated evaluators don't.
+			if (p_instruction.op == Variant::OP_DIVIDE || p_instruction.op == Variant::OP_MODULE || p_instruction.op == Variant::OP_SHIFT_LEFT || p_instruction.op == Variant::OP_SHIFT_RIGHT) {
+				bool checked = false;
+				for (int i = 0; i < 2; i++) {
+					checked = checked || types[i] == Variant::INT || types[i] == Variant::VECTOR2I || types[i] == Variant::VECTOR3I || types[i] == Variant::VECTOR4I || types[i] == Variant::STRING;
+				}
+				if (checked) {
+					break;
+				}
+			}
+
+			p_instruction.cache_return_type = Variant::get_operator_return_type(p_instruction.op, types[0], types[1]);
+			if (p_instruction.cache_return_type != Variant::NIL) {
+				p_instruction.operator_func = Variant::get_validated_operator_evaluator(p_instruction.op, types[0], types[1]);
+			}
+		} break;
+		case OPCODE_NAMED_INDEX: {
+			p_instruction.getter_func = nullptr;
+			if (has_object) {
+				break;
+			}
+
+			p_instruction.getter_func = Variant::get_member_validated_getter(types[0], p_instruction.name);
+			if (p_instruction.getter_func) {
+				p_instruction.cache_return_type = Variant::get_member_type(types[0], p_instruction.name);
+			}
+		} break;
+		case OPCODE_CONSTRUCT: {
+			p_instruction.constructor_func = nullptr;
+			if (has_object) {
+				break;
+			}
+
+			// Pick the same constructor as Variant::construct(), then only use it if no argument needs converting.
+			for (int i = 0; i < Variant::get_constructor_count(p_instruction.data_type); i++) {
+				if (Variant::get_constructor_argument_count(p_instruction.data_type, i) != p_instruction.operand_count) {
+					continue;
+				}
+
+				bool convertible = true;
+				bool exact = true;
+				for (int j = 0; j < p_instruction.operand_count; j++) {
+					Variant::Type type = Variant::get_constructor_argument_type(p_instruction.data_type, i, j);
+					convertible = convertible && Variant::can_convert_strict(types[j], type);
+					exact = exact && (type == Variant::NIL || type == types[j]);
+				}
+
+				if (convertible) {
+					if (exact) {
+						p_instruction.constructor_func = Variant::get_validated_constructor(p_instruction.data_type, i);
+					}
+					break;
+				}
+			}
+		} break;
+		case OPCODE_CALL_UTILITY: {
+			// The function itself is resolved at compile time, only the arguments are checked here.
+			p_instruction.cache_validated = false;
+			if (has_object || !p_instruction.utility_func || Variant::is_utility_function_vararg(p_instruction.name)) {
+				break;
+			}
+			if (Variant::get_utility_function_argument_count(p_instruction.name) != p_instruction.operand_count) {
+				break;
+			}
+
+			bool exact = true;
+			for (int i = 0; i < p_instruction.operand_count; i++) {
+				Variant::Type type = Variant::get_utility_function_argument_type(p_instruction.name, i);
+				exact = exact && (type == Variant::NIL || type == types[i]);
+			}
+			p_instruction.cache_validated = exact;
+		} break;
+		case OPCODE_CALL: {
+			p_instruction.method_func = nullptr;
+			if (has_object) {
+				break;
+			}
+
+			const Variant::Type base_type = types[0];
+			const int argument_count = p_instruction.operand_count - 1;
+			if (!Variant::has_builtin_method(base_type, p_instruction.name) || Variant::is_builtin_method_vararg(base_type, p_instruction.name)) {
+				break;
+			}
+			if (Variant::get_builtin_method_argument_count(base_type, p_instruction.name) != argument_count) {
+				break;
+			}
+
+			bool exact = true;
+			for (int i = 0; i < argument_count; i++) {
+				Variant::Type type = Variant::get_builtin_method_argument_type(base_type, p_instruction.name, i);
+				exact = exact && (type == Variant::NIL || type == types[i + 1]);
+			}
+			if (!exact) {
+				break;
+			}
+
+			p_instruction.method_func = Variant::get_validated_builtin_method(base_type, p_instruction.name);
+			p_instruction.cache_is_const = Variant::is_builtin_method_const(base_type, p_instruction.name);
+			p_instruction.cache_has_return = Variant::has_builtin_method_return_value(base_type, p_instruction.name);
+			p_instruction.cache_return_type = Variant::get_builtin_method_return_type(base_type, p_instruction.name);
+		} break;
+		default: {
+		} break;
+	}
+}
+
+static _FORCE_INLINE_ void _prepare_target(Variant *p_target, Variant::Type p_type) {
+	// Validated calls write into a target that already has the result type. Packed arrays
+	// are shared between Variant copies though, so those always start from a new one.
+	if (p_target->get_type() != p_type || p_type >= Variant::PACKED_BYTE_ARRAY) {
+		VariantInternal::initialize(p_target, p_type);
+	}
+}
+
+const Variant &Expression::_get_program_result(const Variant **p_inputs, const Variant *p_registers) const {
+	const int index = program_result >> ADDR_BITS;
+	switch (program_result & ADDR_MASK) {
+		case ADDR_CONSTANT:
+			return program_constants[index];
+		case ADDR_INPUT:
+			return *p_inputs[index];
+		default:
+			return p_registers[index];
+	}
+}
+
+bool Expression::_execute_program(const Variant **p_inputs, Object *p_instance, Variant *p_registers, const Variant **p_operands, bool p_const_calls_only, String &r_error_str) {
+	for (uint32_t i = 0; i < program.size(); i++) {
+		Instruction &instruction = program[i];
+		Variant *target = &p_registers[instruction.target];
+
+		const int *addresses = &program_operands[instruction.operands];
+		for (int j = 0; j < instruction.operand_count; j++) {
+			const int index = addresses[j] >> ADDR_BITS;
+			switch (addresses[j] & ADDR_MASK) {
+				case ADDR_CONSTANT: {
+					p_operands[j] = &program_constants[index];
+				} break;
+				case ADDR_INPUT: {
+					p_operands[j] = p_inputs[index];
+				} break;
+				default: {
+					p_operands[j] = &p_registers[index];
+				} break;
+			}
+		}
+
+		bool cache_hit = (int)instruction.cache_types.size() == instruction.operand_count;
+		for (int j = 0; cache_hit && j < instruction.operand_count; j++) {
+			cache_hit = instruction.cache_types[j] == p_operands[j]->get_type();
+		}
+		if (!cache_hit) {
+			_update_cache(instruction, p_operands);
+		}
+
+		switch (instruction.opcode) {
+			case OPCODE_SELF: {
+				if (!p_instance) {
+					r_error_str = RTR("self can't be used because instance is null (not passed)");
+					return true;
+				}
+				*target = p_instance;
+			} break;
+			case OPCODE_OPERATOR: {
+				if (instruction.operator_func) {
+					_prepare_target(target, instruction.cache_return_type);
+					instruction.operator_func(p_operands[0], p_operands[1], target);
+					break;
+				}
+
+				bool valid = true;
+				Variant::evaluate(instruction.op, *p_operands[0], *p_operands[1], *target, valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(instruction.op), Variant::get_type_name(p_operands[0]->get_type()), Variant::get_type_name(p_operands[1]->get_type()));
+					return true;
+				}
+			} break;
+			case OPCODE_INDEX: {
+				bool valid;
+				*target = p_operands[0]->get(*p_operands[1], &valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid index of type %s for base type %s"), Variant::get_type_name(p_operands[1]->get_type()), Variant::get_type_name(p_operands[0]->get_type()));
+					return true;
+				}
+			} break;
+			case OPCODE_NAMED_INDEX: {
+				if (instruction.getter_func) {
+					_prepare_target(target, instruction.cache_return_type);
+					instruction.getter_func(p_operands[0], target);
+					break;
+				}
+
+				bool valid;
+				*target = p_operands[0]->get_named(instruction.name, valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(instruction.name), Variant::get_type_name(p_operands[0]->get_type()));
+					return true;
+				}
+			} break;
+			case OPCODE_ARRAY: {
+				Array arr;
+				arr.resize(instruction.operand_count);
+				for (int j = 0; j < instruction.operand_count; j++) {
+					arr[j] = *p_operands[j];
+				}
+				*target = arr;
+			} break;
+			case OPCODE_DICTIONARY: {
+				Dictionary d;
+				for (int j = 0; j < instruction.operand_count; j += 2) {
+					d[*p_operands[j + 0]] = *p_operands[j + 1];
+				}
+				*target = d;
+			} break;
+			case OPCODE_CONSTRUCT: {
+				if (instruction.constructor_func) {
+					if (instruction.data_type >= Variant::PACKED_BYTE_ARRAY) {
+						VariantInternal::initialize(target, Variant::NIL);
+					}
+					instruction.constructor_func(target, p_operands);
+					break;
+				}
+
+				Callable::CallError ce;
+				Variant::construct(instruction.data_type, *target, p_operands, instruction.operand_count, ce);
+				if (ce.error != Callable::CallError::CALL_OK) {
+					r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(instruction.data_type));
+					return true;
+				}
+			} break;
+			case OPCODE_CALL_UTILITY: {
+				if (!instruction.cache_has_return) {
+					*target = Variant(); // May not return anything.
+				}
+
+				if (instruction.cache_validated) {
+					instruction.utility_func(target, p_operands, instruction.operand_count);
+					break;
+				}
+
+				Callable::CallError ce;
+				Variant::call_utility_function(instruction.name, target, p_operands, instruction.operand_count, ce);
+				if (ce.error != Callable::CallError::CALL_OK) {
+					r_error_str = "Builtin call failed: " + Variant::get_call_error_text(instruction.name, p_operands, instruction.operand_count, ce);
+					return true;
+				}
+			} break;
+			case OPCODE_CALL: {
+				// The tree walker calls methods on a copy of the base. Registers are only read by
+				// the instruction using them, so they can be modified in place; inputs and constants can't.
+				Variant base_copy;
+				Variant *base = const_cast<Variant *>(p_operands[0]);
+				const bool is_const = instruction.method_func && instruction.cache_is_const;
+				if (!is_const && (addresses[0] & ADDR_MASK) != ADDR_REGISTER) {
+					base_copy = *p_operands[0];
+					base = &base_copy;
+				}
+
+				if (instruction.method_func && (is_const || !p_const_calls_only)) {
+					if (instruction.cache_has_return) {
+						_prepare_target(target, instruction.cache_return_type);
+					} else {
+						*target = Variant();
+					}
+					instruction.method_func(base, p_operands + 1, instruction.operand_count - 1, target);
+					break;
+				}
+
+				Callable::CallError ce;
+				if (p_const_calls_only) {
+					base->call_const(instruction.name, p_operands + 1, instruction.operand_count - 1, *target, ce);
+				} else {
+					base->callp(instruction.name, p_operands + 1, instruction.operand_count - 1, *target, ce);
+				}
+
+				if (ce.error != Callable::CallError::CALL_OK) {
+					r_error_str = vformat(RTR("On call to '%s':"), String(instruction.name));
+					return true;
+				}
+			} break;
+		}
+	}
+
+	return false;
+}
+
 Error Expression::parse(const String &p_expression, const Vector<String> &p_input_names) {
 	if (nodes) {
 		memdelete(nodes);
@@ -1481,6 +2002,7 @@ Error Expression::parse(const String &p_expression, const Vector<String> &p_inpu
 
 	expression = p_expression;
 	root = _parse_expression();
+	_clear_program();
 
 	if (error_set) {
 		root = nullptr;
@@ -1491,6 +2013,8 @@ Error Expression::parse(const String &p_expression, const Vector<String> &p_inpu
 		return ERR_INVALID_PARAMETER;
 	}
 
+	program_result = _compile_node(root);
+
 	return OK;
 }
 
@@ -1500,7 +2024,32 @@ Variant Expression::execute(Array p_inputs, Object *p_base, bool p_show_error, b
 	execution_error = false;
 	Variant output;
 	String error_txt;
-	bool err = _execute(p_inputs, p_base, root, output, p_const_calls_only, error_txt);
+	bool err;
+	if (!use_program || p_inputs.size() < program_inputs) {
+		// Let the tree walker report the missing input in the same order as the other errors.
+		err = _execute(p_inputs, p_base, root, output, p_const_calls_only, error_txt);
+	} else {
+		const Variant **inputs = (const Variant **)alloca(sizeof(Variant *) * MAX(1, program_inputs));
+		const Array &input_values = p_inputs;
+		for (int i = 0; i < program_inputs; i++) {
+			inputs[i] = &input_values[i];
+		}
+		const Variant **operands = (const Variant **)alloca(sizeof(Variant *) * MAX(1, program_max_operands));
+		Variant *registers = (Variant *)alloca(sizeof(Variant) * MAX(1, program_registers));
+		for (int i = 0; i < program_registers; i++) {
+			memnew_placement(&registers[i], Variant);
+		}
+
+		err = _execute_program(inputs, p_base, registers, operands, p_const_calls_only, error_txt);
+		if (!err) {
+			output = _get_program_result(inputs, registers);
+		}
+
+		for (int i = 0; i < program_registers; i++) {
+			registers[i].~Variant();
+		}
+	}
+
 	if (err) {
 		execution_error = true;
 		error_str = error_txt;
@@ -1510,6 +2059,66 @@ Variant Expression::execute(Array p_inputs, Object *p_base, bool p_show_error, b
 	return output;
 }
 
+Array Expression::execute_batch(const Array &p_rows, Object *p_base, bool p_show_error, bool p_const_calls_only) {
+	ERR_FAIL_COND_V_MSG(error_set, Array(), "There was previously a parse error: " + error_str + ".");
+
+	execution_error = false;
+
+	// Same program as execute(), but the registers are set up once and reused by every row.
+	const Variant **inputs = (const Variant **)alloca(sizeof(Variant *) * MAX(1, program_inputs));
+	const Variant **operands = (const Variant **)alloca(sizeof(Variant *) * MAX(1, program_max_operands));
+	Variant *registers = (Variant *)alloca(sizeof(Variant) * MAX(1, program_registers));
+	for (int i = 0; i < program_registers; i++) {
+		memnew_placement(&registers[i], Variant);
+	}
+
+	Array outputs;
+	outputs.resize(p_rows.size());
+
+	bool err = false;
+	String error_txt;
+	for (int i = 0; i < p_rows.size(); i++) {
+		if (p_rows[i].get_type() != Variant::ARRAY) {
+			error_txt = vformat(RTR("Invalid row %d, expected an Array of inputs but got %s"), i, Variant::get_type_name(p_rows[i].get_type()));
+			err = true;
+			break;
+		}
+
+		const Array row = p_rows[i];
+		if (!use_program || row.size() < program_inputs) {
+			Variant output;
+			err = _execute(row, p_base, root, output, p_const_calls_only, error_txt);
+			if (err) {
+				break;
+			}
+			outputs[i] = output;
+			continue;
+		}
+
+		for (int j = 0; j < program_inputs; j++) {
+			inputs[j] = &row[j];
+		}
+		err = _execute_program(inputs, p_base, registers, operands, p_const_calls_only, error_txt);
+		if (err) {
+			break;
+		}
+		outputs[i] = _get_program_result(inputs, registers);
+	}
+
+	for (int i = 0; i < program_registers; i++) {
+		registers[i].~Variant();
+	}
+
+	if (err) {
+		execution_error = true;
+		error_str = error_txt;
+		ERR_FAIL_COND_V_MSG(p_show_error, Array(), error_str);
+		return Array();
+	}
+
+	return outputs;
+}
+
 bool Expression::has_execute_failed() const {
 	return execution_error;
 }
@@ -1521,6 +2130,7 @@ String Expression::get_error_text() const {
 void Expression::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("parse", "expression", "input_names"), &Expression::parse, DEFVAL(Vector<String>()));
 	ClassDB::bind_method(D_METHOD("execute", "inputs", "base_instance", "show_error", "const_calls_only"), &Expression::execute, DEFVAL(Array()), DEFVAL(Variant()), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("execute_batch", "rows", "base_instance", "show_error", "const_calls_only"), &Expression::execute_batch, DEFVAL(Variant()), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("has_execute_failed"), &Expression::has_execute_failed);
 	ClassDB::bind_method(D_METHOD("get_error_text"), &Expression::get_error_text);
 }
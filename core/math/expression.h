@@ -32,6 +32,7 @@
 #define EXPRESSION_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 
 class Expression : public RefCounted {
 	GDCLASS(Expression, RefCounted);
@@ -259,13 +260,82 @@ private:
 	bool execution_error = false;
 	bool _execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, bool p_const_calls_only, String &r_error_str);
 
+	// The tree above is lowered by parse() into a flat program working on registers.
+	// Operands are addresses: an index shifted by ADDR_BITS, tagged with the space it lives in.
+
+	enum Opcode {
+		OPCODE_SELF,
+		OPCODE_OPERATOR,
+		OPCODE_INDEX,
+		OPCODE_NAMED_INDEX,
+		OPCODE_ARRAY,
+		OPCODE_DICTIONARY,
+		OPCODE_CONSTRUCT,
+		OPCODE_CALL_UTILITY,
+		OPCODE_CALL,
+	};
+
+	enum Address {
+		ADDR_CONSTANT,
+		ADDR_INPUT,
+		ADDR_REGISTER,
+		ADDR_BITS = 2,
+		ADDR_MASK = (1 << ADDR_BITS) - 1,
+	};
+
+	struct Instruction {
+		Opcode opcode = OPCODE_SELF;
+		Variant::Operator op = Variant::OP_ADD;
+		Variant::Type data_type = Variant::NIL;
+		StringName name;
+		int target = 0;
+		int operands = 0; // Offset in program_operands.
+		int operand_count = 0;
+
+		// Resolved for the operand types seen last, so repeated executions skip the lookups.
+		LocalVector<Variant::Type> cache_types;
+		Variant::Type cache_return_type = Variant::NIL;
+		bool cache_has_return = true;
+		bool cache_is_const = false;
+		bool cache_validated = false;
+		Variant::ValidatedOperatorEvaluator operator_func = nullptr;
+		Variant::ValidatedGetter getter_func = nullptr;
+		Variant::ValidatedConstructor constructor_func = nullptr;
+		Variant::ValidatedUtilityFunction utility_func = nullptr;
+		Variant::ValidatedBuiltInMethod method_func = nullptr;
+	};
+
+	LocalVector<Instruction> program;
+	LocalVector<int> program_operands;
+	LocalVector<Variant> program_constants;
+	int program_result = 0;
+	int program_registers = 0;
+	int program_inputs = 0;
+	int program_max_operands = 0;
+	bool use_program = true;
+
+	void _clear_program();
+	int _add_constant(const Variant &p_value);
+	int _add_instruction(Instruction &p_instruction, const LocalVector<int> &p_operands);
+	bool _compile_operands(const Vector<ENode *> &p_nodes, LocalVector<int> &r_operands);
+	int _compile_node(ENode *p_node);
+	void _update_cache(Instruction &p_instruction, const Variant **p_operands);
+	const Variant &_get_program_result(const Variant **p_inputs, const Variant *p_registers) const;
+	bool _execute_program(const Variant **p_inputs, Object *p_instance, Variant *p_registers, const Variant **p_operands, bool p_const_calls_only, String &r_error_str);
+
 protected:
 	static void _bind_methods();
 
 public:
 	Error parse(const String &p_expression, const Vector<String> &p_input_names = Vector<String>());
 	Variant execute(Array p_inputs = Array(), Object *p_base = nullptr, bool p_show_error = true, bool p_const_calls_only = false);
+	Array execute_batch(const Array &p_rows, Object *p_base = nullptr, bool p_show_error = true, bool p_const_calls_only = false);
 	bool has_execute_failed() const;
+
+	// Walks the parsed tree instead of running the program it was compiled to.
+	// Slower, only meant to check and measure the program against it.
+	void set_use_program(bool p_use_program) { use_program = p_use_program; }
+	bool is_using_program() const { return use_program; }
 	String get_error_text() const;
 
 	Expression() {}
@@ -1218,6 +1218,38 @@ StringName ClassDB::get_property_getter(const StringName &p_class, const StringN
 	return StringName();
 }
 
+// Returns the method that get_property() or set_property() end up calling for this property on an
+// object of p_class, or null if they would resolve the name some other way.
+MethodBind *ClassDB::get_property_accessor(const StringName &p_class, const StringName &p_property, bool p_setter, int *r_index) {
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			const StringName &accessor = p_setter ? psg->setter : psg->getter;
+			if (!accessor) {
+				return nullptr;
+			}
+			if (r_index) {
+				*r_index = psg->index;
+			}
+			MethodBind *ptr = p_setter ? psg->_setptr : psg->_getptr;
+			if (ptr && (p_setter || psg->index < 0)) {
+				return ptr;
+			}
+			return get_method(p_class, accessor);
+		}
+
+		if (!p_setter && (check->constant_map.has(p_property) || check->method_map.has(p_property) || check->signal_map.has(p_property))) {
+			return nullptr;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return nullptr;
+}
+
 bool ClassDB::has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance) {
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
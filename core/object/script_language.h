@@ -408,6 +408,8 @@ public:
 
 	virtual void reload_all_scripts() = 0;
 	virtual void reload_tool_script(const Ref<Script> &p_script, bool p_soft_reload) = 0;
+	// Hint that the scripts at these paths are about to be loaded, so they can be compiled together.
+	virtual void compile_scripts(const Vector<String> &p_paths) {}
 	/* LOADER FUNCTIONS */
 
 	virtual void get_recognized_extensions(List<String> *p_extensions) const = 0;
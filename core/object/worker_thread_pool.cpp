@@ -32,6 +32,8 @@
 
 #include "core/os/os.h"
 
+#include <atomic>
+
 void WorkerThreadPool::Task::free_template_userdata() {
 	ERR_FAIL_COND(!template_userdata);
 	ERR_FAIL_COND(native_func_userdata == nullptr);
@@ -41,11 +43,45 @@ void WorkerThreadPool::Task::free_template_userdata() {
 
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
-void WorkerThreadPool::_process_task_queue() {
-	task_mutex.lock();
-	Task *task = task_queue.first()->self();
-	task_queue.remove(task_queue.first());
-	task_mutex.unlock();
+WorkerThreadPool::Task *WorkerThreadPool::_pop_task(int p_thread_index) {
+	if (p_thread_index >= 0) {
+		ThreadData &own = threads[p_thread_index];
+		own.queue_lock.lock();
+		SelfList<Task> *E = own.queue.last();
+		if (E) {
+			own.queue.remove(E);
+			own.queue_lock.unlock();
+			return E->self();
+		}
+		own.queue_lock.unlock();
+	}
+
+	// Nothing left locally, so steal from the other threads. The caller already consumed a post of
+	// task_available_semaphore, which guarantees there is a task queued somewhere that nobody else
+	// can claim, even if other thieves win the race for the ones seen first.
+	uint32_t thread_count = threads.size();
+	uint32_t start = p_thread_index >= 0 ? uint32_t(p_thread_index) + 1 : 0;
+	while (true) {
+		for (uint32_t i = 0; i < thread_count; i++) {
+			uint32_t victim_index = (start + i) % thread_count;
+			if (int(victim_index) == p_thread_index) {
+				continue;
+			}
+			ThreadData &victim = threads[victim_index];
+			victim.queue_lock.lock();
+			SelfList<Task> *E = victim.queue.first();
+			if (E) {
+				victim.queue.remove(E);
+				victim.queue_lock.unlock();
+				return E->self();
+			}
+			victim.queue_lock.unlock();
+		}
+	}
+}
+
+void WorkerThreadPool::_process_task_queue(int p_thread_index) {
+	Task *task = _pop_task(p_thread_index);
 	_process_task(task);
 }
 
@@ -54,7 +90,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 	if (p_task->group) {
 		// Handling a group
-		bool do_post = false;
+		bool do_post = p_task->group->max == 0; // Empty groups are only posted when they have dependencies, and complete right away.
 		Callable::CallError ce;
 		Variant ret;
 		Variant arg;
@@ -88,15 +124,17 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (low_priority && use_native_low_priority_threads) {
-			p_task->completed = true;
+			p_task->completed.set();
 			p_task->done_semaphore.post();
 			if (do_post) {
 				p_task->group->completed.set_to(true);
+				_notify_dependents(p_task->group->self);
 			}
 		} else {
 			if (do_post) {
-				p_task->group->done_semaphore.post();
 				p_task->group->completed.set_to(true);
+				_notify_dependents(p_task->group->self);
+				p_task->group->done_semaphore.post();
 			}
 			uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 			uint32_t finished_users = p_task->group->finished.increment();
@@ -126,36 +164,36 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.callp(nullptr, 0, ret, ce);
 		}
 
-		p_task->completed = true;
+		p_task->completed.set();
+		_notify_dependents(p_task->self);
 		p_task->done_semaphore.post();
 	}
 
 	if (!use_native_low_priority_threads && low_priority) {
 		// A low prioriry task was freed, so see if we can move a pending one to the high priority queue.
-		bool post = false;
+		Task *low_prio_task = nullptr;
 		task_mutex.lock();
 		if (low_priority_task_queue.first()) {
-			Task *low_prio_task = low_priority_task_queue.first()->self();
+			low_prio_task = low_priority_task_queue.first()->self();
 			low_priority_task_queue.remove(low_priority_task_queue.first());
-			task_queue.add_last(&low_prio_task->task_elem);
-			post = true;
 		} else {
 			low_priority_threads_used.decrement();
 		}
-		task_mutex.lock();
-		if (post) {
-			task_available_semaphore.post();
+		task_mutex.unlock();
+		if (low_prio_task) {
+			_push_tasks(&low_prio_task, 1);
 		}
 	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
+	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
 		singleton->task_available_semaphore.wait();
 		if (singleton->exit_threads.is_set()) {
 			break;
 		}
-		singleton->_process_task_queue();
+		singleton->_process_task_queue(thread_data->index);
 	}
 }
 
@@ -164,7 +202,48 @@ void WorkerThreadPool::_native_low_priority_thread_function(void *p_user) {
 	singleton->_process_task(task);
 }
 
+void WorkerThreadPool::_push_tasks(Task **p_tasks, uint32_t p_count) {
+	if (threads.is_empty()) {
+		// No worker threads (single-threaded platform or thread count of 0), so run the tasks on the caller.
+		// They complete before their IDs are returned, which keeps waiting on them valid.
+		for (uint32_t i = 0; i < p_count; i++) {
+			_process_task(p_tasks[i]);
+		}
+		return;
+	}
+
+	const int *thread_index = thread_ids.getptr(Thread::get_caller_id());
+	if (thread_index) {
+		// Posted from a pool thread, keep the work local. Idle threads will steal it if needed.
+		ThreadData &own = threads[*thread_index];
+		own.queue_lock.lock();
+		for (uint32_t i = 0; i < p_count; i++) {
+			own.queue.add_last(&p_tasks[i]->task_elem);
+		}
+		own.queue_lock.unlock();
+	} else {
+		// Spread the tasks over the thread queues, taking each queue lock only once.
+		uint32_t thread_count = threads.size();
+		uint32_t first = next_queue_index.postadd(p_count);
+		for (uint32_t i = 0; i < MIN(p_count, thread_count); i++) {
+			ThreadData &target = threads[(first + i) % thread_count];
+			target.queue_lock.lock();
+			for (uint32_t j = i; j < p_count; j += thread_count) {
+				target.queue.add_last(&p_tasks[j]->task_elem);
+			}
+			target.queue_lock.unlock();
+		}
+	}
+
+	task_available_semaphore.post(p_count);
+}
+
 void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
+	if (threads.is_empty() && !use_native_low_priority_threads) {
+		// Runs inline in _push_tasks(), it must not wait in the low priority queue for a thread that doesn't exist.
+		p_high_priority = true;
+	}
+
 	task_mutex.lock();
 	p_task->low_priority = !p_high_priority;
 	if (!p_high_priority && use_native_low_priority_threads) {
@@ -173,12 +252,11 @@ void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 		p_task->low_priority_thread->start(_native_low_priority_thread_function, p_task); // Pask task directly to thread.
 
 	} else if (p_high_priority || low_priority_threads_used.get() < max_low_priority_threads) {
-		task_queue.add_last(&p_task->task_elem);
 		if (!p_high_priority) {
 			low_priority_threads_used.increment();
 		}
 		task_mutex.unlock();
-		task_available_semaphore.post();
+		_push_tasks(&p_task, 1);
 	} else {
 		// Too many threads using low priority, must go to queue.
 		low_priority_task_queue.add_last(&p_task->task_elem);
@@ -186,24 +264,107 @@ void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 	}
 }
 
+bool WorkerThreadPool::_is_dependency_completed(TaskID p_id) const {
+	const Task *const *taskp = tasks.getptr(p_id);
+	if (taskp) {
+		return (*taskp)->completed.is_set();
+	}
+	const Group *const *groupp = groups.getptr(p_id);
+	if (groupp) {
+		return (*groupp)->completed.is_set();
+	}
+	ERR_FAIL_COND_V_MSG(p_id <= 0 || p_id >= (TaskID)last_task, true, "Invalid Task ID used as dependency: " + itos(p_id));
+	// Already waited for, so it is done.
+	return true;
+}
+
+bool WorkerThreadPool::_defer_until_dependencies(TaskID p_id, const Vector<TaskID> &p_dependencies, Task **p_tasks, uint32_t p_count) {
+	// Must be called with task_mutex locked.
+	uint32_t dependencies_left = 0;
+	for (const TaskID &dependency : p_dependencies) {
+		// Publish the edge before checking for completion, so that either this thread sees the
+		// dependency completed, or the completing thread sees the edge in _notify_dependents().
+		dependency_edges.increment();
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (_is_dependency_completed(dependency)) {
+			dependency_edges.decrement();
+			continue;
+		}
+		if (!task_dependents.has(dependency)) {
+			task_dependents.insert(dependency, TightLocalVector<TaskID>());
+		}
+		task_dependents[dependency].push_back(p_id);
+		dependencies_left++;
+	}
+
+	if (dependencies_left == 0) {
+		return false;
+	}
+
+	PendingTask pending;
+	pending.dependencies_left = dependencies_left;
+	pending.tasks.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		pending.tasks[i] = p_tasks[i];
+	}
+	pending_tasks.insert(p_id, pending);
+	return true;
+}
+
+void WorkerThreadPool::_notify_dependents(TaskID p_id) {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (dependency_edges.get() == 0) {
+		return; // Nothing can be waiting on this task.
+	}
+
+	LocalVector<Task *> ready_tasks;
+	task_mutex.lock();
+	TightLocalVector<TaskID> *dependents = task_dependents.getptr(p_id);
+	if (dependents) {
+		for (const TaskID &dependent : *dependents) {
+			PendingTask *pending = pending_tasks.getptr(dependent);
+			ERR_CONTINUE(!pending);
+			pending->dependencies_left--;
+			if (pending->dependencies_left == 0) {
+				for (Task *task : pending->tasks) {
+					task->low_priority = false;
+					ready_tasks.push_back(task);
+				}
+				pending_tasks.erase(dependent);
+			}
+		}
+		dependency_edges.sub(dependents->size());
+		task_dependents.erase(p_id);
+	}
+	task_mutex.unlock();
+
+	if (ready_tasks.size()) {
+		_push_tasks(ready_tasks.ptr(), ready_tasks.size());
+	}
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
 	TaskID id = last_task++;
+	task->self = id;
 	task->callable = p_callable;
 	task->native_func = p_func;
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
 	tasks.insert(id, task);
+	bool deferred = !p_dependencies.is_empty() && _defer_until_dependencies(id, p_dependencies, &task, 1);
 	task_mutex.unlock();
 
-	_post_task(task, p_high_priority);
+	if (!deferred) {
+		_post_task(task, p_high_priority);
+	}
 
 	return id;
 }
@@ -212,6 +373,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_dependent_task(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, true, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_dependent_task(const Vector<TaskID> &p_dependencies, const Callable &p_action, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, true, p_description, p_dependencies);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	task_mutex.lock();
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -220,7 +389,7 @@ bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 		ERR_FAIL_V_MSG(false, "Invalid Task ID"); // Invalid task
 	}
 
-	bool completed = (*taskp)->completed;
+	bool completed = (*taskp)->completed.is_set();
 	task_mutex.unlock();
 
 	return completed;
@@ -264,7 +433,7 @@ void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 				}
 				if (task_available_semaphore.try_wait()) {
 					// Solve tasks while they are around.
-					_process_task_queue();
+					_process_task_queue(*index);
 					continue;
 				}
 				OS::get_singleton()->delay_usec(1); // Microsleep, this could be converted to waiting for multiple objects in supported platforms for a bit more performance.
@@ -280,10 +449,15 @@ void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	task_mutex.unlock();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
-		p_tasks = threads.size();
+		p_tasks = MAX(1u, threads.size());
+	}
+	if (p_elements == 0 && !p_dependencies.is_empty()) {
+		// Dependents may be waiting on this group, so it can't complete before its own dependencies.
+		// Use a single task that does nothing but complete the group once posted.
+		p_tasks = 1;
 	}
 
 	task_mutex.lock();
@@ -293,7 +467,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	group->self = id;
 
 	Task **tasks_posted = nullptr;
-	if (p_elements == 0) {
+	if (p_elements == 0 && p_dependencies.is_empty()) {
 		// Should really not call it with zero Elements, but at least it should work.
 		group->completed.set_to(true);
 		group->done_semaphore.post();
@@ -320,16 +494,29 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	}
 
 	groups[id] = group;
+	bool deferred = !p_dependencies.is_empty() && _defer_until_dependencies(id, p_dependencies, tasks_posted, p_tasks);
 	task_mutex.unlock();
 
+	if (deferred) {
+		return id;
+	}
+
 	if (!p_high_priority && use_native_low_priority_threads) {
 		group->low_priority_native_tasks.resize(p_tasks);
 	}
 
-	for (int i = 0; i < p_tasks; i++) {
-		_post_task(tasks_posted[i], p_high_priority);
-		if (!p_high_priority && use_native_low_priority_threads) {
-			group->low_priority_native_tasks[i] = tasks_posted[i];
+	if (p_high_priority && p_tasks > 0) {
+		// Fan out the whole group at once rather than queuing the tasks one by one.
+		for (int i = 0; i < p_tasks; i++) {
+			tasks_posted[i]->low_priority = false;
+		}
+		_push_tasks(tasks_posted, p_tasks);
+	} else {
+		for (int i = 0; i < p_tasks; i++) {
+			_post_task(tasks_posted[i], p_high_priority);
+			if (use_native_low_priority_threads) {
+				group->low_priority_native_tasks[i] = tasks_posted[i];
+			}
 		}
 	}
 
@@ -344,6 +531,14 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_dependent_group_task(const Vector<TaskID> &p_dependencies, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, true, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_dependent_group_task(const Vector<TaskID> &p_dependencies, const Callable &p_action, int p_elements, int p_tasks, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, true, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	task_mutex.lock();
 	const Group *const *groupp = groups.getptr(p_group);
@@ -370,11 +565,15 @@ bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
 void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 	task_mutex.lock();
 	Group **groupp = groups.getptr(p_group);
+	Group *group = groupp ? *groupp : nullptr;
 	task_mutex.unlock();
-	if (!groupp) {
+	if (!group) {
 		ERR_FAIL_MSG("Invalid Group ID");
 	}
-	Group *group = *groupp;
+
+	// The group is removed from the map before it can be freed, so that dependency
+	// checks never look at a stale pointer. It has completed by then, which is what
+	// a missing ID means to them.
 
 	if (group->low_priority_native_tasks.size() > 0) {
 		for (Task *task : group->low_priority_native_tasks) {
@@ -386,11 +585,16 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		}
 
 		task_mutex.lock();
+		groups.erase(p_group);
 		group_allocator.free(group);
 		task_mutex.unlock();
 	} else {
 		group->done_semaphore.wait();
 
+		task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+		groups.erase(p_group);
+		task_mutex.unlock();
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -401,10 +605,11 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			task_mutex.unlock();
 		}
 	}
+}
 
-	task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
-	task_mutex.unlock();
+int WorkerThreadPool::get_thread_index() const {
+	const int *index = thread_ids.getptr(Thread::get_caller_id());
+	return index ? *index : -1;
 }
 
 void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_priority, float p_low_priority_task_ratio) {
@@ -460,11 +665,13 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
+	ClassDB::bind_method(D_METHOD("add_dependent_task", "dependencies", "action", "description"), &WorkerThreadPool::add_dependent_task, DEFVAL(String()));
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
+	ClassDB::bind_method(D_METHOD("add_dependent_group_task", "dependencies", "action", "elements", "tasks_needed", "description"), &WorkerThreadPool::add_dependent_group_task, DEFVAL(-1), DEFVAL(String()));
 }
 
 WorkerThreadPool::WorkerThreadPool() {
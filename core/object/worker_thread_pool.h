@@ -34,6 +34,7 @@
 #include "core/os/memory.h"
 #include "core/os/os.h"
 #include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
@@ -78,7 +79,8 @@ private:
 		void *native_func_userdata = nullptr;
 		String description;
 		Semaphore done_semaphore;
-		bool completed = false;
+		SafeFlag completed;
+		TaskID self = INVALID_TASK_ID; // Tasks belonging to a group use the group ID instead.
 		Group *group = nullptr;
 		SelfList<Task> task_elem;
 		bool waiting = false; // Waiting for completion
@@ -96,23 +98,38 @@ private:
 	PagedAllocator<Thread> native_thread_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
 
 	Mutex task_mutex;
-	Semaphore task_available_semaphore;
+	Semaphore task_available_semaphore; // Posted once per task queued in any of the thread queues.
 
 	struct ThreadData {
 		uint32_t index;
 		Thread thread;
+		// Each thread owns a queue. The owner pops from the back (most recently pushed work is
+		// likely still in cache), while idle threads steal from the front.
+		SpinLock queue_lock;
+		SelfList<Task>::List queue;
+	};
+
+	struct PendingTask {
+		uint32_t dependencies_left = 0;
+		TightLocalVector<Task *> tasks; // A single task, or all the tasks of a group.
 	};
 
 	TightLocalVector<ThreadData> threads;
 	SafeFlag exit_threads;
+	SafeNumeric<uint32_t> next_queue_index; // Round-robin target for tasks posted from outside the pool.
 
 	HashMap<Thread::ID, int> thread_ids;
 	HashMap<TaskID, Task *> tasks;
 	HashMap<GroupID, Group *> groups;
 
+	// Tasks and groups are held back in pending_tasks until all their dependencies have completed.
+	// task_dependents maps a task or group to those waiting for it. Both are protected by task_mutex.
+	HashMap<TaskID, PendingTask> pending_tasks;
+	HashMap<TaskID, TightLocalVector<TaskID>> task_dependents;
+	SafeNumeric<uint32_t> dependency_edges; // Checked on completion to skip locking when nobody depends on anything.
+
 	bool use_native_low_priority_threads = false;
 	uint32_t max_low_priority_threads = 0;
 	SafeNumeric<uint32_t> low_priority_threads_used;
@@ -122,15 +139,21 @@ private:
 	static void _thread_function(void *p_user);
 	static void _native_low_priority_thread_function(void *p_user);
 
-	void _process_task_queue();
+	Task *_pop_task(int p_thread_index);
+	void _process_task_queue(int p_thread_index);
 	void _process_task(Task *task);
 
+	void _push_tasks(Task **p_tasks, uint32_t p_count);
 	void _post_task(Task *p_task, bool p_high_priority);
 
+	bool _is_dependency_completed(TaskID p_id) const;
+	bool _defer_until_dependencies(TaskID p_id, const Vector<TaskID> &p_dependencies, Task **p_tasks, uint32_t p_count);
+	void _notify_dependents(TaskID p_id);
+
 	static WorkerThreadPool *singleton;
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
 
 	template <class C, class M, class U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -168,6 +191,20 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Dependent tasks and groups only start once all the tasks and groups they depend on have completed.
+	// They always run with high priority, and must still be waited for like any other task or group.
+	template <class C, class M, class U>
+	TaskID add_template_dependent_task(const Vector<TaskID> &p_dependencies, C *p_instance, M p_method, U p_userdata, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, true, p_description, p_dependencies);
+	}
+	TaskID add_native_dependent_task(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, const String &p_description = String());
+	TaskID add_dependent_task(const Vector<TaskID> &p_dependencies, const Callable &p_action, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	void wait_for_task_completion(TaskID p_task_id);
 
@@ -182,11 +219,26 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	template <class C, class M, class U>
+	GroupID add_template_dependent_group_task(const Vector<TaskID> &p_dependencies, C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, true, p_description, p_dependencies);
+	}
+	GroupID add_native_dependent_group_task(const Vector<TaskID> &p_dependencies, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, const String &p_description = String());
+	GroupID add_dependent_group_task(const Vector<TaskID> &p_dependencies, const Callable &p_action, int p_elements, int p_tasks = -1, const String &p_description = String());
+
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
+	// Index of the calling thread in the pool, or -1 if it's not a pool thread.
+	int get_thread_index() const;
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	void init(int p_thread_count = -1, bool p_use_native_threads_low_priority = true, float p_low_priority_task_ratio = 0.3);
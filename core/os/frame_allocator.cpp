@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  frame_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_allocator.h"
+
+#include <string.h>
+
+// Every allocation is preceded by its size, and chunks start with a pointer to the previous full chunk.
+#define FRAME_ALLOCATOR_HEADER_SIZE PAD_ALIGN
+#define FRAME_ALLOCATOR_MIN_CHUNK_SIZE (64 * 1024)
+
+static _FORCE_INLINE_ size_t _frame_allocator_padded_size(size_t p_bytes) {
+	return FRAME_ALLOCATOR_HEADER_SIZE + ((p_bytes + PAD_ALIGN - 1) & ~size_t(PAD_ALIGN - 1));
+}
+
+thread_local FrameAllocator::Arena FrameAllocator::arena;
+
+SafeNumeric<uint64_t> FrameAllocator::frame;
+SafeNumeric<uint64_t> FrameAllocator::current_frame_usage;
+SafeNumeric<uint64_t> FrameAllocator::last_frame_usage;
+SafeNumeric<uint64_t> FrameAllocator::max_frame_usage;
+SafeNumeric<uint64_t> FrameAllocator::reserved;
+
+void FrameAllocator::Arena::reset() {
+	if (full_chunks) {
+		// The chunk was too small last frame, replace everything with a single chunk that fits.
+		while (full_chunks) {
+			uint8_t *prev = *(uint8_t **)full_chunks;
+			reserved.sub(*(uint64_t *)(full_chunks + sizeof(uint8_t *)));
+			Memory::free_static(full_chunks);
+			full_chunks = prev;
+		}
+		reserved.sub(chunk_size);
+		Memory::free_static(chunk);
+		chunk = nullptr;
+		chunk_size = 0;
+		grow(frame_size);
+	}
+	offset = FRAME_ALLOCATOR_HEADER_SIZE;
+	frame_size = 0;
+	last_allocation = nullptr;
+}
+
+void FrameAllocator::Arena::grow(size_t p_bytes) {
+	if (chunk) {
+		// Remember the size of the full chunk in its header, for the statistics.
+		*(uint8_t **)chunk = full_chunks;
+		*(uint64_t *)(chunk + sizeof(uint8_t *)) = chunk_size;
+		full_chunks = chunk;
+	}
+
+	chunk_size = next_power_of_2(MAX(p_bytes + FRAME_ALLOCATOR_HEADER_SIZE, MAX(chunk_size * 2, (size_t)FRAME_ALLOCATOR_MIN_CHUNK_SIZE)));
+	chunk = (uint8_t *)Memory::alloc_static(chunk_size);
+	CRASH_COND_MSG(!chunk, "Out of memory");
+	offset = FRAME_ALLOCATOR_HEADER_SIZE;
+	reserved.add(chunk_size);
+}
+
+FrameAllocator::Arena::~Arena() {
+	while (full_chunks) {
+		uint8_t *prev = *(uint8_t **)full_chunks;
+		reserved.sub(*(uint64_t *)(full_chunks + sizeof(uint8_t *)));
+		Memory::free_static(full_chunks);
+		full_chunks = prev;
+	}
+	if (chunk) {
+		reserved.sub(chunk_size);
+		Memory::free_static(chunk);
+	}
+}
+
+FrameAllocator::Arena &FrameAllocator::_get_arena() {
+	Arena &a = arena;
+	uint64_t current_frame = frame.get();
+	if (unlikely(a.frame != current_frame)) {
+		a.reset();
+		a.frame = current_frame;
+	}
+	return a;
+}
+
+void *FrameAllocator::alloc(size_t p_bytes) {
+	Arena &a = _get_arena();
+
+	size_t size = _frame_allocator_padded_size(p_bytes);
+	if (unlikely(!a.chunk || a.offset + size > a.chunk_size)) {
+		a.grow(size);
+	}
+
+	uint8_t *mem = a.chunk + a.offset;
+	*(uint64_t *)mem = p_bytes;
+	a.offset += size;
+	a.frame_size += size;
+	a.last_allocation = mem + FRAME_ALLOCATOR_HEADER_SIZE;
+
+	current_frame_usage.add(size);
+	return a.last_allocation;
+}
+
+void *FrameAllocator::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+
+	uint8_t *mem = (uint8_t *)p_memory - FRAME_ALLOCATOR_HEADER_SIZE;
+	uint64_t old_bytes = *(uint64_t *)mem;
+
+	Arena &a = _get_arena();
+	if (p_memory == a.last_allocation) {
+		// Growing the last allocation of this thread, which can often be done in place.
+		size_t old_size = _frame_allocator_padded_size(old_bytes);
+		size_t new_size = _frame_allocator_padded_size(p_bytes);
+		size_t start = mem - a.chunk;
+		if (start + new_size <= a.chunk_size) {
+			*(uint64_t *)mem = p_bytes;
+			a.offset = start + new_size;
+			a.frame_size = a.frame_size + new_size - old_size;
+			if (new_size > old_size) {
+				current_frame_usage.add(new_size - old_size);
+			}
+			return p_memory;
+		}
+	}
+
+	void *new_memory = alloc(p_bytes);
+	memcpy(new_memory, p_memory, MIN(old_bytes, (uint64_t)p_bytes));
+	return new_memory;
+}
+
+void FrameAllocator::next_frame() {
+	uint64_t usage = current_frame_usage.get();
+	current_frame_usage.sub(usage);
+	last_frame_usage.set(usage);
+	max_frame_usage.exchange_if_greater(usage);
+	frame.increment();
+}
+
+uint64_t FrameAllocator::get_last_frame_usage() {
+	return last_frame_usage.get();
+}
+
+uint64_t FrameAllocator::get_max_frame_usage() {
+	return max_frame_usage.get();
+}
+
+uint64_t FrameAllocator::get_reserved() {
+	return reserved.get();
+}
@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  frame_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+#include "core/os/memory.h"
+#include "core/templates/safe_refcount.h"
+
+// Per-thread bump allocator for scratch allocations that never outlive the current frame.
+// Freeing does nothing, all the memory of a thread is reclaimed at once the first time it
+// allocates after a new frame started (see Main::iteration()). As each thread has its own
+// arena, no locking is involved.
+//
+// Only use it for data that is created and discarded within a single frame, from code that
+// can't run across a frame boundary (the main thread, or tasks waited on within the frame).
+// It can be used as the allocator of LocalVector, or with memnew_allocator().
+class FrameAllocator {
+	struct Arena {
+		uint8_t *chunk = nullptr;
+		size_t chunk_size = 0;
+		size_t offset = 0;
+		size_t frame_size = 0; // Bytes used this frame across all chunks, to size the chunk of the next frame.
+		uint64_t frame = 0;
+		void *last_allocation = nullptr;
+		uint8_t *full_chunks = nullptr; // Chunks filled up this frame, linked through their first bytes.
+
+		void reset();
+		void grow(size_t p_bytes);
+		~Arena();
+	};
+
+	static thread_local Arena arena;
+
+	static SafeNumeric<uint64_t> frame;
+	static SafeNumeric<uint64_t> current_frame_usage;
+	static SafeNumeric<uint64_t> last_frame_usage;
+	static SafeNumeric<uint64_t> max_frame_usage;
+	static SafeNumeric<uint64_t> reserved;
+
+	static Arena &_get_arena();
+
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	_FORCE_INLINE_ static void free(void *p_ptr) {}
+
+	static void next_frame();
+
+	static uint64_t get_last_frame_usage();
+	static uint64_t get_max_frame_usage();
+	static uint64_t get_reserved();
+};
+
+#endif // FRAME_ALLOCATOR_H
@@ -46,7 +46,7 @@ StringName _scs_create(const char *p_chr, bool p_static) {
 }
 
 bool StringName::configured = false;
-Mutex StringName::mutex;
+StringName::TableShard StringName::table_shards[STRING_TABLE_SHARD_LEN];
 
 #ifdef DEBUG_ENABLED
 bool StringName::debug_stringname = false;
@@ -61,12 +61,11 @@ void StringName::setup() {
 }
 
 void StringName::cleanup() {
-	MutexLock lock(mutex);
-
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (int i = 0; i < STRING_TABLE_LEN; i++) {
+			MutexLock lock(_get_table_mutex(i));
 			_Data *d = _table[i];
 			while (d) {
 				data.push_back(d);
@@ -94,6 +93,7 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (int i = 0; i < STRING_TABLE_LEN; i++) {
+		MutexLock lock(_get_table_mutex(i));
 		while (_table[i]) {
 			_Data *d = _table[i];
 			if (d->static_count.get() != d->refcount.get()) {
@@ -122,7 +122,22 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
+		// Once the count reaches zero, the entry can't be referenced again (ref() fails on it),
+		// so only unlinking it from its bucket needs the lock.
+		bool bucket_mismatch = false;
+		{
+			MutexLock lock(_get_table_mutex(_data->idx));
+			if (_data->prev) {
+				_data->prev->next = _data->next;
+			} else {
+				bucket_mismatch = _table[_data->idx] != _data;
+				_table[_data->idx] = _data->next;
+			}
+
+			if (_data->next) {
+				_data->next->prev = _data->prev;
+			}
+		}
 
 		if (_data->static_count.get() > 0) {
 			if (_data->cname) {
@@ -131,17 +146,8 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			if (_table[_data->idx] != _data) {
-				ERR_PRINT("BUG!");
-			}
-			_table[_data->idx] = _data->next;
-		}
-
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (bucket_mismatch) {
+			ERR_PRINT("BUG!");
 		}
 		memdelete(_data);
 	}
@@ -210,12 +216,12 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_data = _table[idx];
 
 	while (_data) {
@@ -269,12 +275,12 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_static_string.ptr);
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_data = _table[idx];
 
 	while (_data) {
@@ -329,11 +335,11 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_data = _table[idx];
 
 	while (_data) {
@@ -387,11 +393,11 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -423,12 +429,12 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -449,12 +455,12 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_Data *_data = _table[idx];
 
 	while (_data) {
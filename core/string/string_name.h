@@ -48,7 +48,12 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		// The table is split in shards, each protected by its own mutex, so that threads
+		// interning or releasing different names rarely contend on the same lock.
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARD_LEN = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_SHARD_MASK = STRING_TABLE_SHARD_LEN - 1
 	};
 
 	struct _Data {
@@ -80,7 +85,12 @@ class StringName {
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
-	static Mutex mutex;
+	struct alignas(64) TableShard { // Aligned to avoid false sharing between shards.
+		Mutex mutex;
+	};
+	static TableShard table_shards[STRING_TABLE_SHARD_LEN];
+	_FORCE_INLINE_ static const Mutex &_get_table_mutex(uint32_t p_idx) { return table_shards[p_idx & STRING_TABLE_SHARD_MASK].mutex; }
+
 	static void setup();
 	static void cleanup();
 	static bool configured;
@@ -0,0 +1,217 @@
+/**************************************************************************/
+/*  thread_cached_pool.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef THREAD_CACHED_POOL_H
+#define THREAD_CACHED_POOL_H
+
+#include "core/os/memory.h"
+#include "core/os/spin_lock.h"
+#include "core/typedefs.h"
+
+#include <utility>
+
+// Pool of objects of type T, for small blocks allocated and freed at high rates from any thread.
+// Each thread keeps a cache of free blocks, so most allocations and frees don't lock anything.
+// Caches exchange half of their size at a time with a shared store of slabs, and slabs go back
+// to the heap once all their blocks are free (keeping one around, so a thread allocating and
+// freeing the same block over and over doesn't allocate a slab every time).
+//
+// There is a single pool per type, which is never destroyed, so objects in static storage can
+// still be freed at exit. The blocks cached by a thread go back to the store when it exits.
+template <class T, uint32_t SLAB_SIZE = 256, uint32_t CACHE_SIZE = 32>
+class ThreadCachedPool {
+	struct Slab;
+
+	struct Block {
+		union {
+			alignas(T) uint8_t data[sizeof(T)];
+			Block *next; // While free in the store.
+		};
+		Slab *slab;
+	};
+
+	struct Slab {
+		Slab *prev; // In the list of slabs with free blocks.
+		Slab *next;
+		Block *free_list;
+		uint32_t used; // Blocks allocated or held by thread caches.
+		Block blocks[SLAB_SIZE];
+	};
+
+	struct Store {
+		SpinLock spin_lock;
+		Slab *available = nullptr;
+		Slab *spare = nullptr;
+
+		void _make_available(Slab *p_slab) {
+			p_slab->prev = nullptr;
+			p_slab->next = available;
+			if (available) {
+				available->prev = p_slab;
+			}
+			available = p_slab;
+		}
+
+		void _make_unavailable(Slab *p_slab) {
+			if (p_slab->prev) {
+				p_slab->prev->next = p_slab->next;
+			} else {
+				available = p_slab->next;
+			}
+			if (p_slab->next) {
+				p_slab->next->prev = p_slab->prev;
+			}
+		}
+
+		void take(Block **r_blocks, uint32_t p_count) {
+			spin_lock.lock();
+			for (uint32_t i = 0; i < p_count; i++) {
+				if (!available) {
+					Slab *slab = spare;
+					spare = nullptr;
+					if (!slab) {
+						slab = (Slab *)memalloc(sizeof(Slab));
+						slab->used = 0;
+						slab->free_list = nullptr;
+						for (uint32_t j = 0; j < SLAB_SIZE; j++) {
+							slab->blocks[j].slab = slab;
+							slab->blocks[j].next = slab->free_list;
+							slab->free_list = &slab->blocks[j];
+						}
+					}
+					_make_available(slab);
+				}
+				Slab *slab = available;
+				Block *block = slab->free_list;
+				slab->free_list = block->next;
+				slab->used++;
+				if (!slab->free_list) {
+					_make_unavailable(slab);
+				}
+				r_blocks[i] = block;
+			}
+			spin_lock.unlock();
+		}
+
+		void give(Block *const *p_blocks, uint32_t p_count) {
+			Slab *to_free = nullptr;
+			spin_lock.lock();
+			for (uint32_t i = 0; i < p_count; i++) {
+				Block *block = p_blocks[i];
+				Slab *slab = block->slab;
+				if (!slab->free_list) {
+					_make_available(slab);
+				}
+				block->next = slab->free_list;
+				slab->free_list = block;
+				slab->used--;
+				if (slab->used == 0) {
+					_make_unavailable(slab);
+					if (spare) {
+						// Freed outside of the lock.
+						slab->next = to_free;
+						to_free = slab;
+					} else {
+						spare = slab;
+					}
+				}
+			}
+			spin_lock.unlock();
+			while (to_free) {
+				Slab *next = to_free->next;
+				memfree(to_free);
+				to_free = next;
+			}
+		}
+	};
+
+	struct Cache {
+		Block *blocks[CACHE_SIZE];
+		uint32_t count = 0;
+
+		~Cache() {
+			_get_store().give(blocks, count);
+			count = 0;
+			_is_cache_released() = true;
+		}
+	};
+
+	static Store &_get_store() {
+		static Store *store = memnew(Store);
+		return *store;
+	}
+
+	static Cache &_get_cache() {
+		static thread_local Cache cache;
+		return cache;
+	}
+
+	// Set once the cache of the thread is destroyed at exit, blocks are freed to the store directly after that.
+	static bool &_is_cache_released() {
+		static thread_local bool released = false;
+		return released;
+	}
+
+public:
+	template <class... Args>
+	static T *alloc(Args &&...p_args) {
+		Block *block;
+		if (unlikely(_is_cache_released())) {
+			_get_store().take(&block, 1);
+		} else {
+			Cache &cache = _get_cache();
+			if (unlikely(cache.count == 0)) {
+				_get_store().take(cache.blocks, CACHE_SIZE / 2);
+				cache.count = CACHE_SIZE / 2;
+			}
+			block = cache.blocks[--cache.count];
+		}
+		T *mem = (T *)block->data;
+		memnew_placement(mem, T(std::forward<Args>(p_args)...));
+		return mem;
+	}
+
+	static void free(T *p_mem) {
+		p_mem->~T();
+		Block *block = (Block *)p_mem;
+		if (unlikely(_is_cache_released())) {
+			_get_store().give(&block, 1);
+			return;
+		}
+		Cache &cache = _get_cache();
+		if (unlikely(cache.count == CACHE_SIZE)) {
+			cache.count -= CACHE_SIZE / 2;
+			_get_store().give(cache.blocks + cache.count, CACHE_SIZE / 2);
+		}
+		cache.blocks[cache.count++] = block;
+	}
+};
+
+#endif // THREAD_CACHED_POOL_H
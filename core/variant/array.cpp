@@ -36,6 +36,7 @@
 #include "core/object/script_language.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/search_array.h"
+#include "core/templates/thread_cached_pool.h"
 #include "core/templates/vector.h"
 #include "core/variant/callable.h"
 #include "core/variant/dictionary.h"
@@ -49,6 +50,12 @@ public:
 	ContainerTypeValidate typed;
 };
 
+// Most arrays are short-lived (return values, signal arguments...), so their private
+// blocks come from a pool rather than a heap allocation each. It caches blocks per thread,
+// as arrays are created and released from every thread.
+// Note: ArrayPrivate's layout is mirrored by the C# glue, so elements stay in `array`.
+typedef ThreadCachedPool<ArrayPrivate> ArrayPrivatePool;
+
 void Array::_ref(const Array &p_from) const {
 	ArrayPrivate *_fp = p_from._p;
 
@@ -76,7 +83,7 @@ void Array::_unref() const {
 		if (_p->read_only) {
 			memdelete(_p->read_only);
 		}
-		memdelete(_p);
+		ArrayPrivatePool::free(_p);
 	}
 	_p = nullptr;
 }
@@ -754,7 +761,7 @@ const void *Array::id() const {
 }
 
 Array::Array(const Array &p_from, uint32_t p_type, const StringName &p_class_name, const Variant &p_script) {
-	_p = memnew(ArrayPrivate);
+	_p = ArrayPrivatePool::alloc();
 	_p->refcount.init();
 	set_typed(p_type, p_class_name, p_script);
 	assign(p_from);
@@ -811,7 +818,7 @@ Array::Array(const Array &p_from) {
 }
 
 Array::Array() {
-	_p = memnew(ArrayPrivate);
+	_p = ArrayPrivatePool::alloc();
 	_p->refcount.init();
 }
 
@@ -341,6 +341,15 @@ Callable::Callable(ObjectID p_object, const StringName &p_method) {
 	method = p_method;
 }
 
+Callable Callable::reference_custom(CallableCustom *p_custom) {
+	Callable callable;
+	ERR_FAIL_COND_V_MSG(!p_custom->referenced, callable, "Callable custom isn't referenced yet, construct a Callable from it instead.");
+	if (p_custom->ref_count.ref()) {
+		callable.custom = p_custom;
+	}
+	return callable;
+}
+
 Callable::Callable(CallableCustom *p_custom) {
 	if (p_custom->referenced) {
 		object = 0;
@@ -123,6 +123,10 @@ public:
 
 	operator String() const;
 
+	// Takes a new reference to a custom that's already owned by a Callable, without one at hand.
+	// Returns an empty Callable if the last reference was released and the custom is being freed.
+	static Callable reference_custom(CallableCustom *p_custom);
+
 	Callable(const Object *p_object, const StringName &p_method);
 	Callable(ObjectID p_object, const StringName &p_method);
 	Callable(CallableCustom *p_custom);
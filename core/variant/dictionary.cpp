@@ -32,6 +32,7 @@
 
 #include "core/templates/hash_map.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/thread_cached_pool.h"
 #include "core/variant/variant.h"
 // required in this order by VariantInternal, do not remove this comment.
 #include "core/object/class_db.h"
@@ -39,12 +40,29 @@
 #include "core/variant/type_info.h"
 #include "core/variant/variant_internal.h"
 
+typedef HashMapElement<Variant, Variant> DictionaryElement;
+
+// Dictionaries are often small and short-lived, so their private blocks and map elements come
+// from pools instead of a heap allocation each. They cache blocks per thread, as dictionaries
+// are created and released from every thread.
+typedef ThreadCachedPool<DictionaryElement> DictionaryElementPool;
+
+class DictionaryElementAllocator {
+public:
+	_FORCE_INLINE_ DictionaryElement *new_allocation(const DictionaryElement &&p_element) { return DictionaryElementPool::alloc(std::move(p_element)); }
+	_FORCE_INLINE_ void delete_allocation(DictionaryElement *p_allocation) { DictionaryElementPool::free(p_allocation); }
+};
+
+typedef HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator, DictionaryElementAllocator> DictionaryMap;
+
 struct DictionaryPrivate {
 	SafeRefCount refcount;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map;
+	DictionaryMap variant_map;
 };
 
+typedef ThreadCachedPool<DictionaryPrivate> DictionaryPrivatePool;
+
 void Dictionary::get_key_list(List<Variant> *p_keys) const {
 	if (_p->variant_map.is_empty()) {
 		return;
@@ -105,7 +123,7 @@ const Variant &Dictionary::operator[](const Variant &p_key) const {
 }
 
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	DictionaryMap::ConstIterator E(_p->variant_map.find(p_key));
 	if (!E) {
 		return nullptr;
 	}
@@ -113,7 +131,7 @@ const Variant *Dictionary::getptr(const Variant &p_key) const {
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E(_p->variant_map.find(p_key));
+	DictionaryMap::Iterator E(_p->variant_map.find(p_key));
 	if (!E) {
 		return nullptr;
 	}
@@ -126,7 +144,7 @@ Variant *Dictionary::getptr(const Variant &p_key) {
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	DictionaryMap::ConstIterator E(_p->variant_map.find(p_key));
 
 	if (!E) {
 		return Variant();
@@ -202,7 +220,7 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 	}
 	recursion_count++;
 	for (const KeyValue<Variant, Variant> &this_E : _p->variant_map) {
-		HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
+		DictionaryMap::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
 		if (!other_E || !this_E.value.hash_compare(other_E->value, recursion_count)) {
 			return false;
 		}
@@ -246,7 +264,7 @@ void Dictionary::_unref() const {
 		if (_p->read_only) {
 			memdelete(_p->read_only);
 		}
-		memdelete(_p);
+		DictionaryPrivatePool::free(_p);
 	}
 	_p = nullptr;
 }
@@ -314,7 +332,7 @@ const Variant *Dictionary::next(const Variant *p_key) const {
 		}
 		return nullptr;
 	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(*p_key);
+	DictionaryMap::Iterator E = _p->variant_map.find(*p_key);
 
 	if (!E) {
 		return nullptr;
@@ -381,7 +399,7 @@ Dictionary::Dictionary(const Dictionary &p_from) {
 }
 
 Dictionary::Dictionary() {
-	_p = memnew(DictionaryPrivate);
+	_p = DictionaryPrivatePool::alloc();
 	_p->refcount.init();
 }
 
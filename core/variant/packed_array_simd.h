@@ -0,0 +1,612 @@
+/**************************************************************************/
+/*  packed_array_simd.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PACKED_ARRAY_SIMD_H
+#define PACKED_ARRAY_SIMD_H
+
+#include "core/math/transform_3d.h"
+#include "core/math/vector3.h"
+
+// Vectorized loops of the bulk math methods of packed arrays.
+// SSE2 is used on x86 and NEON on ARM. Define PACKED_ARRAY_SIMD_DISABLED
+// to build the scalar versions only. Each kernel gives the same results
+// as its scalar version, the Vector3 ones are only vectorized when real_t
+// is float.
+#ifndef PACKED_ARRAY_SIMD_DISABLED
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PACKED_ARRAY_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define PACKED_ARRAY_SIMD_NEON
+#include <arm_neon.h>
+#if defined(__aarch64__) || defined(_M_ARM64)
+// Double precision vectors, used by the reductions.
+#define PACKED_ARRAY_SIMD_NEON_F64
+#endif
+#endif
+#endif
+
+class PackedArraySIMD {
+#ifdef PACKED_ARRAY_SIMD_SSE2
+	// Same as MIN() and MAX(): when the comparison is false, as with NaN, both return the second operand.
+	static _FORCE_INLINE_ __m128 _min(__m128 p_a, __m128 p_b) { return _mm_min_ps(p_a, p_b); }
+	static _FORCE_INLINE_ __m128 _max(__m128 p_a, __m128 p_b) { return _mm_max_ps(p_a, p_b); }
+#endif // PACKED_ARRAY_SIMD_SSE2
+
+#ifdef PACKED_ARRAY_SIMD_NEON
+	// vminq_f32() and vmaxq_f32() return NaN if either operand is NaN, MIN() and MAX() don't.
+	static _FORCE_INLINE_ float32x4_t _min(float32x4_t p_a, float32x4_t p_b) { return vbslq_f32(vcltq_f32(p_a, p_b), p_a, p_b); }
+	static _FORCE_INLINE_ float32x4_t _max(float32x4_t p_a, float32x4_t p_b) { return vbslq_f32(vcgtq_f32(p_a, p_b), p_a, p_b); }
+#endif // PACKED_ARRAY_SIMD_NEON
+
+public:
+	enum {
+		LANES = 4,
+		// Elements in a repeating pattern of 1, 2, 3 or 4 components that fill whole vectors.
+		PATTERN_SIZE = 12,
+	};
+
+	// Vector3 helpers, shared with the 3D physics kernels in GodotSIMD3D.
+#if defined(PACKED_ARRAY_SIMD_SSE2) && !defined(REAL_T_IS_DOUBLE)
+	// Loads 4 points and splits them into their x, y and z components.
+	static _FORCE_INLINE_ void load_points(const Vector3 *p_points, __m128 &r_x, __m128 &r_y, __m128 &r_z) {
+		const float *p = &p_points->x;
+		// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+		__m128 p0 = _mm_loadu_ps(p);
+		__m128 p1 = _mm_loadu_ps(p + 4);
+		__m128 p2 = _mm_loadu_ps(p + 8);
+
+		__m128 x01 = _mm_shuffle_ps(p0, p0, _MM_SHUFFLE(3, 3, 0, 0));
+		__m128 x23 = _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(1, 1, 2, 2));
+		r_x = _mm_shuffle_ps(x01, x23, _MM_SHUFFLE(2, 0, 2, 0));
+
+		__m128 y01 = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(0, 0, 1, 1));
+		__m128 y23 = _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 2, 3, 3));
+		r_y = _mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2, 0, 2, 0));
+
+		__m128 z01 = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 1, 2, 2));
+		__m128 z23 = _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 0, 0));
+		r_z = _mm_shuffle_ps(z01, z23, _MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+	// Inverse of load_points().
+	static _FORCE_INLINE_ void store_points(Vector3 *p_points, __m128 p_x, __m128 p_y, __m128 p_z) {
+		float *p = &p_points->x;
+		__m128 xy01 = _mm_unpacklo_ps(p_x, p_y); // x0 y0 x1 y1
+		__m128 xy23 = _mm_unpackhi_ps(p_x, p_y); // x2 y2 x3 y3
+
+		__m128 z0x1 = _mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(1, 1, 0, 0)); // z0 z0 x1 x1
+		_mm_storeu_ps(p, _mm_shuffle_ps(xy01, z0x1, _MM_SHUFFLE(2, 0, 1, 0)));
+
+		__m128 y1z1 = _mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(1, 1, 1, 1)); // y1 y1 z1 z1
+		_mm_storeu_ps(p + 4, _mm_shuffle_ps(y1z1, xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+
+		__m128 z23x3y3 = _mm_shuffle_ps(p_z, xy23, _MM_SHUFFLE(3, 2, 3, 2)); // z2 z3 x3 y3
+		_mm_storeu_ps(p + 8, _mm_shuffle_ps(z23x3y3, z23x3y3, _MM_SHUFFLE(1, 3, 2, 0)));
+	}
+
+	static _FORCE_INLINE_ __m128 dot_components(__m128 p_x, __m128 p_y, __m128 p_z, __m128 p_with_x, __m128 p_with_y, __m128 p_with_z) {
+		// Same order of operations as Vector3::dot().
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p_x, p_with_x), _mm_mul_ps(p_y, p_with_y)), _mm_mul_ps(p_z, p_with_z));
+	}
+#elif defined(PACKED_ARRAY_SIMD_NEON) && !defined(REAL_T_IS_DOUBLE)
+	static _FORCE_INLINE_ float32x4_t dot_components(float32x4_t p_x, float32x4_t p_y, float32x4_t p_z, float32x4_t p_with_x, float32x4_t p_with_y, float32x4_t p_with_z) {
+		// Separate multiplies and adds, so nothing is fused and the result matches Vector3::dot().
+		return vaddq_f32(vaddq_f32(vmulq_f32(p_x, p_with_x), vmulq_f32(p_y, p_with_y)), vmulq_f32(p_z, p_with_z));
+	}
+#endif
+
+	static const char *get_instruction_set() {
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		return "SSE2";
+#elif defined(PACKED_ARRAY_SIMD_NEON)
+		return "NEON";
+#else
+		return "scalar";
+#endif
+	}
+
+	/* REDUCTIONS */
+
+	// Reductions keep four separate accumulators, so the vector versions add in the same order.
+	// Floats are summed in double precision.
+
+	static double sum_scalar(const float *p_values, int p_count) {
+		double sum[LANES] = { 0, 0, 0, 0 };
+		int i = 0;
+		for (; i + LANES <= p_count; i += LANES) {
+			sum[0] += p_values[i + 0];
+			sum[1] += p_values[i + 1];
+			sum[2] += p_values[i + 2];
+			sum[3] += p_values[i + 3];
+		}
+		for (; i < p_count; i++) {
+			sum[0] += p_values[i];
+		}
+		return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+	}
+
+	static double sum(const float *p_values, int p_count) {
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		__m128d sum01 = _mm_setzero_pd();
+		__m128d sum23 = _mm_setzero_pd();
+		int i = 0;
+		for (; i + LANES <= p_count; i += LANES) {
+			__m128 v = _mm_loadu_ps(p_values + i);
+			sum01 = _mm_add_pd(sum01, _mm_cvtps_pd(v));
+			sum23 = _mm_add_pd(sum23, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+		}
+		double sum[LANES];
+		_mm_storeu_pd(sum, sum01);
+		_mm_storeu_pd(sum + 2, sum23);
+		for (; i < p_count; i++) {
+			sum[0] += p_values[i];
+		}
+		return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+#elif defined(PACKED_ARRAY_SIMD_NEON_F64)
+		float64x2_t sum01 = vdupq_n_f64(0);
+		float64x2_t sum23 = vdupq_n_f64(0);
+		int i = 0;
+		for (; i + LANES <= p_count; i += LANES) {
+			float32x4_t v = vld1q_f32(p_values + i);
+			sum01 = vaddq_f64(sum01, vcvt_f64_f32(vget_low_f32(v)));
+			sum23 = vaddq_f64(sum23, vcvt_high_f64_f32(v));
+		}
+		double sum[LANES];
+		vst1q_f64(sum, sum01);
+		vst1q_f64(sum + 2, sum23);
+		for (; i < p_count; i++) {
+			sum[0] += p_values[i];
+		}
+		return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+#else
+		return sum_scalar(p_values, p_count);
+#endif
+	}
+
+	static double dot_scalar(const float *p_a, const float *p_b, int p_count) {
+		double sum[LANES] = { 0, 0, 0, 0 };
+		int i = 0;
+		for (; i + LANES <= p_count; i += LANES) {
+			sum[0] += double(p_a[i + 0]) * p_b[i + 0];
+			sum[1] += double(p_a[i + 1]) * p_b[i + 1];
+			sum[2] += double(p_a[i + 2]) * p_b[i + 2];
+			sum[3] += double(p_a[i + 3]) * p_b[i + 3];
+		}
+		for (; i < p_count; i++) {
+			sum[0] += double(p_a[i]) * p_b[i];
+		}
+		return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+	}
+
+	static double dot(const float *p_a, const float *p_b, int p_count) {
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		__m128d sum01 = _mm_setzero_pd();
+		__m128d sum23 = _mm_setzero_pd();
+		int i = 0;
+		for (; i + LANES <= p_count; i += LANES) {
+			__m128 a = _mm_loadu_ps(p_a + i);
+			__m128 b = _mm_loadu_ps(p_b + i);
+			sum01 = _mm_add_pd(sum01, _mm_mul_pd(_mm_cvtps_pd(a), _mm_cvtps_pd(b)));
+			sum23 = _mm_add_pd(sum23, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), _mm_cvtps_pd(_mm_movehl_ps(b, b))));
+		}
+		double sum[LANES];
+		_mm_storeu_pd(sum, sum01);
+		_mm_storeu_pd(sum + 2, sum23);
+		for (; i < p_count; i++) {
+			sum[0] += double(p_a[i]) * p_b[i];
+		}
+		return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+#elif defined(PACKED_ARRAY_SIMD_NEON_F64)
+		float64x2_t sum01 = vdupq_n_f64(0);
+		float64x2_t sum23 = vdupq_n_f64(0);
+		int i = 0;
+		for (; i + LANES <= p_count; i += LANES) {
+			float32x4_t a = vld1q_f32(p_a + i);
+			float32x4_t b = vld1q_f32(p_b + i);
+			// The products of two floats are exact in double precision, so fusing them doesn't change the result.
+			sum01 = vaddq_f64(sum01, vmulq_f64(vcvt_f64_f32(vget_low_f32(a)), vcvt_f64_f32(vget_low_f32(b))));
+			sum23 = vaddq_f64(sum23, vmulq_f64(vcvt_high_f64_f32(a), vcvt_high_f64_f32(b)));
+		}
+		double sum[LANES];
+		vst1q_f64(sum, sum01);
+		vst1q_f64(sum + 2, sum23);
+		for (; i < p_count; i++) {
+			sum[0] += double(p_a[i]) * p_b[i];
+		}
+		return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+#else
+		return dot_scalar(p_a, p_b, p_count);
+#endif
+	}
+
+	// p_count must be at least 1.
+	static float min_value_scalar(const float *p_values, int p_count) {
+		float result[LANES] = { p_values[0], p_values[0], p_values[0], p_values[0] };
+		int i = 0;
+		for (; i + LANES <= p_count; i += LANES) {
+			result[0] = MIN(result[0], p_values[i + 0]);
+			result[1] = MIN(result[1], p_values[i + 1]);
+			result[2] = MIN(result[2], p_values[i + 2]);
+			result[3] = MIN(result[3], p_values[i + 3]);
+		}
+		for (; i < p_count; i++) {
+			result[0] = MIN(result[0], p_values[i]);
+		}
+		return MIN(MIN(result[0], result[1]), MIN(result[2], result[3]));
+	}
+
+	static float min_value(const float *p_values, int p_count) {
+#if defined(PACKED_ARRAY_SIMD_SSE2) || defined(PACKED_ARRAY_SIMD_NEON)
+		float result[LANES];
+		int i = 0;
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		__m128 m = _mm_set1_ps(p_values[0]);
+		for (; i + LANES <= p_count; i += LANES) {
+			m = _min(m, _mm_loadu_ps(p_values + i));
+		}
+		_mm_storeu_ps(result, m);
+#else
+		float32x4_t m = vdupq_n_f32(p_values[0]);
+		for (; i + LANES <= p_count; i += LANES) {
+			m = _min(m, vld1q_f32(p_values + i));
+		}
+		vst1q_f32(result, m);
+#endif
+		for (; i < p_count; i++) {
+			result[0] = MIN(result[0], p_values[i]);
+		}
+		return MIN(MIN(result[0], result[1]), MIN(result[2], result[3]));
+#else
+		return min_value_scalar(p_values, p_count);
+#endif
+	}
+
+	// p_count must be at least 1.
+	static float max_value_scalar(const float *p_values, int p_count) {
+		float result[LANES] = { p_values[0], p_values[0], p_values[0], p_values[0] };
+		int i = 0;
+		for (; i + LANES <= p_count; i += LANES) {
+			result[0] = MAX(result[0], p_values[i + 0]);
+			result[1] = MAX(result[1], p_values[i + 1]);
+			result[2] = MAX(result[2], p_values[i + 2]);
+			result[3] = MAX(result[3], p_values[i + 3]);
+		}
+		for (; i < p_count; i++) {
+			result[0] = MAX(result[0], p_values[i]);
+		}
+		return MAX(MAX(result[0], result[1]), MAX(result[2], result[3]));
+	}
+
+	static float max_value(const float *p_values, int p_count) {
+#if defined(PACKED_ARRAY_SIMD_SSE2) || defined(PACKED_ARRAY_SIMD_NEON)
+		float result[LANES];
+		int i = 0;
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		__m128 m = _mm_set1_ps(p_values[0]);
+		for (; i + LANES <= p_count; i += LANES) {
+			m = _max(m, _mm_loadu_ps(p_values + i));
+		}
+		_mm_storeu_ps(result, m);
+#else
+		float32x4_t m = vdupq_n_f32(p_values[0]);
+		for (; i + LANES <= p_count; i += LANES) {
+			m = _max(m, vld1q_f32(p_values + i));
+		}
+		vst1q_f32(result, m);
+#endif
+		for (; i < p_count; i++) {
+			result[0] = MAX(result[0], p_values[i]);
+		}
+		return MAX(MAX(result[0], result[1]), MAX(result[2], result[3]));
+#else
+		return max_value_scalar(p_values, p_count);
+#endif
+	}
+
+	/* ELEMENT-WISE */
+
+	// These work on the float components of any packed array, p_count is the amount of floats.
+
+	static void add_scalar(float *p_values, const float *p_other, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			p_values[i] += p_other[i];
+		}
+	}
+
+	static void add(float *p_values, const float *p_other, int p_count) {
+		int i = 0;
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		for (; i + LANES <= p_count; i += LANES) {
+			_mm_storeu_ps(p_values + i, _mm_add_ps(_mm_loadu_ps(p_values + i), _mm_loadu_ps(p_other + i)));
+		}
+#elif defined(PACKED_ARRAY_SIMD_NEON)
+		for (; i + LANES <= p_count; i += LANES) {
+			vst1q_f32(p_values + i, vaddq_f32(vld1q_f32(p_values + i), vld1q_f32(p_other + i)));
+		}
+#endif
+		add_scalar(p_values + i, p_other + i, p_count - i);
+	}
+
+	static void multiply_scalar(float *p_values, const float *p_other, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			p_values[i] *= p_other[i];
+		}
+	}
+
+	static void multiply(float *p_values, const float *p_other, int p_count) {
+		int i = 0;
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		for (; i + LANES <= p_count; i += LANES) {
+			_mm_storeu_ps(p_values + i, _mm_mul_ps(_mm_loadu_ps(p_values + i), _mm_loadu_ps(p_other + i)));
+		}
+#elif defined(PACKED_ARRAY_SIMD_NEON)
+		for (; i + LANES <= p_count; i += LANES) {
+			vst1q_f32(p_values + i, vmulq_f32(vld1q_f32(p_values + i), vld1q_f32(p_other + i)));
+		}
+#endif
+		multiply_scalar(p_values + i, p_other + i, p_count - i);
+	}
+
+	static void scale_scalar(float *p_values, float p_factor, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			p_values[i] *= p_factor;
+		}
+	}
+
+	static void scale(float *p_values, float p_factor, int p_count) {
+		int i = 0;
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		const __m128 factor = _mm_set1_ps(p_factor);
+		for (; i + LANES <= p_count; i += LANES) {
+			_mm_storeu_ps(p_values + i, _mm_mul_ps(_mm_loadu_ps(p_values + i), factor));
+		}
+#elif defined(PACKED_ARRAY_SIMD_NEON)
+		const float32x4_t factor = vdupq_n_f32(p_factor);
+		for (; i + LANES <= p_count; i += LANES) {
+			vst1q_f32(p_values + i, vmulq_f32(vld1q_f32(p_values + i), factor));
+		}
+#endif
+		scale_scalar(p_values + i, p_factor, p_count - i);
+	}
+
+	static void lerp_scalar(float *p_values, const float *p_to, float p_weight, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			p_values[i] = p_values[i] + (p_to[i] - p_values[i]) * p_weight;
+		}
+	}
+
+	static void lerp(float *p_values, const float *p_to, float p_weight, int p_count) {
+		int i = 0;
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		const __m128 weight = _mm_set1_ps(p_weight);
+		for (; i + LANES <= p_count; i += LANES) {
+			__m128 v = _mm_loadu_ps(p_values + i);
+			_mm_storeu_ps(p_values + i, _mm_add_ps(v, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_to + i), v), weight)));
+		}
+#elif defined(PACKED_ARRAY_SIMD_NEON)
+		const float32x4_t weight = vdupq_n_f32(p_weight);
+		for (; i + LANES <= p_count; i += LANES) {
+			float32x4_t v = vld1q_f32(p_values + i);
+			vst1q_f32(p_values + i, vaddq_f32(v, vmulq_f32(vsubq_f32(vld1q_f32(p_to + i), v), weight)));
+		}
+#endif
+		lerp_scalar(p_values + i, p_to + i, p_weight, p_count - i);
+	}
+
+	// Adds the p_components floats of p_value to every element.
+	static void add_value_scalar(float *p_values, const float *p_value, int p_components, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			p_values[i] += p_value[i % p_components];
+		}
+	}
+
+	static void add_value(float *p_values, const float *p_value, int p_components, int p_count) {
+		int i = 0;
+#if defined(PACKED_ARRAY_SIMD_SSE2) || defined(PACKED_ARRAY_SIMD_NEON)
+		float pattern[PATTERN_SIZE];
+		for (int j = 0; j < PATTERN_SIZE; j++) {
+			pattern[j] = p_value[j % p_components];
+		}
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		const __m128 v0 = _mm_loadu_ps(pattern);
+		const __m128 v1 = _mm_loadu_ps(pattern + 4);
+		const __m128 v2 = _mm_loadu_ps(pattern + 8);
+		for (; i + PATTERN_SIZE <= p_count; i += PATTERN_SIZE) {
+			float *w = p_values + i;
+			_mm_storeu_ps(w, _mm_add_ps(_mm_loadu_ps(w), v0));
+			_mm_storeu_ps(w + 4, _mm_add_ps(_mm_loadu_ps(w + 4), v1));
+			_mm_storeu_ps(w + 8, _mm_add_ps(_mm_loadu_ps(w + 8), v2));
+		}
+#else
+		const float32x4_t v0 = vld1q_f32(pattern);
+		const float32x4_t v1 = vld1q_f32(pattern + 4);
+		const float32x4_t v2 = vld1q_f32(pattern + 8);
+		for (; i + PATTERN_SIZE <= p_count; i += PATTERN_SIZE) {
+			float *w = p_values + i;
+			vst1q_f32(w, vaddq_f32(vld1q_f32(w), v0));
+			vst1q_f32(w + 4, vaddq_f32(vld1q_f32(w + 4), v1));
+			vst1q_f32(w + 8, vaddq_f32(vld1q_f32(w + 8), v2));
+		}
+#endif
+#endif
+		// The pattern size is a multiple of every component count, so the remaining ones start at the first component.
+		add_value_scalar(p_values + i, p_value, p_components, p_count - i);
+	}
+
+	// Clamps every element between the p_components floats of p_min and p_max, like CLAMP().
+	static void clamp_scalar(float *p_values, const float *p_min, const float *p_max, int p_components, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			p_values[i] = CLAMP(p_values[i], p_min[i % p_components], p_max[i % p_components]);
+		}
+	}
+
+	// Gives the same results as clamp_scalar() as long as every minimum is not larger than its maximum.
+	static void clamp(float *p_values, const float *p_min, const float *p_max, int p_components, int p_count) {
+		int i = 0;
+#if defined(PACKED_ARRAY_SIMD_SSE2) || defined(PACKED_ARRAY_SIMD_NEON)
+		float min_pattern[PATTERN_SIZE];
+		float max_pattern[PATTERN_SIZE];
+		for (int j = 0; j < PATTERN_SIZE; j++) {
+			min_pattern[j] = p_min[j % p_components];
+			max_pattern[j] = p_max[j % p_components];
+		}
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+		__m128 min_v[3];
+		__m128 max_v[3];
+		for (int j = 0; j < 3; j++) {
+			min_v[j] = _mm_loadu_ps(min_pattern + j * LANES);
+			max_v[j] = _mm_loadu_ps(max_pattern + j * LANES);
+		}
+		for (; i + PATTERN_SIZE <= p_count; i += PATTERN_SIZE) {
+			for (int j = 0; j < 3; j++) {
+				float *w = p_values + i + j * LANES;
+				// The value is the second operand, so NaN is kept like CLAMP() does.
+				_mm_storeu_ps(w, _min(max_v[j], _max(min_v[j], _mm_loadu_ps(w))));
+			}
+		}
+#else
+		float32x4_t min_v[3];
+		float32x4_t max_v[3];
+		for (int j = 0; j < 3; j++) {
+			min_v[j] = vld1q_f32(min_pattern + j * LANES);
+			max_v[j] = vld1q_f32(max_pattern + j * LANES);
+		}
+		for (; i + PATTERN_SIZE <= p_count; i += PATTERN_SIZE) {
+			for (int j = 0; j < 3; j++) {
+				float *w = p_values + i + j * LANES;
+				vst1q_f32(w, _min(max_v[j], _max(min_v[j], vld1q_f32(w))));
+			}
+		}
+#endif
+#endif
+		clamp_scalar(p_values + i, p_min, p_max, p_components, p_count - i);
+	}
+
+	/* VECTOR3 */
+
+	static void lengths_scalar(const Vector3 *p_points, int p_count, float *r_lengths) {
+		for (int i = 0; i < p_count; i++) {
+			r_lengths[i] = p_points[i].length();
+		}
+	}
+
+	static void lengths(const Vector3 *p_points, int p_count, float *r_lengths) {
+		int i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && defined(PACKED_ARRAY_SIMD_SSE2)
+		for (; i + LANES <= p_count; i += LANES) {
+			__m128 x, y, z;
+			load_points(p_points + i, x, y, z);
+			_mm_storeu_ps(r_lengths + i, _mm_sqrt_ps(dot_components(x, y, z, x, y, z)));
+		}
+#elif !defined(REAL_T_IS_DOUBLE) && defined(PACKED_ARRAY_SIMD_NEON_F64)
+		// ARMv7 NEON has no vector square root.
+		for (; i + LANES <= p_count; i += LANES) {
+			float32x4x3_t p = vld3q_f32(&p_points[i].x);
+			vst1q_f32(r_lengths + i, vsqrtq_f32(dot_components(p.val[0], p.val[1], p.val[2], p.val[0], p.val[1], p.val[2])));
+		}
+#endif
+		lengths_scalar(p_points + i, p_count - i, r_lengths + i);
+	}
+
+	static void dots_scalar(const Vector3 *p_a, const Vector3 *p_b, int p_count, float *r_dots) {
+		for (int i = 0; i < p_count; i++) {
+			r_dots[i] = p_a[i].dot(p_b[i]);
+		}
+	}
+
+	static void dots(const Vector3 *p_a, const Vector3 *p_b, int p_count, float *r_dots) {
+		int i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && defined(PACKED_ARRAY_SIMD_SSE2)
+		for (; i + LANES <= p_count; i += LANES) {
+			__m128 ax, ay, az, bx, by, bz;
+			load_points(p_a + i, ax, ay, az);
+			load_points(p_b + i, bx, by, bz);
+			_mm_storeu_ps(r_dots + i, dot_components(ax, ay, az, bx, by, bz));
+		}
+#elif !defined(REAL_T_IS_DOUBLE) && defined(PACKED_ARRAY_SIMD_NEON)
+		for (; i + LANES <= p_count; i += LANES) {
+			float32x4x3_t a = vld3q_f32(&p_a[i].x);
+			float32x4x3_t b = vld3q_f32(&p_b[i].x);
+			vst1q_f32(r_dots + i, dot_components(a.val[0], a.val[1], a.val[2], b.val[0], b.val[1], b.val[2]));
+		}
+#endif
+		dots_scalar(p_a + i, p_b + i, p_count - i, r_dots + i);
+	}
+
+	static void transform_scalar(Vector3 *p_points, int p_count, const Transform3D &p_transform) {
+		for (int i = 0; i < p_count; i++) {
+			p_points[i] = p_transform.xform(p_points[i]);
+		}
+	}
+
+	static void transform(Vector3 *p_points, int p_count, const Transform3D &p_transform) {
+		int i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && defined(PACKED_ARRAY_SIMD_SSE2)
+		__m128 basis[3][3];
+		__m128 origin[3];
+		for (int j = 0; j < 3; j++) {
+			basis[j][0] = _mm_set1_ps(p_transform.basis[j].x);
+			basis[j][1] = _mm_set1_ps(p_transform.basis[j].y);
+			basis[j][2] = _mm_set1_ps(p_transform.basis[j].z);
+			origin[j] = _mm_set1_ps(p_transform.origin[j]);
+		}
+		for (; i + LANES <= p_count; i += LANES) {
+			__m128 x, y, z;
+			load_points(p_points + i, x, y, z);
+			// Same as Transform3D::xform(), a dot product with each row of the basis plus the origin.
+			store_points(p_points + i,
+					_mm_add_ps(dot_components(basis[0][0], basis[0][1], basis[0][2], x, y, z), origin[0]),
+					_mm_add_ps(dot_components(basis[1][0], basis[1][1], basis[1][2], x, y, z), origin[1]),
+					_mm_add_ps(dot_components(basis[2][0], basis[2][1], basis[2][2], x, y, z), origin[2]));
+		}
+#elif !defined(REAL_T_IS_DOUBLE) && defined(PACKED_ARRAY_SIMD_NEON)
+		float32x4_t basis[3][3];
+		float32x4_t origin[3];
+		for (int j = 0; j < 3; j++) {
+			basis[j][0] = vdupq_n_f32(p_transform.basis[j].x);
+			basis[j][1] = vdupq_n_f32(p_transform.basis[j].y);
+			basis[j][2] = vdupq_n_f32(p_transform.basis[j].z);
+			origin[j] = vdupq_n_f32(p_transform.origin[j]);
+		}
+		for (; i + LANES <= p_count; i += LANES) {
+			float32x4x3_t p = vld3q_f32(&p_points[i].x);
+			float32x4x3_t result;
+			for (int j = 0; j < 3; j++) {
+				result.val[j] = vaddq_f32(dot_components(basis[j][0], basis[j][1], basis[j][2], p.val[0], p.val[1], p.val[2]), origin[j]);
+			}
+			vst3q_f32(&p_points[i].x, result);
+		}
+#endif
+		transform_scalar(p_points + i, p_count - i, p_transform);
+	}
+};
+
+#endif // PACKED_ARRAY_SIMD_H
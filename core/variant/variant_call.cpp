@@ -39,6 +39,7 @@
 #include "core/os/os.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
+#include "core/variant/packed_array_simd.h"
 
 typedef void (*VariantFunc)(Variant &r_ret, Variant &p_self, const Variant **p_args);
 typedef void (*VariantConstructFunc)(Variant &r_ret, const Variant **p_args);
@@ -658,6 +659,33 @@ static _FORCE_INLINE_ void vc_ptrcall(void (*method)(T *, P...), void *p_base, c
 		}                                                                                                                                                         \
 	};
 
+// Amount of float components of the packed array element types the bulk math kernels work on
+// directly, 0 for the others. Vectors only qualify when real_t is float.
+template <class T>
+struct _PackedArrayFloats {
+	enum {
+		COMPONENTS = 0,
+	};
+};
+
+#define PACKED_ARRAY_FLOATS(m_type, m_components)                      \
+	template <>                                                        \
+	struct _PackedArrayFloats<m_type> {                                \
+		static_assert(sizeof(m_type) == m_components * sizeof(float)); \
+		enum {                                                         \
+			COMPONENTS = m_components,                                 \
+		};                                                             \
+	};
+
+#ifndef REAL_T_IS_DOUBLE
+PACKED_ARRAY_FLOATS(float, 1)
+PACKED_ARRAY_FLOATS(Vector2, 2)
+PACKED_ARRAY_FLOATS(Vector3, 3)
+PACKED_ARRAY_FLOATS(Color, 4)
+#endif
+
+#undef PACKED_ARRAY_FLOATS
+
 struct _VariantCall {
 	static String func_PackedByteArray_get_string_from_ascii(PackedByteArray *p_instance) {
 		String s;
@@ -1006,6 +1034,201 @@ struct _VariantCall {
 		return len;
 	}
 
+	// Bulk math on packed arrays. Arrays of floats, and of vectors and colors made of floats,
+	// are processed by the SIMD kernels in PackedArraySIMD. The rest use plain loops.
+
+	template <class T>
+	static _FORCE_INLINE_ float *_packed_array_floats(T *p_ptr) {
+		return reinterpret_cast<float *>(p_ptr);
+	}
+
+	template <class T>
+	static _FORCE_INLINE_ const float *_packed_array_floats(const T *p_ptr) {
+		return reinterpret_cast<const float *>(p_ptr);
+	}
+
+	template <class T>
+	static _FORCE_INLINE_ T _packed_array_clamp(const T &p_value, const T &p_min, const T &p_max) {
+		return p_value.clamp(p_min, p_max);
+	}
+
+	static _FORCE_INLINE_ float _packed_array_clamp(float p_value, float p_min, float p_max) {
+		return CLAMP(p_value, p_min, p_max);
+	}
+
+	template <class T>
+	static void func_packed_array_add_value(Vector<T> *p_instance, const T &p_value) {
+		const int size = p_instance->size();
+		T *w = p_instance->ptrw();
+		if constexpr (_PackedArrayFloats<T>::COMPONENTS > 0) {
+			constexpr int components = _PackedArrayFloats<T>::COMPONENTS;
+			PackedArraySIMD::add_value(_packed_array_floats(w), _packed_array_floats(&p_value), components, size * components);
+		} else {
+			for (int i = 0; i < size; i++) {
+				w[i] += p_value;
+			}
+		}
+	}
+
+	template <class T>
+	static void func_packed_array_scale(Vector<T> *p_instance, double p_factor) {
+		const real_t factor = p_factor;
+		const int size = p_instance->size();
+		T *w = p_instance->ptrw();
+		if constexpr (_PackedArrayFloats<T>::COMPONENTS > 0) {
+			PackedArraySIMD::scale(_packed_array_floats(w), factor, size * _PackedArrayFloats<T>::COMPONENTS);
+		} else {
+			for (int i = 0; i < size; i++) {
+				w[i] *= factor;
+			}
+		}
+	}
+
+	template <class T>
+	static void func_packed_array_add_elements(Vector<T> *p_instance, const Vector<T> &p_array) {
+		const int size = p_instance->size();
+		ERR_FAIL_COND_MSG(p_array.size() != size, "Both arrays must have the same size.");
+		const T *r = p_array.ptr();
+		T *w = p_instance->ptrw();
+		if constexpr (_PackedArrayFloats<T>::COMPONENTS > 0) {
+			PackedArraySIMD::add(_packed_array_floats(w), _packed_array_floats(r), size * _PackedArrayFloats<T>::COMPONENTS);
+		} else {
+			for (int i = 0; i < size; i++) {
+				w[i] += r[i];
+			}
+		}
+	}
+
+	template <class T>
+	static void func_packed_array_multiply_elements(Vector<T> *p_instance, const Vector<T> &p_array) {
+		const int size = p_instance->size();
+		ERR_FAIL_COND_MSG(p_array.size() != size, "Both arrays must have the same size.");
+		const T *r = p_array.ptr();
+		T *w = p_instance->ptrw();
+		if constexpr (_PackedArrayFloats<T>::COMPONENTS > 0) {
+			PackedArraySIMD::multiply(_packed_array_floats(w), _packed_array_floats(r), size * _PackedArrayFloats<T>::COMPONENTS);
+		} else {
+			for (int i = 0; i < size; i++) {
+				w[i] *= r[i];
+			}
+		}
+	}
+
+	template <class T>
+	static void func_packed_array_lerp_elements(Vector<T> *p_instance, const Vector<T> &p_to, double p_weight) {
+		const int size = p_instance->size();
+		ERR_FAIL_COND_MSG(p_to.size() != size, "Both arrays must have the same size.");
+		const real_t weight = p_weight;
+		const T *r = p_to.ptr();
+		T *w = p_instance->ptrw();
+		if constexpr (_PackedArrayFloats<T>::COMPONENTS > 0) {
+			PackedArraySIMD::lerp(_packed_array_floats(w), _packed_array_floats(r), weight, size * _PackedArrayFloats<T>::COMPONENTS);
+		} else {
+			for (int i = 0; i < size; i++) {
+				w[i] = w[i] + (r[i] - w[i]) * weight;
+			}
+		}
+	}
+
+	template <class T>
+	static void func_packed_array_clamp_elements(Vector<T> *p_instance, const T &p_min, const T &p_max) {
+		const int size = p_instance->size();
+		T *w = p_instance->ptrw();
+		if constexpr (_PackedArrayFloats<T>::COMPONENTS > 0) {
+			constexpr int components = _PackedArrayFloats<T>::COMPONENTS;
+			PackedArraySIMD::clamp(_packed_array_floats(w), _packed_array_floats(&p_min), _packed_array_floats(&p_max), components, size * components);
+		} else {
+			for (int i = 0; i < size; i++) {
+				w[i] = _packed_array_clamp(w[i], p_min, p_max);
+			}
+		}
+	}
+
+	template <class T>
+	static T func_packed_array_sum(Vector<T> *p_instance) {
+		// Summed in order, so the result doesn't depend on the vector width.
+		const int size = p_instance->size();
+		const T *r = p_instance->ptr();
+		T sum;
+		for (int i = 0; i < size; i++) {
+			sum += r[i];
+		}
+		return sum;
+	}
+
+	static void func_PackedVector2Array_transform(PackedVector2Array *p_instance, const Transform2D &p_transform) {
+		const int size = p_instance->size();
+		Vector2 *w = p_instance->ptrw();
+		for (int i = 0; i < size; i++) {
+			w[i] = p_transform.xform(w[i]);
+		}
+	}
+
+	static void func_PackedVector3Array_transform(PackedVector3Array *p_instance, const Transform3D &p_transform) {
+		PackedArraySIMD::transform(p_instance->ptrw(), p_instance->size(), p_transform);
+	}
+
+	static PackedFloat32Array func_PackedVector2Array_lengths(PackedVector2Array *p_instance) {
+		const int size = p_instance->size();
+		PackedFloat32Array dest;
+		dest.resize(size);
+		const Vector2 *r = p_instance->ptr();
+		float *w = dest.ptrw();
+		for (int i = 0; i < size; i++) {
+			w[i] = r[i].length();
+		}
+		return dest;
+	}
+
+	static PackedFloat32Array func_PackedVector3Array_lengths(PackedVector3Array *p_instance) {
+		PackedFloat32Array dest;
+		dest.resize(p_instance->size());
+		PackedArraySIMD::lengths(p_instance->ptr(), p_instance->size(), dest.ptrw());
+		return dest;
+	}
+
+	static PackedFloat32Array func_PackedVector2Array_dots(PackedVector2Array *p_instance, const PackedVector2Array &p_array) {
+		const int size = p_instance->size();
+		PackedFloat32Array dest;
+		ERR_FAIL_COND_V_MSG(p_array.size() != size, dest, "Both arrays must have the same size.");
+		dest.resize(size);
+		const Vector2 *a = p_instance->ptr();
+		const Vector2 *b = p_array.ptr();
+		float *w = dest.ptrw();
+		for (int i = 0; i < size; i++) {
+			w[i] = a[i].dot(b[i]);
+		}
+		return dest;
+	}
+
+	static PackedFloat32Array func_PackedVector3Array_dots(PackedVector3Array *p_instance, const PackedVector3Array &p_array) {
+		const int size = p_instance->size();
+		PackedFloat32Array dest;
+		ERR_FAIL_COND_V_MSG(p_array.size() != size, dest, "Both arrays must have the same size.");
+		dest.resize(size);
+		PackedArraySIMD::dots(p_instance->ptr(), p_array.ptr(), size, dest.ptrw());
+		return dest;
+	}
+
+	static double func_PackedFloat32Array_sum(PackedFloat32Array *p_instance) {
+		return PackedArraySIMD::sum(p_instance->ptr(), p_instance->size());
+	}
+
+	static double func_PackedFloat32Array_dot(PackedFloat32Array *p_instance, const PackedFloat32Array &p_array) {
+		ERR_FAIL_COND_V_MSG(p_array.size() != p_instance->size(), 0.0, "Both arrays must have the same size.");
+		return PackedArraySIMD::dot(p_instance->ptr(), p_array.ptr(), p_instance->size());
+	}
+
+	static double func_PackedFloat32Array_min(PackedFloat32Array *p_instance) {
+		ERR_FAIL_COND_V_MSG(p_instance->is_empty(), 0.0, "Can't take the minimum of an empty array.");
+		return PackedArraySIMD::min_value(p_instance->ptr(), p_instance->size());
+	}
+
+	static double func_PackedFloat32Array_max(PackedFloat32Array *p_instance) {
+		ERR_FAIL_COND_V_MSG(p_instance->is_empty(), 0.0, "Can't take the maximum of an empty array.");
+		return PackedArraySIMD::max_value(p_instance->ptr(), p_instance->size());
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -1109,6 +1332,125 @@ typedef OAHashMap<StringName, VariantBuiltInMethodInfo> BuiltinMethodMap;
 static BuiltinMethodMap *builtin_method_info;
 static List<StringName> *builtin_method_names;
 
+// The methods of builtin types are all registered at startup and never change afterwards, so
+// dynamic calls find them through a perfect hash table keyed on the StringName data pointer:
+// every name gets a slot of its own, so a lookup (hit or miss) checks a single slot and
+// compares a single pointer, instead of probing BuiltinMethodMap. Names are first split into
+// buckets, and each bucket has a seed that places all of its names into free slots.
+class BuiltinMethodTable {
+	struct Slot {
+		StringName name;
+		const VariantBuiltInMethodInfo *method = nullptr;
+	};
+
+	struct BucketSizeComparator {
+		const LocalVector<LocalVector<StringName>> *buckets = nullptr;
+		_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+			return (*buckets)[p_a].size() > (*buckets)[p_b].size();
+		}
+	};
+
+	LocalVector<Slot> slots;
+	LocalVector<uint32_t> seeds;
+	uint32_t slot_shift = 63;
+	uint32_t bucket_shift = 63;
+
+	static _FORCE_INLINE_ uint64_t _hash(const StringName &p_name) {
+		return uint64_t(p_name.data_unique_pointer()) * 0x9E3779B97F4A7C15ULL;
+	}
+
+	_FORCE_INLINE_ uint32_t _get_slot(uint64_t p_hash, uint32_t p_seed) const {
+		return ((p_hash ^ p_seed) * 0xC2B2AE3D27D4EB4FULL) >> slot_shift;
+	}
+
+	bool _try_build(const List<StringName> &p_names, BuiltinMethodMap &p_map, uint32_t p_slot_count, uint32_t p_bucket_count) {
+		slot_shift = 64 - get_shift_from_power_of_2(p_slot_count);
+		bucket_shift = 64 - get_shift_from_power_of_2(p_bucket_count);
+		slots.clear();
+		slots.resize(p_slot_count);
+		seeds.clear();
+		seeds.resize(p_bucket_count);
+
+		LocalVector<LocalVector<StringName>> buckets;
+		buckets.resize(p_bucket_count);
+		for (const StringName &E : p_names) {
+			buckets[_hash(E) >> bucket_shift].push_back(E);
+		}
+
+		// Place the biggest buckets first, while there is still plenty of room.
+		LocalVector<uint32_t> order;
+		order.resize(p_bucket_count);
+		for (uint32_t i = 0; i < p_bucket_count; i++) {
+			order[i] = i;
+			seeds[i] = 0;
+		}
+		SortArray<uint32_t, BucketSizeComparator> sorter;
+		sorter.compare.buckets = &buckets;
+		sorter.sort(order.ptr(), order.size());
+
+		LocalVector<uint32_t> placed;
+		for (uint32_t bucket : order) {
+			const LocalVector<StringName> &names = buckets[bucket];
+			if (names.is_empty()) {
+				break;
+			}
+
+			uint32_t seed = 1;
+			for (; seed < 65536; seed++) {
+				placed.clear();
+				for (const StringName &name : names) {
+					uint32_t slot = _get_slot(_hash(name), seed);
+					if (slots[slot].method != nullptr || placed.find(slot) != -1) {
+						break;
+					}
+					placed.push_back(slot);
+				}
+				if (placed.size() == names.size()) {
+					break;
+				}
+			}
+			if (placed.size() != names.size()) {
+				return false;
+			}
+
+			seeds[bucket] = seed;
+			for (uint32_t i = 0; i < names.size(); i++) {
+				slots[placed[i]].name = names[i];
+				slots[placed[i]].method = p_map.lookup_ptr(names[i]);
+			}
+		}
+		return true;
+	}
+
+public:
+	_FORCE_INLINE_ const VariantBuiltInMethodInfo *lookup(const StringName &p_name) const {
+		uint64_t hash = _hash(p_name);
+		const Slot &slot = slots[_get_slot(hash, seeds[hash >> bucket_shift])];
+		return slot.name == p_name ? slot.method : nullptr;
+	}
+
+	// Must be called once all methods are in p_map, which must not change afterwards.
+	void build(const List<StringName> &p_names, BuiltinMethodMap &p_map) {
+		uint32_t count = MAX(p_names.size(), 1);
+		// Keep the table at most half full, with two names per bucket on average.
+		uint32_t slot_count = next_power_of_2(count) * 2;
+		uint32_t bucket_count = MAX(next_power_of_2(count) / 2, 2u);
+		while (!_try_build(p_names, p_map, slot_count, bucket_count)) {
+			slot_count *= 2;
+		}
+	}
+
+	BuiltinMethodTable() {
+		// Empty tables still have a couple of (unused) slots, so lookups don't need to check for them.
+		slots.resize(2);
+		seeds.resize(2);
+		seeds[0] = 0;
+		seeds[1] = 0;
+	}
+};
+
+static BuiltinMethodTable *builtin_method_table;
+
 template <class T>
 static void register_builtin_method(const Vector<String> &p_argnames, const Vector<Variant> &p_def_args) {
 	StringName name = T::get_name();
@@ -1163,7 +1505,7 @@ void Variant::callp(const StringName &p_method, const Variant **p_args, int p_ar
 	} else {
 		r_error.error = Callable::CallError::CALL_OK;
 
-		const VariantBuiltInMethodInfo *imf = builtin_method_info[type].lookup_ptr(p_method);
+		const VariantBuiltInMethodInfo *imf = builtin_method_table[type].lookup(p_method);
 
 		if (!imf) {
 			r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
@@ -1195,7 +1537,7 @@ void Variant::call_const(const StringName &p_method, const Variant **p_args, int
 	} else {
 		r_error.error = Callable::CallError::CALL_OK;
 
-		const VariantBuiltInMethodInfo *imf = builtin_method_info[type].lookup_ptr(p_method);
+		const VariantBuiltInMethodInfo *imf = builtin_method_table[type].lookup(p_method);
 
 		if (!imf) {
 			r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
@@ -1214,7 +1556,7 @@ void Variant::call_const(const StringName &p_method, const Variant **p_args, int
 void Variant::call_static(Variant::Type p_type, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 	r_error.error = Callable::CallError::CALL_OK;
 
-	const VariantBuiltInMethodInfo *imf = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *imf = builtin_method_table[p_type].lookup(p_method);
 
 	if (!imf) {
 		r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
@@ -1239,38 +1581,38 @@ bool Variant::has_method(const StringName &p_method) const {
 		return obj->has_method(p_method);
 	}
 
-	return builtin_method_info[type].has(p_method);
+	return builtin_method_table[type].lookup(p_method) != nullptr;
 }
 
 bool Variant::has_builtin_method(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, false);
-	return builtin_method_info[p_type].has(p_method);
+	return builtin_method_table[p_type].lookup(p_method) != nullptr;
 }
 
 Variant::ValidatedBuiltInMethod Variant::get_validated_builtin_method(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, nullptr);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, nullptr);
 	return method->validated_call;
 }
 
 Variant::PTRBuiltInMethod Variant::get_ptr_builtin_method(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, nullptr);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, nullptr);
 	return method->ptrcall;
 }
 
 int Variant::get_builtin_method_argument_count(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, 0);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, 0);
 	return method->argument_count;
 }
 
 Variant::Type Variant::get_builtin_method_argument_type(Variant::Type p_type, const StringName &p_method, int p_argument) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, Variant::NIL);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, Variant::NIL);
 	ERR_FAIL_INDEX_V(p_argument, method->argument_count, Variant::NIL);
 	return method->get_argument_type(p_argument);
@@ -1278,7 +1620,7 @@ Variant::Type Variant::get_builtin_method_argument_type(Variant::Type p_type, co
 
 String Variant::get_builtin_method_argument_name(Variant::Type p_type, const StringName &p_method, int p_argument) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, String());
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, String());
 #ifdef DEBUG_METHODS_ENABLED
 	ERR_FAIL_INDEX_V(p_argument, method->argument_count, String());
@@ -1290,14 +1632,14 @@ String Variant::get_builtin_method_argument_name(Variant::Type p_type, const Str
 
 Vector<Variant> Variant::get_builtin_method_default_arguments(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, Vector<Variant>());
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, Vector<Variant>());
 	return method->default_arguments;
 }
 
 bool Variant::has_builtin_method_return_value(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, false);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, false);
 	return method->has_return_type;
 }
@@ -1316,35 +1658,35 @@ int Variant::get_builtin_method_count(Variant::Type p_type) {
 
 Variant::Type Variant::get_builtin_method_return_type(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, Variant::NIL);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, Variant::NIL);
 	return method->return_type;
 }
 
 bool Variant::is_builtin_method_const(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, false);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, false);
 	return method->is_const;
 }
 
 bool Variant::is_builtin_method_static(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, false);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, false);
 	return method->is_static;
 }
 
 bool Variant::is_builtin_method_vararg(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, false);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, false);
 	return method->is_vararg;
 }
 
 uint32_t Variant::get_builtin_method_hash(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, 0);
-	const VariantBuiltInMethodInfo *method = builtin_method_info[p_type].lookup_ptr(p_method);
+	const VariantBuiltInMethodInfo *method = builtin_method_table[p_type].lookup(p_method);
 	ERR_FAIL_COND_V(!method, 0);
 	uint32_t hash = hash_murmur3_one_32(method->is_const);
 	hash = hash_murmur3_one_32(method->is_static, hash);
@@ -1615,6 +1957,7 @@ static void _register_variant_builtin_methods() {
 	_VariantCall::enum_data = memnew_arr(_VariantCall::EnumData, Variant::VARIANT_MAX);
 	builtin_method_info = memnew_arr(BuiltinMethodMap, Variant::VARIANT_MAX);
 	builtin_method_names = memnew_arr(List<StringName>, Variant::VARIANT_MAX);
+	builtin_method_table = memnew_arr(BuiltinMethodTable, Variant::VARIANT_MAX);
 
 	/* String */
 
@@ -2367,6 +2710,16 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedFloat32Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, add_value, _VariantCall::func_packed_array_add_value<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, scale, _VariantCall::func_packed_array_scale<float>, sarray("factor"), varray());
+	bind_functionnc(PackedFloat32Array, add_elements, _VariantCall::func_packed_array_add_elements<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_elements, _VariantCall::func_packed_array_multiply_elements<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, lerp_elements, _VariantCall::func_packed_array_lerp_elements<float>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedFloat32Array, clamp_elements, _VariantCall::func_packed_array_clamp_elements<float>, sarray("min", "max"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedFloat32Array_sum, sarray(), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedFloat32Array_min, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedFloat32Array_max, sarray(), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedFloat32Array_dot, sarray("array"), varray());
 
 	/* Float64 Array */
 
@@ -2439,6 +2792,16 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedVector2Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector2Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector2Array, count, sarray("value"), varray());
+	bind_functionnc(PackedVector2Array, add_value, _VariantCall::func_packed_array_add_value<Vector2>, sarray("value"), varray());
+	bind_functionnc(PackedVector2Array, scale, _VariantCall::func_packed_array_scale<Vector2>, sarray("factor"), varray());
+	bind_functionnc(PackedVector2Array, add_elements, _VariantCall::func_packed_array_add_elements<Vector2>, sarray("array"), varray());
+	bind_functionnc(PackedVector2Array, multiply_elements, _VariantCall::func_packed_array_multiply_elements<Vector2>, sarray("array"), varray());
+	bind_functionnc(PackedVector2Array, lerp_elements, _VariantCall::func_packed_array_lerp_elements<Vector2>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedVector2Array, clamp_elements, _VariantCall::func_packed_array_clamp_elements<Vector2>, sarray("min", "max"), varray());
+	bind_function(PackedVector2Array, sum, _VariantCall::func_packed_array_sum<Vector2>, sarray(), varray());
+	bind_functionnc(PackedVector2Array, transform, _VariantCall::func_PackedVector2Array_transform, sarray("transform"), varray());
+	bind_function(PackedVector2Array, lengths, _VariantCall::func_PackedVector2Array_lengths, sarray(), varray());
+	bind_function(PackedVector2Array, dots, _VariantCall::func_PackedVector2Array_dots, sarray("array"), varray());
 
 	/* Vector3 Array */
 
@@ -2463,6 +2826,16 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedVector3Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, add_value, _VariantCall::func_packed_array_add_value<Vector3>, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, scale, _VariantCall::func_packed_array_scale<Vector3>, sarray("factor"), varray());
+	bind_functionnc(PackedVector3Array, add_elements, _VariantCall::func_packed_array_add_elements<Vector3>, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, multiply_elements, _VariantCall::func_packed_array_multiply_elements<Vector3>, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, lerp_elements, _VariantCall::func_packed_array_lerp_elements<Vector3>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedVector3Array, clamp_elements, _VariantCall::func_packed_array_clamp_elements<Vector3>, sarray("min", "max"), varray());
+	bind_function(PackedVector3Array, sum, _VariantCall::func_packed_array_sum<Vector3>, sarray(), varray());
+	bind_functionnc(PackedVector3Array, transform, _VariantCall::func_PackedVector3Array_transform, sarray("transform"), varray());
+	bind_function(PackedVector3Array, lengths, _VariantCall::func_PackedVector3Array_lengths, sarray(), varray());
+	bind_function(PackedVector3Array, dots, _VariantCall::func_PackedVector3Array_dots, sarray("array"), varray());
 
 	/* Color Array */
 
@@ -2487,6 +2860,12 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedColorArray, find, sarray("value", "from"), varray(0));
 	bind_method(PackedColorArray, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedColorArray, count, sarray("value"), varray());
+	bind_functionnc(PackedColorArray, add_value, _VariantCall::func_packed_array_add_value<Color>, sarray("value"), varray());
+	bind_functionnc(PackedColorArray, scale, _VariantCall::func_packed_array_scale<Color>, sarray("factor"), varray());
+	bind_functionnc(PackedColorArray, add_elements, _VariantCall::func_packed_array_add_elements<Color>, sarray("array"), varray());
+	bind_functionnc(PackedColorArray, multiply_elements, _VariantCall::func_packed_array_multiply_elements<Color>, sarray("array"), varray());
+	bind_functionnc(PackedColorArray, lerp_elements, _VariantCall::func_packed_array_lerp_elements<Color>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedColorArray, clamp_elements, _VariantCall::func_packed_array_clamp_elements<Color>, sarray("min", "max"), varray());
 
 	/* Register constants */
 
@@ -2633,10 +3012,15 @@ static void _register_variant_builtin_methods() {
 
 void Variant::_register_variant_methods() {
 	_register_variant_builtin_methods(); //needs to be out due to namespace
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		builtin_method_table[i].build(builtin_method_names[i], builtin_method_info[i]);
+	}
 }
 
 void Variant::_unregister_variant_methods() {
 	//clear methods
+	memdelete_arr(builtin_method_table);
 	memdelete_arr(builtin_method_names);
 	memdelete_arr(builtin_method_info);
 	memdelete_arr(_VariantCall::constant_data);
@@ -35,12 +35,7 @@
 #include "core/os/keyboard.h"
 #include "core/string/string_buffer.h"
 
-char32_t VariantParser::Stream::get_char() {
-	// is within buffer?
-	if (readahead_pointer < readahead_filled) {
-		return readahead_buffer[readahead_pointer++];
-	}
-
+char32_t VariantParser::Stream::_refill_and_get_char() {
 	// attempt to readahead
 	readahead_filled = _read_buffer(readahead_buffer, readahead_enabled ? READAHEAD_SIZE : 1);
 	if (readahead_filled) {
@@ -51,7 +46,7 @@ char32_t VariantParser::Stream::get_char() {
 		eof = true;
 		return 0;
 	}
-	return get_char();
+	return readahead_buffer[readahead_pointer++];
 }
 
 bool VariantParser::Stream::is_eof() const {
@@ -155,6 +150,88 @@ static double stor_fix(const String &p_str) {
 	return -1;
 }
 
+bool VariantParser::_parse_number(Stream *p_stream, char32_t p_char, int64_t &r_int, double &r_float) {
+	StringBuffer<> num;
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+	int reading = READING_INT;
+
+	char32_t c = p_char;
+	bool negative = false;
+	if (c == '-') {
+		num += '-';
+		negative = true;
+		c = p_stream->get_char();
+	}
+
+	bool exp_sign = false;
+	bool exp_beg = false;
+	bool is_float = false;
+	// Integers are accumulated as they are read, falling back to the text only if they may overflow.
+	uint64_t int_value = 0;
+	int int_digits = 0;
+
+	while (true) {
+		switch (reading) {
+			case READING_INT: {
+				if (is_digit(c)) {
+					int_value = int_value * 10 + (c - '0');
+					int_digits++;
+				} else if (c == '.') {
+					reading = READING_DEC;
+					is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+				if (is_digit(c)) {
+				} else if (c == 'e') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+				if (is_digit(c)) {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE) {
+			break;
+		}
+		num += c;
+		c = p_stream->get_char();
+	}
+
+	p_stream->saved = c;
+
+	if (is_float) {
+		r_float = num.as_double();
+	} else if (int_digits <= 18) {
+		r_int = negative ? -int64_t(int_value) : int64_t(int_value);
+	} else {
+		r_int = num.as_int();
+	}
+	return is_float;
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 	bool string_name = false;
 
@@ -272,6 +349,10 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 			}
 			case '"': {
 				String str;
+				// Bytes of UTF-8 streams are collected as is and decoded once at the end.
+				const bool utf8 = p_stream->is_utf8();
+				LocalVector<char> &utf8_str = p_stream->string_buffer;
+				utf8_str.clear();
 				char32_t prev = 0;
 				while (true) {
 					char32_t ch = p_stream->get_char();
@@ -374,7 +455,16 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							r_token.type = TK_ERROR;
 							return ERR_PARSE_ERROR;
 						}
-						str += res;
+						if (!utf8) {
+							str += res;
+						} else if (res < 0x80) {
+							utf8_str.push_back(res);
+						} else {
+							CharString encoded = String(&res, 1).utf8();
+							for (int j = 0; j < encoded.length(); j++) {
+								utf8_str.push_back(encoded[j]);
+							}
+						}
 					} else {
 						if (prev != 0) {
 							r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
@@ -384,7 +474,11 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 						if (ch == '\n') {
 							line++;
 						}
-						str += ch;
+						if (utf8) {
+							utf8_str.push_back(ch);
+						} else {
+							str += ch;
+						}
 					}
 				}
 				if (prev != 0) {
@@ -393,8 +487,8 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					return ERR_PARSE_ERROR;
 				}
 
-				if (p_stream->is_utf8()) {
-					str.parse_utf8(str.ascii(true).get_data());
+				if (utf8 && utf8_str.size()) {
+					str.parse_utf8(utf8_str.ptr(), utf8_str.size());
 				}
 				if (string_name) {
 					r_token.type = TK_STRING_NAME;
@@ -413,78 +507,13 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 
 				if (cchar == '-' || (cchar >= '0' && cchar <= '9')) {
 					//a number
-
-					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					char32_t c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
-					bool is_float = false;
-
-					while (true) {
-						switch (reading) {
-							case READING_INT: {
-								if (is_digit(c)) {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-								if (is_digit(c)) {
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-								if (is_digit(c)) {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE) {
-							break;
-						}
-						num += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
-
+					int64_t int_value;
+					double float_value;
 					r_token.type = TK_NUMBER;
-
-					if (is_float) {
-						r_token.value = num.as_double();
+					if (_parse_number(p_stream, cchar, int_value, float_value)) {
+						r_token.value = float_value;
 					} else {
-						r_token.value = num.as_int();
+						r_token.value = int_value;
 					}
 					return OK;
 				} else if (is_ascii_char(cchar) || is_underscore(cchar)) {
@@ -594,6 +623,103 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 	return OK;
 }
 
+// Skips whitespace and comments, returns the first character after them (or 0 at the end of the stream).
+static char32_t _skip_whitespace(VariantParser::Stream *p_stream, int &line) {
+	char32_t c;
+	if (p_stream->saved) {
+		c = p_stream->saved;
+		p_stream->saved = 0;
+	} else {
+		c = p_stream->get_char();
+	}
+
+	while (true) {
+		if (c == '\n') {
+			line++;
+		} else if (c == ';') {
+			while (c != '\n' && c != 0) {
+				c = p_stream->get_char();
+			}
+			continue;
+		} else if (c == 0 || c > 32) {
+			return c;
+		}
+		c = p_stream->get_char();
+	}
+}
+
+// Same as _parse_construct, but numbers are read straight from the stream instead of going through tokens,
+// which makes large packed array literals much faster to parse.
+template <class T>
+Error VariantParser::_parse_packed_construct(Stream *p_stream, LocalVector<T> &r_construct, int &line, String &r_err_str) {
+	Token token;
+	get_token(p_stream, token, line, r_err_str);
+	if (token.type != TK_PARENTHESIS_OPEN) {
+		r_err_str = "Expected '(' in constructor";
+		return ERR_PARSE_ERROR;
+	}
+
+	bool first = true;
+	while (true) {
+		char32_t c = _skip_whitespace(p_stream, line);
+		if (!first) {
+			if (c == ',') {
+				c = _skip_whitespace(p_stream, line);
+			} else if (c == ')') {
+				break;
+			} else {
+				r_err_str = "Expected ',' or ')' in constructor";
+				return ERR_PARSE_ERROR;
+			}
+		}
+
+		if (first && c == ')') {
+			break;
+		} else if (c == '-' || is_digit(c)) {
+			int64_t int_value;
+			double float_value;
+			if (_parse_number(p_stream, c, int_value, float_value)) {
+				r_construct.push_back(T(float_value));
+			} else {
+				r_construct.push_back(T(int_value));
+			}
+		} else {
+			// Not a plain number (e.g. inf or nan), go through the tokenizer.
+			p_stream->saved = c;
+			get_token(p_stream, token, line, r_err_str);
+			double real = token.type == TK_IDENTIFIER ? stor_fix(token.value) : -1;
+			if (real == -1) {
+				r_err_str = "Expected float in constructor";
+				return ERR_PARSE_ERROR;
+			}
+			r_construct.push_back(T(real));
+		}
+		first = false;
+	}
+
+	return OK;
+}
+
+// Parses a packed array literal whose elements are made of one or more values of type T.
+template <class T, class E>
+Error VariantParser::_parse_packed_array(Stream *p_stream, Vector<E> &r_array, int &line, String &r_err_str) {
+	static_assert(sizeof(E) % sizeof(T) == 0);
+	const uint32_t components = sizeof(E) / sizeof(T);
+
+	LocalVector<T> values;
+	Error err = _parse_packed_construct<T>(p_stream, values, line, r_err_str);
+	if (err) {
+		return err;
+	}
+
+	// Incomplete trailing elements are ignored.
+	r_array.resize(values.size() / components);
+	if (r_array.size()) {
+		memcpy((void *)r_array.ptrw(), values.ptr(), r_array.size() * sizeof(E));
+	}
+	return OK;
+}
+
 Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream, int &line, String &r_err_str, ResourceParser *p_res_parser) {
 	if (token.type == TK_CURLY_BRACKET_OPEN) {
 		Dictionary d;
@@ -1109,94 +1235,44 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 			value = array;
 		} else if (id == "PackedByteArray" || id == "PoolByteArray" || id == "ByteArray") {
-			Vector<uint8_t> args;
-			Error err = _parse_construct<uint8_t>(p_stream, args, line, r_err_str);
+			Vector<uint8_t> arr;
+			Error err = _parse_packed_array<uint8_t>(p_stream, arr, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<uint8_t> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				uint8_t *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
 			value = arr;
 		} else if (id == "PackedInt32Array" || id == "PackedIntArray" || id == "PoolIntArray" || id == "IntArray") {
-			Vector<int32_t> args;
-			Error err = _parse_construct<int32_t>(p_stream, args, line, r_err_str);
+			Vector<int32_t> arr;
+			Error err = _parse_packed_array<int32_t>(p_stream, arr, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<int32_t> arr;
-			{
-				int32_t len = args.size();
-				arr.resize(len);
-				int32_t *w = arr.ptrw();
-				for (int32_t i = 0; i < len; i++) {
-					w[i] = int32_t(args[i]);
-				}
-			}
-
 			value = arr;
 		} else if (id == "PackedInt64Array") {
-			Vector<int64_t> args;
-			Error err = _parse_construct<int64_t>(p_stream, args, line, r_err_str);
+			Vector<int64_t> arr;
+			Error err = _parse_packed_array<int64_t>(p_stream, arr, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<int64_t> arr;
-			{
-				int64_t len = args.size();
-				arr.resize(len);
-				int64_t *w = arr.ptrw();
-				for (int64_t i = 0; i < len; i++) {
-					w[i] = int64_t(args[i]);
-				}
-			}
-
 			value = arr;
 		} else if (id == "PackedFloat32Array" || id == "PackedRealArray" || id == "PoolRealArray" || id == "FloatArray") {
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<float> arr;
+			Error err = _parse_packed_array<float>(p_stream, arr, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<float> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				float *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
 			value = arr;
 		} else if (id == "PackedFloat64Array") {
-			Vector<double> args;
-			Error err = _parse_construct<double>(p_stream, args, line, r_err_str);
+			Vector<double> arr;
+			Error err = _parse_packed_array<double>(p_stream, arr, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<double> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				double *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
 			value = arr;
 		} else if (id == "PackedStringArray" || id == "PoolStringArray" || id == "StringArray") {
 			get_token(p_stream, token, line, r_err_str);
@@ -1245,58 +1321,28 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 			value = arr;
 		} else if (id == "PackedVector2Array" || id == "PoolVector2Array" || id == "Vector2Array") {
-			Vector<real_t> args;
-			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
+			Vector<Vector2> arr;
+			Error err = _parse_packed_array<real_t>(p_stream, arr, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<Vector2> arr;
-			{
-				int len = args.size() / 2;
-				arr.resize(len);
-				Vector2 *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = Vector2(args[i * 2 + 0], args[i * 2 + 1]);
-				}
-			}
-
 			value = arr;
 		} else if (id == "PackedVector3Array" || id == "PoolVector3Array" || id == "Vector3Array") {
-			Vector<real_t> args;
-			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
+			Vector<Vector3> arr;
+			Error err = _parse_packed_array<real_t>(p_stream, arr, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<Vector3> arr;
-			{
-				int len = args.size() / 3;
-				arr.resize(len);
-				Vector3 *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = Vector3(args[i * 3 + 0], args[i * 3 + 1], args[i * 3 + 2]);
-				}
-			}
-
 			value = arr;
 		} else if (id == "PackedColorArray" || id == "PoolColorArray" || id == "ColorArray") {
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<Color> arr;
+			Error err = _parse_packed_array<float>(p_stream, arr, line, r_err_str);
 			if (err) {
 				return err;
 			}
 
-			Vector<Color> arr;
-			{
-				int len = args.size() / 4;
-				arr.resize(len);
-				Color *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = Color(args[i * 4 + 0], args[i * 4 + 1], args[i * 4 + 2], args[i * 4 + 3]);
-				}
-			}
-
 			value = arr;
 		} else {
 			r_err_str = "Unexpected identifier: '" + id + "'.";
@@ -33,6 +33,7 @@
 
 #include "core/io/file_access.h"
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 
 class VariantParser {
@@ -50,10 +51,19 @@ public:
 		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) = 0;
 		virtual bool _is_eof() const = 0;
 
+		char32_t _refill_and_get_char();
+
 	public:
 		char32_t saved = 0;
-
-		char32_t get_char();
+		LocalVector<char> string_buffer; // Reused by the tokenizer to collect the UTF-8 bytes of strings.
+
+		_FORCE_INLINE_ char32_t get_char() {
+			// is within buffer?
+			if (likely(readahead_pointer < readahead_filled)) {
+				return readahead_buffer[readahead_pointer++];
+			}
+			return _refill_and_get_char();
+		}
 		virtual bool is_utf8() const = 0;
 		bool is_eof() const;
 
@@ -141,6 +151,11 @@ private:
 
 	template <class T>
 	static Error _parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str);
+	template <class T>
+	static Error _parse_packed_construct(Stream *p_stream, LocalVector<T> &r_construct, int &line, String &r_err_str);
+	template <class T, class E>
+	static Error _parse_packed_array(Stream *p_stream, Vector<E> &r_array, int &line, String &r_err_str);
+	static bool _parse_number(Stream *p_stream, char32_t p_char, int64_t &r_int, double &r_float);
 	static Error _parse_enginecfg(Stream *p_stream, Vector<String> &strings, int &line, String &r_err_str);
 	static Error _parse_dictionary(Dictionary &object, Stream *p_stream, int &line, String &r_err_str, ResourceParser *p_res_parser = nullptr);
 	static Error _parse_array(Array &array, Stream *p_stream, int &line, String &r_err_str, ResourceParser *p_res_parser = nullptr);
@@ -43,6 +43,8 @@ typedef void (*CloseNotificationFunc)(const String &p_file, int p_flags);
 class FileAccessUnix : public FileAccess {
 	FILE *f = nullptr;
 	int flags = 0;
+	uint8_t *mapped_data = nullptr;
+	uint64_t mapped_length = 0;
 	void check_errors() const;
 	mutable Error last_error = OK;
 	String save_path;
@@ -70,6 +72,8 @@ public:
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
 
+	virtual const uint8_t *map_memory() override;
+
 	virtual Error get_error() const override; ///< get last error
 
 	virtual void flush() override;
@@ -1564,7 +1564,27 @@ void EditorFileSystem::_update_script_classes() {
 		}
 	}
 
-	// Parse documentation second, as it requires the class names to be correct and registered
+	// Parse documentation second, as it requires the class names to be correct and registered.
+	// Every script gets loaded for it, so let the languages compile them as a batch first.
+	for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+		ScriptLanguage *lang = ScriptServer::get_language(i);
+		if (!lang->supports_documentation()) {
+			continue;
+		}
+
+		Vector<String> lang_paths;
+		for (const String &path : update_script_paths) {
+			int index = -1;
+			EditorFileSystemDirectory *efd = find_file(path, &index);
+			if (efd && index >= 0 && efd->files[index]->type == lang->get_type()) {
+				lang_paths.push_back(path);
+			}
+		}
+		if (!lang_paths.is_empty()) {
+			lang->compile_scripts(lang_paths);
+		}
+	}
+
 	for (const String &path : update_script_paths) {
 		int index = -1;
 		EditorFileSystemDirectory *efd = find_file(path, &index);
@@ -48,6 +48,7 @@
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_allocator.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/register_core_types.h"
@@ -2226,6 +2227,7 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	ResourceLoader::load_translation_remaps(); //load remaps for resources
 
 	ResourceLoader::load_path_remaps();
+	ResourceLoader::set_share_subresources(!Engine::get_singleton()->is_editor_hint() && bool(GLOBAL_DEF_RST("application/run/share_identical_subresources", false)));
 
 	MAIN_PRINT("Main: Load TextServer");
 
@@ -3067,6 +3069,9 @@ bool Main::iteration() {
 
 	iterating++;
 
+	// Reclaim all the scratch memory allocated during the previous frame.
+	FrameAllocator::next_frame();
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -100,6 +100,9 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MEMORY_FRAME_ARENA,
+		MEMORY_FRAME_ARENA_MAX,
+		MEMORY_FRAME_ARENA_RESERVED,
 		MONITOR_MAX
 	};
 
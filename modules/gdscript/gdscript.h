@@ -39,6 +39,7 @@
 #include "core/object/script_language.h"
 #include "core/templates/rb_set.h"
 #include "gdscript_function.h"
+#include "gdscript_sampling_profiler.h"
 
 class GDScriptNativeClass : public RefCounted {
 	GDCLASS(GDScriptNativeClass, RefCounted);
@@ -85,6 +86,7 @@ class GDScript : public Script {
 	friend class GDScriptCompiler;
 	friend class GDScriptLanguage;
 	friend struct GDScriptUtilityFunctionsDefinitions;
+	friend struct GDScriptInlineCache;
 
 	Ref<GDScriptNativeClass> native;
 	Ref<GDScript> base;
@@ -138,6 +140,7 @@ class GDScript : public Script {
 	bool clearing = false;
 	//exported members
 	String source;
+	Vector<uint8_t> binary_tokens;
 	String path;
 	String name;
 	String fully_qualified_name;
@@ -251,6 +254,8 @@ public:
 	virtual void set_path(const String &p_path, bool p_take_over = false) override;
 	String get_script_path() const;
 	Error load_source_code(const String &p_path);
+	void set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens);
+	const Vector<uint8_t> &get_binary_tokens_source() const;
 
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
 
@@ -292,6 +297,7 @@ class GDScriptInstance : public ScriptInstance {
 	friend class GDScriptCompiler;
 	friend class GDScriptCache;
 	friend struct GDScriptUtilityFunctionsDefinitions;
+	friend struct GDScriptInlineCache;
 
 	ObjectID owner_id;
 	Object *owner = nullptr;
@@ -377,6 +383,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	SelfList<GDScriptFunction>::List function_list;
 	bool profiling;
 	uint64_t script_frame_time;
+	Ref<GDScriptSamplingProfiler> sampling_profiler;
 
 	HashMap<String, ObjectID> orphan_subclasses;
 
@@ -517,6 +524,7 @@ public:
 
 	virtual void reload_all_scripts() override;
 	virtual void reload_tool_script(const Ref<Script> &p_script, bool p_soft_reload) override;
+	virtual void compile_scripts(const Vector<String> &p_paths) override;
 
 	virtual void frame() override;
 
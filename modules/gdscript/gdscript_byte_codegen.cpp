@@ -399,6 +399,14 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_caches_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptInlineCache, inline_caches_count);
+		function->_inline_caches_count = inline_caches_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
@@ -591,6 +599,35 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		// Arithmetic and comparisons between two ints or two floats are done inline by the VM.
+		if (p_left_operand.type.builtin_type == p_right_operand.type.builtin_type && (p_left_operand.type.builtin_type == Variant::INT || p_left_operand.type.builtin_type == Variant::FLOAT)) {
+			bool is_float = p_left_operand.type.builtin_type == Variant::FLOAT;
+			switch (p_operator) {
+				case Variant::OP_DIVIDE:
+					if (!is_float) {
+						break;
+					}
+					[[fallthrough]];
+				case Variant::OP_ADD:
+				case Variant::OP_SUBTRACT:
+				case Variant::OP_MULTIPLY:
+				case Variant::OP_EQUAL:
+				case Variant::OP_NOT_EQUAL:
+				case Variant::OP_LESS:
+				case Variant::OP_LESS_EQUAL:
+				case Variant::OP_GREATER:
+				case Variant::OP_GREATER_EQUAL:
+					append_opcode(is_float ? GDScriptFunction::OPCODE_OPERATOR_FLOAT : GDScriptFunction::OPCODE_OPERATOR_INT);
+					append(p_left_operand);
+					append(p_right_operand);
+					append(p_target);
+					append(p_operator);
+					return;
+				default:
+					break;
+			}
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -749,10 +786,37 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 	ternary_result.pop_back();
 }
 
+GDScriptFunction::Opcode GDScriptByteCodeGenerator::get_indexed_packed_array_opcode(Variant::Type p_type, bool p_set) {
+	// Numeric packed arrays are indexed directly by the VM, others go through the validated indexed setters and getters.
+	switch (p_type) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY;
+		case Variant::PACKED_INT32_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT32_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT32_ARRAY;
+		case Variant::PACKED_INT64_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT64_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT64_ARRAY;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY;
+		default:
+			return GDScriptFunction::OPCODE_END;
+	}
+}
+
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target)) {
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
+			GDScriptFunction::Opcode packed_opcode = get_indexed_packed_array_opcode(p_target.type.builtin_type, true);
+			if (packed_opcode != GDScriptFunction::OPCODE_END) {
+				append_opcode(packed_opcode);
+				append(p_target);
+				append(p_index);
+				append(p_source);
+				return;
+			}
+
 			// Use indexed setter instead.
 			Variant::ValidatedIndexedSetter setter = Variant::get_member_validated_indexed_setter(p_target.type.builtin_type);
 			append_opcode(GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED);
@@ -781,6 +845,15 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_source)) {
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
+			GDScriptFunction::Opcode packed_opcode = get_indexed_packed_array_opcode(p_source.type.builtin_type, false);
+			if (packed_opcode != GDScriptFunction::OPCODE_END) {
+				append_opcode(packed_opcode);
+				append(p_source);
+				append(p_index);
+				append(p_target);
+				return;
+			}
+
 			// Use indexed getter instead.
 			Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(p_source.type.builtin_type);
 			append_opcode(GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED);
@@ -822,6 +895,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -840,6 +914,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1011,6 +1086,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1036,6 +1112,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1284,6 +1361,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1297,6 +1375,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1310,6 +1389,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1528,6 +1608,19 @@ void GDScriptByteCodeGenerator::write_for() {
 				case Variant::ARRAY:
 					begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY;
 					iterate_opcode = GDScriptFunction::OPCODE_ITERATE_ARRAY;
+					// Typed loop variable over an array of the same type.
+					if (container.type.has_container_element_type() && iterator.type.has_type && iterator.type.kind == GDScriptDataType::BUILTIN) {
+						GDScriptDataType element_type = container.type.get_container_element_type();
+						if (element_type.kind == GDScriptDataType::BUILTIN && element_type.builtin_type == iterator.type.builtin_type) {
+							if (element_type.builtin_type == Variant::INT) {
+								begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY_INT;
+								iterate_opcode = GDScriptFunction::OPCODE_ITERATE_ARRAY_INT;
+							} else if (element_type.builtin_type == Variant::FLOAT) {
+								begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY_FLOAT;
+								iterate_opcode = GDScriptFunction::OPCODE_ITERATE_ARRAY_FLOAT;
+							}
+						}
+					}
 					break;
 				case Variant::PACKED_BYTE_ARRAY:
 					begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY;
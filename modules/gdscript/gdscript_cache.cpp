@@ -31,6 +31,8 @@
 #include "gdscript_cache.h"
 
 #include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
@@ -66,10 +68,22 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 
 	while (p_new_status > status) {
 		switch (status) {
-			case EMPTY:
+			case EMPTY: {
 				status = PARSED;
-				result = parser->parse(GDScriptCache::get_source_code(path), path, false);
-				break;
+				String remapped_path = ResourceLoader::path_remap(path);
+				if (remapped_path.get_extension().to_lower() == "gdc") {
+					result = parser->parse_binary(GDScriptCache::get_binary_tokens(remapped_path), path);
+					break;
+				}
+				String source = GDScriptCache::get_source_code(path);
+				GDScriptParser *preparsed = GDScriptCache::take_preparsed_script(path, source);
+				if (preparsed != nullptr) {
+					memdelete(parser);
+					parser = preparsed;
+				} else {
+					result = parser->parse(source, path, false);
+				}
+			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
 				Error inheritance_result = get_analyzer()->resolve_inheritance();
@@ -186,6 +200,11 @@ void GDScriptCache::remove_script(const String &p_path) {
 		singleton->parser_map.erase(p_path);
 	}
 
+	if (singleton->preparsed_scripts.has(p_path)) {
+		_free_preparsed_script(singleton->preparsed_scripts[p_path]);
+		singleton->preparsed_scripts.erase(p_path);
+	}
+
 	singleton->dependencies.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
@@ -204,7 +223,8 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 			return ref;
 		}
 	} else {
-		if (!FileAccess::exists(p_path)) {
+		// Exported projects may only have the pre-tokenized script the path is remapped to.
+		if (!FileAccess::exists(ResourceLoader::path_remap(p_path))) {
 			r_error = ERR_FILE_NOT_FOUND;
 			return ref;
 		}
@@ -238,6 +258,20 @@ String GDScriptCache::get_source_code(const String &p_path) {
 	return source;
 }
 
+Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
+	Vector<uint8_t> buffer;
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(err, buffer, "Failed to open binary GDScript file '" + p_path + "'.");
+
+	uint64_t len = f->get_length();
+	buffer.resize(len);
+	uint64_t read = f->get_buffer(buffer.ptrw(), buffer.size());
+	ERR_FAIL_COND_V_MSG(read != len, Vector<uint8_t>(), "Failed to read binary GDScript file '" + p_path + "'.");
+
+	return buffer;
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 	if (!p_owner.is_empty()) {
@@ -253,7 +287,13 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 	Ref<GDScript> script;
 	script.instantiate();
 	script->set_path(p_path, true);
-	script->load_source_code(p_path);
+	// Exported projects remap scripts to their pre-tokenized form, the source isn't exported then.
+	String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		script->set_binary_tokens_source(get_binary_tokens(remapped_path));
+	} else {
+		script->load_source_code(p_path);
+	}
 
 	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
@@ -342,6 +382,166 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 	return err;
 }
 
+void GDScriptCache::_free_preparsed_script(PreparsedScript &p_preparsed) {
+	for (GDScriptParser *parser : p_preparsed.parsers) {
+		memdelete(parser);
+	}
+	p_preparsed.parsers.clear();
+}
+
+GDScriptParser *GDScriptCache::take_preparsed_script(const String &p_path, const String &p_source_code) {
+	if (singleton == nullptr || p_path.is_empty()) {
+		return nullptr;
+	}
+
+	MutexLock lock(singleton->mutex);
+
+	HashMap<String, PreparsedScript>::Iterator E = singleton->preparsed_scripts.find(p_path);
+	if (!E) {
+		return nullptr;
+	}
+
+	GDScriptParser *parser = nullptr;
+	if (E->value.source == p_source_code && !E->value.parsers.is_empty()) {
+		parser = E->value.parsers[E->value.parsers.size() - 1];
+		E->value.parsers.resize(E->value.parsers.size() - 1);
+	}
+
+	// The source code changed since it was parsed, or there is nothing left to take.
+	if (parser == nullptr || E->value.parsers.is_empty()) {
+		_free_preparsed_script(E->value);
+		singleton->preparsed_scripts.remove(E);
+	}
+
+	return parser;
+}
+
+struct GDScriptBatchParse {
+	LocalVector<String> paths;
+	LocalVector<String> sources;
+	// Two parsers per script, see GDScriptCache::PreparsedScript.
+	LocalVector<GDScriptParser *> parsers;
+};
+
+void GDScriptCache::_parse_script_task(void *p_userdata, uint32_t p_index) {
+	GDScriptBatchParse *batch = (GDScriptBatchParse *)p_userdata;
+	const String &path = batch->paths[p_index];
+
+	String source = get_source_code(path);
+	if (source.is_empty()) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < 2; i++) {
+		GDScriptParser *parser = memnew(GDScriptParser);
+		if (parser->parse(source, path, false) != OK) {
+			// Errors are reported when the script gets parsed again on load.
+			memdelete(parser);
+			return;
+		}
+		batch->parsers[p_index * 2 + i] = parser;
+	}
+	batch->sources[p_index] = source;
+}
+
+Error GDScriptCache::compile_scripts(const Vector<String> &p_paths) {
+	GDScriptBatchParse batch;
+	{
+		MutexLock lock(singleton->mutex);
+		for (const String &path : p_paths) {
+			if (singleton->full_gdscript_cache.has(path) || singleton->shallow_gdscript_cache.has(path) || singleton->parser_map.has(path) || singleton->preparsed_scripts.has(path) || ResourceCache::has(path)) {
+				continue;
+			}
+			batch.paths.push_back(path);
+		}
+	}
+
+	if (batch.paths.is_empty()) {
+		return OK;
+	}
+
+	batch.sources.resize(batch.paths.size());
+	batch.parsers.resize(batch.paths.size() * 2);
+	for (GDScriptParser *&parser : batch.parsers) {
+		parser = nullptr;
+	}
+
+	// Parsing only needs the source code, so the scripts are parsed concurrently. Analysis resolves
+	// into the parse trees of other scripts and loads preloaded resources, so it stays serial below.
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&GDScriptCache::_parse_script_task, &batch, batch.paths.size(), -1, true, SNAME("GDScriptParse"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	MutexLock lock(singleton->mutex);
+
+	HashSet<String> batch_paths;
+	for (const String &path : batch.paths) {
+		batch_paths.insert(path);
+	}
+
+	HashMap<String, String> bases;
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		if (batch.parsers[i * 2] == nullptr) {
+			continue;
+		}
+		const String &path = batch.paths[i];
+
+		const GDScriptParser::ClassNode *tree = batch.parsers[i * 2]->get_tree();
+		String base;
+		if (!tree->extends_path.is_empty()) {
+			base = tree->extends_path;
+			if (base.is_relative_path()) {
+				base = path.get_base_dir().path_join(base).simplify_path();
+			}
+		} else if (!tree->extends.is_empty() && ScriptServer::is_global_class(tree->extends[0])) {
+			base = ScriptServer::get_global_class_path(tree->extends[0]);
+		}
+		if (batch_paths.has(base)) {
+			bases[path] = base;
+		}
+
+		PreparsedScript &preparsed = singleton->preparsed_scripts[path];
+		preparsed.source = batch.sources[i];
+		preparsed.parsers.push_back(batch.parsers[i * 2]);
+		preparsed.parsers.push_back(batch.parsers[i * 2 + 1]);
+	}
+
+	// Compile base scripts before the scripts inheriting from them.
+	LocalVector<String> order;
+	HashSet<String> visited;
+	for (const String &path : batch.paths) {
+		LocalVector<String> chain;
+		String current = path;
+		while (!current.is_empty() && !visited.has(current)) {
+			visited.insert(current);
+			chain.push_back(current);
+			HashMap<String, String>::Iterator E = bases.find(current);
+			current = E ? E->value : String();
+		}
+		for (int i = int(chain.size()) - 1; i >= 0; i--) {
+			order.push_back(chain[i]);
+		}
+	}
+
+	Error err = OK;
+	for (const String &path : order) {
+		Error this_err = OK;
+		get_full_script(path, this_err);
+		if (this_err != OK && err == OK) {
+			err = this_err;
+		}
+	}
+
+	// Drop what wasn't taken, e.g. for scripts another thread loaded while these were being parsed.
+	for (const String &path : batch.paths) {
+		if (singleton->preparsed_scripts.has(path)) {
+			_free_preparsed_script(singleton->preparsed_scripts[path]);
+			singleton->preparsed_scripts.erase(path);
+		}
+	}
+
+	return err;
+}
+
 Ref<PackedScene> GDScriptCache::get_packed_scene(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -415,6 +615,11 @@ void GDScriptCache::clear() {
 			E->clear();
 	}
 
+	for (KeyValue<String, PreparsedScript> &E : singleton->preparsed_scripts) {
+		_free_preparsed_script(E.value);
+	}
+	singleton->preparsed_scripts.clear();
+
 	singleton->packed_scene_dependencies.clear();
 	singleton->packed_scene_cache.clear();
 
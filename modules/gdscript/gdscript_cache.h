@@ -35,6 +35,7 @@
 #include "core/os/mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 #include "gdscript.h"
 #include "scene/resources/packed_scene.h"
 
@@ -82,6 +83,14 @@ class GDScriptCache {
 	HashMap<String, Ref<PackedScene>> packed_scene_cache;
 	HashMap<String, HashSet<String>> packed_scene_dependencies;
 
+	// Scripts parsed ahead of time by compile_scripts(), waiting to be taken by
+	// the parser reference and by GDScript::reload(), which both parse the source.
+	struct PreparsedScript {
+		String source;
+		LocalVector<GDScriptParser *> parsers;
+	};
+	HashMap<String, PreparsedScript> preparsed_scripts;
+
 	friend class GDScript;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
@@ -92,15 +101,21 @@ class GDScriptCache {
 
 	Mutex mutex;
 
+	static void _free_preparsed_script(PreparsedScript &p_preparsed);
+	static void _parse_script_task(void *p_userdata, uint32_t p_index);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
 	static String get_source_code(const String &p_path);
+	static Vector<uint8_t> get_binary_tokens(const String &p_path);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
 	static Error finish_compiling(const String &p_owner);
+	static GDScriptParser *take_preparsed_script(const String &p_path, const String &p_source_code);
+	static Error compile_scripts(const Vector<String> &p_paths);
 
 	static Ref<PackedScene> get_packed_scene(const String &p_path, Error &r_error, const String &p_owner = "");
 	static void clear_unreferenced_packed_scenes();
@@ -33,6 +33,7 @@
 #include "gdscript.h"
 #include "gdscript_byte_codegen.h"
 #include "gdscript_cache.h"
+#include "gdscript_lambda_callable.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/config/engine.h"
@@ -1221,6 +1222,11 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 				return GDScriptCodeGenerator::Address();
 			}
 
+			if (captures.is_empty() && !lambda->use_self) {
+				// Nothing in the callable depends on the evaluation, so it's shared while any copy of it is alive.
+				function->shares_lambda_callable = true;
+			}
+
 			gen->write_lambda(result, function, captures, lambda->use_self);
 
 			for (int i = 0; i < captures.size(); i++) {
@@ -2696,6 +2702,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 
 	source = p_script->get_path();
 
+	// Member indices and functions of these scripts are about to change.
+	GDScriptInlineCache::invalidate_all();
+
 	// Create scripts for subclasses beforehand so they can be referenced
 	make_scripts(p_script, root, p_keep_state);
 
@@ -2715,6 +2724,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	p_script->_update_doc();
 #endif
 
+	// Drop anything cached while the class was being built.
+	GDScriptInlineCache::invalidate_all();
+
 	return GDScriptCache::finish_compiling(main_script->get_path());
 }
 
@@ -135,6 +135,20 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_INT:
+			case OPCODE_OPERATOR_FLOAT: {
+				text += _code_ptr[ip] == OPCODE_OPERATOR_INT ? "int operator " : "float operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += Variant::get_operator_name(Variant::Operator(_code_ptr[ip + 4]));
+				text += " ";
+				text += DADDR(2);
+
+				incr += 5;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -251,6 +265,37 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_INDEXED_PACKED_ARRAY(m_type) \
+	case OPCODE_SET_INDEXED_PACKED_##m_type: {   \
+		text += "set indexed (typed ";           \
+		text += #m_type;                         \
+		text += ") ";                            \
+		text += DADDR(1);                        \
+		text += "[";                             \
+		text += DADDR(2);                        \
+		text += "] = ";                          \
+		text += DADDR(3);                        \
+		incr += 4;                               \
+	} break;                                     \
+	case OPCODE_GET_INDEXED_PACKED_##m_type: {   \
+		text += "get indexed (typed ";           \
+		text += #m_type;                         \
+		text += ") ";                            \
+		text += DADDR(3);                        \
+		text += " = ";                           \
+		text += DADDR(1);                        \
+		text += "[";                             \
+		text += DADDR(2);                        \
+		text += "]";                             \
+		incr += 4;                               \
+	} break
+
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(BYTE_ARRAY);
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(INT32_ARRAY);
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(INT64_ARRAY);
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(FLOAT32_ARRAY);
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(FLOAT64_ARRAY);
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -259,7 +304,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -280,7 +325,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -551,7 +596,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -988,6 +1033,8 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 	m_macro(STRING);                       \
 	m_macro(DICTIONARY);                   \
 	m_macro(ARRAY);                        \
+	m_macro(ARRAY_INT);                    \
+	m_macro(ARRAY_FLOAT);                  \
 	m_macro(PACKED_BYTE_ARRAY);            \
 	m_macro(PACKED_INT32_ARRAY);           \
 	m_macro(PACKED_INT64_ARRAY);           \
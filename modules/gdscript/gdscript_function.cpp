@@ -30,7 +30,10 @@
 
 #include "gdscript_function.h"
 
+#include "core/config/engine.h"
+#include "core/core_string_names.h"
 #include "gdscript.h"
+#include "gdscript_lambda_callable.h"
 
 const int *GDScriptFunction::get_code() const {
 	return _code_ptr;
@@ -150,11 +153,21 @@ GDScriptFunction::GDScriptFunction() {
 
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
+	GDScriptInlineCache::invalidate_all();
+
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
 
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
 
+	if (shares_lambda_callable) {
+		// The callable keeps the script alive, but a reload frees its functions anyway.
+		GDScriptLambdaCallable::clear_shared(this);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
@@ -170,6 +183,400 @@ GDScriptFunction::~GDScriptFunction() {
 
 /////////////////////
 
+SafeNumeric<uint32_t> GDScriptInlineCache::epoch;
+
+bool GDScriptInlineCache::_get_receiver(Object *p_object, GDScriptInstance *&r_instance, const GDScript *&r_script) {
+	ScriptInstance *si = p_object->get_script_instance();
+	if (!si) {
+		r_instance = nullptr;
+		r_script = nullptr;
+		return true;
+	}
+	if (si->is_placeholder() || si->get_language() != GDScriptLanguage::get_singleton()) {
+		// Other script instances resolve names their own way, don't cache them.
+		return false;
+	}
+	r_instance = static_cast<GDScriptInstance *>(si);
+	r_script = r_instance->script.ptr();
+	return true;
+}
+
+GDScriptFunction *GDScriptInlineCache::_find_function(const GDScript *p_script, const StringName &p_name) {
+	const GDScript *sptr = p_script;
+	while (sptr) {
+		HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+		if (E) {
+			return E->value;
+		}
+		sptr = sptr->_base;
+	}
+	return nullptr;
+}
+
+bool GDScriptInlineCache::_script_handles_property(const GDScript *p_script, const StringName &p_name, bool p_get) {
+	// Same lookups as GDScriptInstance::get() and set(), which run before the native ones.
+	if (p_script->member_indices.has(p_name)) {
+		return true;
+	}
+	const StringName &fallback = p_get ? GDScriptLanguage::get_singleton()->strings._get : GDScriptLanguage::get_singleton()->strings._set;
+	const GDScript *sptr = p_script;
+	while (sptr) {
+		if (sptr->member_functions.has(fallback)) {
+			return true;
+		}
+		if (p_get && (sptr->constants.has(p_name) || sptr->_signals.has(p_name) || sptr->member_functions.has(p_name))) {
+			return true;
+		}
+		sptr = sptr->_base;
+	}
+	return false;
+}
+
+GDScriptInlineCache::Entry *GDScriptInlineCache::_resolve_member(const GDScript *p_script, const StringName &p_name, bool p_get) {
+	HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = p_script->member_indices.find(p_name);
+	if (!E) {
+		return nullptr;
+	}
+
+	const GDScript::MemberInfo &member = E->value;
+	const StringName &accessor = p_get ? member.getter : member.setter;
+	GDScriptFunction *function = nullptr;
+	if (accessor) {
+		function = _find_function(p_script, accessor);
+		if (!function) {
+			return nullptr;
+		}
+	}
+
+	Entry *entry = memnew(Entry);
+	entry->script = p_script;
+	entry->kind = function ? MEMBER_ACCESSOR : MEMBER;
+	entry->index = member.index;
+	entry->member_type = &member.data_type;
+	entry->function = function;
+	return entry;
+}
+
+GDScriptInlineCache::Entry *GDScriptInlineCache::_resolve_native_property(Object *p_object, const GDScript *p_script, const StringName &p_name, bool p_get) {
+	if (p_script && _script_handles_property(p_script, p_name, p_get)) {
+		return nullptr;
+	}
+
+	const StringName &class_name = p_object->get_class_name();
+	int index = -1;
+	MethodBind *method = ClassDB::get_property_accessor(class_name, p_name, !p_get, &index);
+	if (!method) {
+		return nullptr;
+	}
+
+	ClassDB::APIType api = ClassDB::get_api_type(class_name);
+	if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+		// Extension instances get a chance to handle the property before ClassDB.
+		return nullptr;
+	}
+	if (p_script && _find_function(p_script, method->get_name())) {
+		// The accessor may be called by name, which would reach the script first.
+		return nullptr;
+	}
+
+	Entry *entry = memnew(Entry);
+	entry->script = p_script;
+	entry->native_class = class_name.data_unique_pointer();
+	entry->kind = NATIVE_METHOD;
+	entry->index = index;
+	entry->method = method;
+	return entry;
+}
+
+GDScriptInlineCache::Entry *GDScriptInlineCache::_resolve_call(Object *p_object, const GDScript *p_script, const StringName &p_name) {
+	if (p_name == CoreStringNames::get_singleton()->_free) {
+		return nullptr;
+	}
+
+	if (p_script) {
+		if (p_name == SNAME("_ready")) {
+			// Also runs the implicit ready functions, see GDScriptInstance::callp().
+			return nullptr;
+		}
+		GDScriptFunction *function = _find_function(p_script, p_name);
+		if (function) {
+			Entry *entry = memnew(Entry);
+			entry->script = p_script;
+			entry->kind = SCRIPT_FUNCTION;
+			entry->function = function;
+			return entry;
+		}
+	}
+
+	const StringName &class_name = p_object->get_class_name();
+	MethodBind *method = ClassDB::get_method(class_name, p_name);
+	if (!method) {
+		return nullptr;
+	}
+
+	Entry *entry = memnew(Entry);
+	entry->script = p_script;
+	entry->native_class = class_name.data_unique_pointer();
+	entry->kind = NATIVE_METHOD;
+	entry->method = method;
+	return entry;
+}
+
+const GDScriptInlineCache::Entry *GDScriptInlineCache::_find(const GDScript *p_script, const Object *p_object) const {
+	uint32_t current = epoch.get();
+	const void *native_class = nullptr;
+	for (int i = 0; i < MAX_ENTRIES; i++) {
+		// Sequentially consistent, so it's ordered after registering as a reader, see _release().
+		const Entry *entry = entries[i].load();
+		if (!entry) {
+			// Slots are filled in order and never emptied.
+			break;
+		}
+		if (entry->epoch != current || entry->script != p_script) {
+			continue;
+		}
+		if (entry->native_class) {
+			if (!native_class) {
+				native_class = p_object->get_class_name().data_unique_pointer();
+			}
+			if (entry->native_class != native_class) {
+				continue;
+			}
+		}
+		return entry;
+	}
+	return nullptr;
+}
+
+const GDScriptInlineCache::Entry *GDScriptInlineCache::_insert(Entry *p_entry) {
+	if (!p_entry) {
+		return nullptr;
+	}
+
+	for (int i = 0; i < MAX_ENTRIES; i++) {
+		Entry *entry = entries[i].load();
+		if (!entry) {
+			if (entries[i].compare_exchange_strong(entry, p_entry)) {
+				return p_entry;
+			}
+			// Another thread took the slot, entry is now what it stored.
+		}
+		if (entry->epoch != p_entry->epoch && entries[i].compare_exchange_strong(entry, p_entry)) {
+			// Other threads may still be reading the stale entry.
+			_retire(entry);
+			return p_entry;
+		}
+	}
+
+	// Too many receiver types seen here, stop trying to cache them.
+	// The entry is still good for the current lookup.
+	megamorphic.set();
+	_retire(p_entry);
+	return p_entry;
+}
+
+void GDScriptInlineCache::_retire(Entry *p_entry) {
+	Entry *head = retired.load(std::memory_order_relaxed);
+	do {
+		p_entry->retired_next = head;
+	} while (!retired.compare_exchange_weak(head, p_entry, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void GDScriptInlineCache::_release() {
+	if (readers.fetch_sub(1) != 1 || !retired.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	// Retired entries were unlinked before being pushed, so only lookups that were already running can hold them.
+	// If there are none after taking the list, nothing can, and they can be freed.
+	Entry *entry = retired.exchange(nullptr);
+	if (!entry) {
+		return;
+	}
+	bool in_use = readers.load() != 0;
+	while (entry) {
+		Entry *next = entry->retired_next;
+		if (in_use) {
+			// Try again when the next lookup ends.
+			_retire(entry);
+		} else {
+			memdelete(entry);
+		}
+		entry = next;
+	}
+}
+
+bool GDScriptInlineCache::_lookup(Object *p_object, const GDScript *p_script, const StringName &p_name, Access p_access, Entry &r_entry) {
+	// Entries can be retired by other threads at any point, so they are only read while registered as a reader,
+	// and copied for the caller. Script code that runs afterwards can't keep the cache from reclaiming them.
+	readers.fetch_add(1);
+
+	const Entry *entry = _find(p_script, p_object);
+	if (!entry && !megamorphic.is_set()) {
+		uint32_t current = epoch.get();
+		Entry *resolved = nullptr;
+		switch (p_access) {
+			case ACCESS_GET:
+			case ACCESS_SET: {
+				if (p_script) {
+					resolved = _resolve_member(p_script, p_name, p_access == ACCESS_GET);
+				}
+				if (!resolved) {
+					resolved = _resolve_native_property(p_object, p_script, p_name, p_access == ACCESS_GET);
+				}
+			} break;
+			case ACCESS_CALL: {
+				resolved = _resolve_call(p_object, p_script, p_name);
+			} break;
+		}
+		if (resolved) {
+			resolved->epoch = current;
+		}
+		entry = _insert(resolved);
+	}
+	if (entry) {
+		r_entry = *entry;
+	}
+
+	_release();
+	return entry != nullptr;
+}
+
+Variant GDScriptInlineCache::get_named(const Variant *p_base, const StringName &p_name, bool &r_valid) {
+	Object *obj = p_base->get_validated_object();
+	GDScriptInstance *instance = nullptr;
+	const GDScript *script = nullptr;
+	Entry entry;
+	if (!obj || !_get_receiver(obj, instance, script) || !_lookup(obj, script, p_name, ACCESS_GET, entry)) {
+		return p_base->get_named(p_name, r_valid);
+	}
+
+	r_valid = true;
+	switch (entry.kind) {
+		case MEMBER:
+		case MEMBER_ACCESSOR: {
+			if (entry.kind == MEMBER_ACCESSOR) {
+				Callable::CallError err;
+				Variant ret = entry.function->call(instance, nullptr, 0, err);
+				if (err.error == Callable::CallError::CALL_OK) {
+					return ret;
+				}
+			}
+			return instance->members[entry.index];
+		}
+		case NATIVE_METHOD: {
+			Callable::CallError err;
+			if (entry.index >= 0) {
+				Variant index = entry.index;
+				const Variant *args[1] = { &index };
+				return entry.method->call(obj, args, 1, err);
+			}
+			return entry.method->call(obj, nullptr, 0, err);
+		}
+		case SCRIPT_FUNCTION: {
+			break;
+		}
+	}
+
+	return p_base->get_named(p_name, r_valid);
+}
+
+void GDScriptInlineCache::set_named(Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// Object::set() also marks the object as edited.
+		p_base->set_named(p_name, p_value, r_valid);
+		return;
+	}
+#endif
+
+	Object *obj = p_base->get_validated_object();
+	GDScriptInstance *instance = nullptr;
+	const GDScript *script = nullptr;
+	Entry entry;
+	if (!obj || !_get_receiver(obj, instance, script) || !_lookup(obj, script, p_name, ACCESS_SET, entry)) {
+		p_base->set_named(p_name, p_value, r_valid);
+		return;
+	}
+
+	switch (entry.kind) {
+		case MEMBER:
+		case MEMBER_ACCESSOR: {
+			if (entry.member_type->has_type && !entry.member_type->is_type(p_value)) {
+				// Needs a conversion, let the instance deal with it.
+				break;
+			}
+			if (entry.kind == MEMBER) {
+				instance->members.write[entry.index] = p_value;
+				r_valid = true;
+			} else {
+				const Variant *args = &p_value;
+				Callable::CallError err;
+				entry.function->call(instance, &args, 1, err);
+				r_valid = err.error == Callable::CallError::CALL_OK;
+			}
+			return;
+		}
+		case NATIVE_METHOD: {
+			Callable::CallError err;
+			if (entry.index >= 0) {
+				Variant index = entry.index;
+				const Variant *args[2] = { &index, &p_value };
+				entry.method->call(obj, args, 2, err);
+			} else {
+				const Variant *args[1] = { &p_value };
+				entry.method->call(obj, args, 1, err);
+			}
+			r_valid = err.error == Callable::CallError::CALL_OK;
+			return;
+		}
+		case SCRIPT_FUNCTION: {
+			break;
+		}
+	}
+
+	p_base->set_named(p_name, p_value, r_valid);
+}
+
+void GDScriptInlineCache::callp(Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	Object *obj = p_base->get_validated_object();
+	GDScriptInstance *instance = nullptr;
+	const GDScript *script = nullptr;
+	Entry entry;
+	if (!obj || !_get_receiver(obj, instance, script) || !_lookup(obj, script, p_method, ACCESS_CALL, entry)) {
+		p_base->callp(p_method, p_args, p_argcount, r_ret, r_error);
+		return;
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+#ifdef DEBUG_ENABLED
+	// Same as Object::callp(), so the object can't be freed by the method being called.
+	_ObjectDebugLock debug_lock(obj);
+#endif
+	if (entry.kind == SCRIPT_FUNCTION) {
+		r_ret = entry.function->call(instance, p_args, p_argcount, r_error);
+	} else {
+		r_ret = entry.method->call(obj, p_args, p_argcount, r_error);
+	}
+}
+
+GDScriptInlineCache::~GDScriptInlineCache() {
+	for (int i = 0; i < MAX_ENTRIES; i++) {
+		Entry *entry = entries[i].load(std::memory_order_relaxed);
+		if (entry) {
+			memdelete(entry);
+		}
+	}
+	Entry *entry = retired.load(std::memory_order_relaxed);
+	while (entry) {
+		Entry *next = entry->retired_next;
+		memdelete(entry);
+		entry = next;
+	}
+}
+
+/////////////////////
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
@@ -36,12 +36,16 @@
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 #include "gdscript_utility_functions.h"
 
 class GDScriptInstance;
 class GDScript;
+class GDScriptLambdaCallable;
+class GDScriptFunction;
+class MethodBind;
 
 class GDScriptDataType {
 private:
@@ -216,11 +220,80 @@ public:
 	}
 };
 
+// Cache for a named get, set or call on a base whose type is unknown at compile time.
+// Each OPCODE_GET_NAMED, OPCODE_SET_NAMED and OPCODE_CALL owns one, and remembers
+// what the name resolved to for the last few receiver types, keyed on the receiver's
+// GDScript and/or native class. Entries are immutable once published, so they can be
+// read from any thread without locking; replaced entries are freed once no lookup can hold them.
+struct GDScriptInlineCache {
+	enum {
+		MAX_ENTRIES = 4,
+	};
+
+	enum Kind {
+		MEMBER, // Script member variable, accessed directly.
+		MEMBER_ACCESSOR, // Script member variable with a getter or setter function.
+		SCRIPT_FUNCTION,
+		NATIVE_METHOD, // Native method, or native property getter/setter.
+	};
+
+	struct Entry {
+		const GDScript *script = nullptr;
+		const void *native_class = nullptr;
+		uint32_t epoch = 0;
+		Kind kind = MEMBER;
+		int index = -1; // Member index, or native property index.
+		const GDScriptDataType *member_type = nullptr;
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+		Entry *retired_next = nullptr;
+	};
+
+private:
+	// Bumped whenever script layouts or functions may have changed, which invalidates all entries.
+	static SafeNumeric<uint32_t> epoch;
+
+	enum Access {
+		ACCESS_GET,
+		ACCESS_SET,
+		ACCESS_CALL,
+	};
+
+	std::atomic<Entry *> entries[MAX_ENTRIES] = {};
+	std::atomic<Entry *> retired = nullptr;
+	std::atomic<uint32_t> readers = 0; // Lookups reading entries right now.
+	SafeFlag megamorphic;
+
+	static bool _get_receiver(Object *p_object, GDScriptInstance *&r_instance, const GDScript *&r_script);
+	static GDScriptFunction *_find_function(const GDScript *p_script, const StringName &p_name);
+	static bool _script_handles_property(const GDScript *p_script, const StringName &p_name, bool p_get);
+	static Entry *_resolve_member(const GDScript *p_script, const StringName &p_name, bool p_get);
+	static Entry *_resolve_native_property(Object *p_object, const GDScript *p_script, const StringName &p_name, bool p_get);
+	static Entry *_resolve_call(Object *p_object, const GDScript *p_script, const StringName &p_name);
+
+	const Entry *_find(const GDScript *p_script, const Object *p_object) const;
+	const Entry *_insert(Entry *p_entry);
+	void _retire(Entry *p_entry);
+	void _release();
+	bool _lookup(Object *p_object, const GDScript *p_script, const StringName &p_name, Access p_access, Entry &r_entry);
+
+public:
+	static void invalidate_all() { epoch.increment(); }
+
+	Variant get_named(const Variant *p_base, const StringName &p_name, bool &r_valid);
+	void set_named(Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+	void callp(Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+
+	~GDScriptInlineCache();
+};
+
 class GDScriptFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_INT,
+		OPCODE_OPERATOR_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -228,9 +301,19 @@ public:
 		OPCODE_SET_KEYED,
 		OPCODE_SET_KEYED_VALIDATED,
 		OPCODE_SET_INDEXED_VALIDATED,
+		OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
@@ -327,6 +410,8 @@ public:
 		OPCODE_ITERATE_BEGIN_STRING,
 		OPCODE_ITERATE_BEGIN_DICTIONARY,
 		OPCODE_ITERATE_BEGIN_ARRAY,
+		OPCODE_ITERATE_BEGIN_ARRAY_INT,
+		OPCODE_ITERATE_BEGIN_ARRAY_FLOAT,
 		OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY,
 		OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY,
 		OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY,
@@ -347,6 +432,8 @@ public:
 		OPCODE_ITERATE_STRING,
 		OPCODE_ITERATE_DICTIONARY,
 		OPCODE_ITERATE_ARRAY,
+		OPCODE_ITERATE_ARRAY_INT,
+		OPCODE_ITERATE_ARRAY_FLOAT,
 		OPCODE_ITERATE_PACKED_BYTE_ARRAY,
 		OPCODE_ITERATE_PACKED_INT32_ARRAY,
 		OPCODE_ITERATE_PACKED_INT64_ARRAY,
@@ -432,6 +519,7 @@ private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptLambdaCallable;
 
 	StringName source;
 
@@ -468,6 +556,8 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	int _lambdas_count = 0;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	int _inline_caches_count = 0;
+	GDScriptInlineCache *_inline_caches_ptr = nullptr;
 	const int *_code_ptr = nullptr;
 	int _code_size = 0;
 	int _argument_count = 0;
@@ -498,6 +588,8 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+	bool shares_lambda_callable = false; // Set on non-capturing lambdas without `self`, every evaluation returns the same callable.
+	GDScriptLambdaCallable *shared_lambda_callable = nullptr; // Not owned, cleared by the callable when it's freed.
 	Vector<int> code;
 	Vector<GDScriptDataType> argument_types;
 	GDScriptDataType return_type;
@@ -30,9 +30,13 @@
 
 #include "gdscript_lambda_callable.h"
 
+#include "core/os/spin_lock.h"
 #include "core/templates/hashfuncs.h"
 #include "gdscript.h"
 
+// Guards GDScriptFunction::shared_lambda_callable, which is read by the VM and cleared by the callable and the function.
+static SpinLock shared_lambda_callable_lock;
+
 bool GDScriptLambdaCallable::compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
 	// Lambda callables are only compared by reference.
 	return p_a == p_b;
@@ -48,7 +52,7 @@ uint32_t GDScriptLambdaCallable::hash() const {
 }
 
 String GDScriptLambdaCallable::get_as_text() const {
-	if (function->get_name() != StringName()) {
+	if (function != nullptr && function->get_name() != StringName()) {
 		return function->get_name().operator String() + "(lambda)";
 	}
 	return "(anonymous lambda)";
@@ -67,19 +71,24 @@ ObjectID GDScriptLambdaCallable::get_object() const {
 }
 
 void GDScriptLambdaCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
+	if (unlikely(function == nullptr)) {
+		ERR_PRINT("Trying to call a lambda whose script was reloaded.");
+		r_call_error.error = Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL;
+		return;
+	}
+
 	int captures_amount = captures.size();
 
 	if (captures_amount > 0) {
-		Vector<const Variant *> args;
-		args.resize(p_argcount + captures_amount);
+		const Variant **args = (const Variant **)alloca(sizeof(const Variant *) * (p_argcount + captures_amount));
 		for (int i = 0; i < captures_amount; i++) {
-			args.write[i] = &captures[i];
+			args[i] = &captures[i];
 		}
 		for (int i = 0; i < p_argcount; i++) {
-			args.write[i + captures_amount] = p_arguments[i];
+			args[i + captures_amount] = p_arguments[i];
 		}
 
-		r_return_value = function->call(nullptr, args.ptrw(), args.size(), r_call_error);
+		r_return_value = function->call(nullptr, args, p_argcount + captures_amount, r_call_error);
 		r_call_error.argument -= captures_amount;
 	} else {
 		r_return_value = function->call(nullptr, p_arguments, p_argcount, r_call_error);
@@ -94,6 +103,46 @@ GDScriptLambdaCallable::GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptF
 	h = (uint32_t)hash_murmur3_one_64((uint64_t)this);
 }
 
+Callable GDScriptLambdaCallable::get_shared(const Ref<GDScript> &p_script, GDScriptFunction *p_function) {
+	Callable callable;
+
+	shared_lambda_callable_lock.lock();
+	if (p_function->shared_lambda_callable != nullptr) {
+		// Fails if the last copy was just released, its destructor is then waiting on the lock to clear the pointer.
+		callable = Callable::reference_custom(p_function->shared_lambda_callable);
+	}
+	if (callable.is_null()) {
+		GDScriptLambdaCallable *shared = memnew(GDScriptLambdaCallable(p_script, p_function, Vector<Variant>()));
+		shared->shared = true;
+		p_function->shared_lambda_callable = shared;
+		callable = Callable(shared);
+	}
+	shared_lambda_callable_lock.unlock();
+
+	return callable;
+}
+
+void GDScriptLambdaCallable::clear_shared(GDScriptFunction *p_function) {
+	shared_lambda_callable_lock.lock();
+	if (p_function->shared_lambda_callable != nullptr) {
+		p_function->shared_lambda_callable->function = nullptr;
+		p_function->shared_lambda_callable = nullptr;
+	}
+	shared_lambda_callable_lock.unlock();
+}
+
+GDScriptLambdaCallable::~GDScriptLambdaCallable() {
+	if (!shared) {
+		return;
+	}
+
+	shared_lambda_callable_lock.lock();
+	if (function != nullptr && function->shared_lambda_callable == this) {
+		function->shared_lambda_callable = nullptr;
+	}
+	shared_lambda_callable_lock.unlock();
+}
+
 bool GDScriptLambdaSelfCallable::compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
 	// Lambda callables are only compared by reference.
 	return p_a == p_b;
@@ -139,16 +188,15 @@ void GDScriptLambdaSelfCallable::call(const Variant **p_arguments, int p_argcoun
 	int captures_amount = captures.size();
 
 	if (captures_amount > 0) {
-		Vector<const Variant *> args;
-		args.resize(p_argcount + captures_amount);
+		const Variant **args = (const Variant **)alloca(sizeof(const Variant *) * (p_argcount + captures_amount));
 		for (int i = 0; i < captures_amount; i++) {
-			args.write[i] = &captures[i];
+			args[i] = &captures[i];
 		}
 		for (int i = 0; i < p_argcount; i++) {
-			args.write[i + captures_amount] = p_arguments[i];
+			args[i + captures_amount] = p_arguments[i];
 		}
 
-		r_return_value = function->call(static_cast<GDScriptInstance *>(object->get_script_instance()), args.ptrw(), args.size(), r_call_error);
+		r_return_value = function->call(static_cast<GDScriptInstance *>(object->get_script_instance()), args, p_argcount + captures_amount, r_call_error);
 		r_call_error.argument -= captures_amount;
 	} else {
 		r_return_value = function->call(static_cast<GDScriptInstance *>(object->get_script_instance()), p_arguments, p_argcount, r_call_error);
@@ -44,6 +44,7 @@ class GDScriptLambdaCallable : public CallableCustom {
 	GDScriptFunction *function = nullptr;
 	Ref<GDScript> script;
 	uint32_t h;
+	bool shared = false;
 
 	Vector<Variant> captures;
 
@@ -58,8 +59,13 @@ public:
 	ObjectID get_object() const override;
 	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override;
 
+	// Returns the callable shared by every evaluation of a non-capturing lambda, creating it if there's none alive.
+	static Callable get_shared(const Ref<GDScript> &p_script, GDScriptFunction *p_function);
+	// Detaches the shared callable from a function that's being freed, e.g. on reload.
+	static void clear_shared(GDScriptFunction *p_function);
+
 	GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptFunction *p_function, const Vector<Variant> &p_captures);
-	virtual ~GDScriptLambdaCallable() = default;
+	virtual ~GDScriptLambdaCallable();
 };
 
 // Lambda callable that references a particular object, so it can use `self` in the body.
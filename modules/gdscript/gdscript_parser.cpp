@@ -303,6 +303,24 @@ Error GDScriptParser::parse(const String &p_source_code, const String &p_script_
 
 	tokenizer.set_source_code(source);
 	tokenizer.set_cursor_position(cursor_line, cursor_column);
+	return _parse(p_script_path);
+}
+
+Error GDScriptParser::parse_binary(const Vector<uint8_t> &p_binary, const String &p_script_path) {
+	clear();
+
+	Error err = tokenizer.set_binary(p_binary);
+	if (err == ERR_FILE_UNRECOGNIZED) {
+		push_error("Script was pre-tokenized by another engine version, the project needs to be exported again.");
+		return err;
+	} else if (err != OK) {
+		push_error("Pre-tokenized script is corrupted.");
+		return err;
+	}
+	return _parse(p_script_path);
+}
+
+Error GDScriptParser::_parse(const String &p_script_path) {
 	script_path = p_script_path;
 	current = tokenizer.scan();
 	// Avoid error or newline as the first token.
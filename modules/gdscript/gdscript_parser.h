@@ -1404,6 +1404,7 @@ private:
 	void pop_multiline();
 
 	// Main blocks.
+	Error _parse(const String &p_script_path);
 	void parse_program();
 	ClassNode *parse_class();
 	void parse_class_name();
@@ -1487,6 +1488,8 @@ private:
 
 public:
 	Error parse(const String &p_source_code, const String &p_script_path, bool p_for_completion);
+	// Parses a script pre-tokenized with GDScriptTokenizer::make_binary(). Returns ERR_FILE_UNRECOGNIZED if it was made by another engine version.
+	Error parse_binary(const Vector<uint8_t> &p_binary, const String &p_script_path);
 	ClassNode *get_tree() const { return head; }
 	bool is_tool() const { return _is_tool; }
 	ClassNode *find_class(const String &p_qualified_name) const;
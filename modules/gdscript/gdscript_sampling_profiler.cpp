@@ -0,0 +1,170 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/object/method_bind.h"
+#include "core/os/os.h"
+#include "gdscript_function.h"
+
+GDScriptSamplingProfiler *GDScriptSamplingProfiler::singleton = nullptr;
+SafeFlag GDScriptSamplingProfiler::active;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::tick_count;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::session;
+thread_local GDScriptSamplingProfiler::ThreadState GDScriptSamplingProfiler::thread_state;
+
+void GDScriptSamplingProfiler::_thread_func(void *p_user) {
+	GDScriptSamplingProfiler *self = static_cast<GDScriptSamplingProfiler *>(p_user);
+	while (!self->exit_thread.is_set()) {
+		OS::get_singleton()->delay_usec(self->interval_usec);
+		tick_count.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::_record(const ThreadState &p_state, uint32_t p_samples, const String &p_native) {
+	String stack = Thread::get_caller_id() == Thread::get_main_id() ? String("main") : "thread " + itos(Thread::get_caller_id());
+	for (const Frame &frame : p_state.frames) {
+		stack += ";" + String(frame.function->get_source()) + ":" + String(frame.function->get_name()) + ":" + itos(*frame.line);
+	}
+	if (!p_native.is_empty()) {
+		stack += ";" + p_native;
+	}
+
+	MutexLock lock(mutex);
+	HashMap<String, uint64_t>::Iterator E = stacks.find(stack);
+	if (E) {
+		E->value += p_samples;
+	} else {
+		stacks.insert(stack, p_samples);
+	}
+}
+
+void GDScriptSamplingProfiler::_record_native(uint32_t p_samples, const MethodBind *p_method) {
+	_record(thread_state, p_samples, String(p_method->get_instance_class()) + "::" + String(p_method->get_name()));
+}
+
+void GDScriptSamplingProfiler::_record_call(uint32_t p_samples, const Variant *p_base, const StringName &p_method) {
+	// The call may have freed the base, so look it up again.
+	Object *obj = p_base->get_validated_object();
+	String type = obj ? obj->get_class() : Variant::get_type_name(p_base->get_type());
+	_record(thread_state, p_samples, type + "::" + String(p_method));
+}
+
+void GDScriptSamplingProfiler::_send_stacks() {
+	Array data;
+	data.push_back(interval_usec);
+	data.push_back(get_collapsed_stacks());
+	EngineDebugger::get_singleton()->send_message("gdscript_sampler:stacks", data);
+}
+
+void GDScriptSamplingProfiler::enter_function(const GDScriptFunction *p_function, const int *p_line) {
+	ThreadState &state = thread_state;
+	uint32_t samples = _take_samples(state);
+	// Without a caller, the elapsed time was spent outside of scripts.
+	if (samples && !state.frames.is_empty()) {
+		singleton->_record(state, samples, String());
+	}
+	Frame frame;
+	frame.function = p_function;
+	frame.line = p_line;
+	state.frames.push_back(frame);
+}
+
+void GDScriptSamplingProfiler::exit_function() {
+	ThreadState &state = thread_state;
+	ERR_FAIL_COND(state.frames.is_empty());
+	poll();
+	state.frames.resize(state.frames.size() - 1);
+}
+
+void GDScriptSamplingProfiler::start(uint32_t p_interval_usec) {
+	stop();
+
+	interval_usec = p_interval_usec;
+	session.increment();
+	if (interval_usec > 0) {
+		exit_thread.clear();
+		thread.start(_thread_func, this);
+	}
+	active.set();
+}
+
+void GDScriptSamplingProfiler::stop() {
+	active.clear();
+	if (thread.is_started()) {
+		exit_thread.set();
+		thread.wait_to_finish();
+	}
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	stacks.clear();
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() {
+	MutexLock lock(mutex);
+	String text;
+	for (const KeyValue<String, uint64_t> &E : stacks) {
+		text += E.key + " " + itos(E.value) + "\n";
+	}
+	return text;
+}
+
+void GDScriptSamplingProfiler::toggle(bool p_enable, const Array &p_opts) {
+	if (p_enable) {
+		uint32_t interval = 1000;
+		if (p_opts.size() >= 1 && p_opts[0].get_type() == Variant::INT) {
+			interval = MAX(1, int(p_opts[0]));
+		}
+		clear();
+		start(interval);
+	} else {
+		stop();
+		_send_stacks();
+	}
+}
+
+void GDScriptSamplingProfiler::add(const Array &p_data) {
+	// Sends what was collected so far, without stopping.
+	_send_stacks();
+}
+
+GDScriptSamplingProfiler::GDScriptSamplingProfiler() {
+	singleton = this;
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	stop();
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#include "core/debugger/engine_profiler.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+class MethodBind;
+
+// Statistical profiler for the GDScript VM. A background thread bumps a tick
+// counter at a fixed interval, and each thread running scripts checks it when
+// it reaches a new line or returns from a native call. Elapsed ticks are then
+// charged to the thread's current script stack, down to the line being run and
+// the native method being called, if any. Results are aggregated as collapsed
+// stacks, the text format read by flame graph tools.
+class GDScriptSamplingProfiler : public EngineProfiler {
+	struct Frame {
+		const GDScriptFunction *function = nullptr;
+		const int *line = nullptr;
+	};
+
+	struct ThreadState {
+		LocalVector<Frame> frames;
+		uint32_t session = 0;
+		uint32_t last_tick = 0;
+	};
+
+	static GDScriptSamplingProfiler *singleton;
+	static SafeFlag active;
+	static SafeNumeric<uint32_t> tick_count;
+	static SafeNumeric<uint32_t> session;
+	static thread_local ThreadState thread_state;
+
+	uint32_t interval_usec = 1000;
+	Thread thread;
+	SafeFlag exit_thread;
+
+	Mutex mutex;
+	HashMap<String, uint64_t> stacks;
+
+	static void _thread_func(void *p_user);
+	void _send_stacks();
+
+	_FORCE_INLINE_ static uint32_t _take_samples(ThreadState &p_state) {
+		uint32_t current_session = session.get();
+		uint32_t current_tick = tick_count.get();
+		if (unlikely(p_state.session != current_session)) {
+			// Ticks from before this session started don't count.
+			p_state.session = current_session;
+			p_state.last_tick = current_tick;
+			return 0;
+		}
+		uint32_t samples = current_tick - p_state.last_tick;
+		p_state.last_tick = current_tick;
+		return samples;
+	}
+
+	void _record(const ThreadState &p_state, uint32_t p_samples, const String &p_native);
+	void _record_native(uint32_t p_samples, const MethodBind *p_method);
+	void _record_call(uint32_t p_samples, const Variant *p_base, const StringName &p_method);
+
+public:
+	static GDScriptSamplingProfiler *get_singleton() { return singleton; }
+	_FORCE_INLINE_ static bool is_active() { return active.is_set(); }
+
+	// Hooks for GDScriptFunction::call(), only valid while active.
+	static void enter_function(const GDScriptFunction *p_function, const int *p_line);
+	static void exit_function();
+	_FORCE_INLINE_ static void poll() {
+		uint32_t samples = _take_samples(thread_state);
+		if (unlikely(samples) && !thread_state.frames.is_empty()) {
+			singleton->_record(thread_state, samples, String());
+		}
+	}
+	_FORCE_INLINE_ static void poll_native(const MethodBind *p_method) {
+		uint32_t samples = _take_samples(thread_state);
+		if (unlikely(samples) && !thread_state.frames.is_empty()) {
+			singleton->_record_native(samples, p_method);
+		}
+	}
+	_FORCE_INLINE_ static void poll_call(const Variant *p_base, const StringName &p_method) {
+		uint32_t samples = _take_samples(thread_state);
+		if (unlikely(samples) && !thread_state.frames.is_empty()) {
+			singleton->_record_call(samples, p_base, p_method);
+		}
+	}
+
+	// With an interval of 0, samples are only taken when tick() is called.
+	void start(uint32_t p_interval_usec);
+	void stop();
+	void clear();
+	// Has every thread running scripts take a sample, as if the interval elapsed.
+	static void tick() { tick_count.increment(); }
+	String get_collapsed_stacks();
+
+	virtual void toggle(bool p_enable, const Array &p_opts) override;
+	virtual void add(const Array &p_data) override;
+
+	GDScriptSamplingProfiler();
+	~GDScriptSamplingProfiler();
+};
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
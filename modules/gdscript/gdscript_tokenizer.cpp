@@ -31,6 +31,7 @@
 #include "gdscript_tokenizer.h"
 
 #include "core/error/error_macros.h"
+#include "core/io/marshalls.h"
 #include "core/string/char_utils.h"
 
 #ifdef TOOLS_ENABLED
@@ -1282,6 +1283,10 @@ void GDScriptTokenizer::_skip_whitespace() {
 }
 
 GDScriptTokenizer::Token GDScriptTokenizer::scan() {
+	if (binary_mode) {
+		return _scan_binary();
+	}
+
 	if (has_error()) {
 		return pop_error();
 	}
@@ -1346,6 +1351,7 @@ GDScriptTokenizer::Token GDScriptTokenizer::scan() {
 		_advance();
 		newline(false);
 		line_continuation = true;
+		continuation_count++;
 		return scan(); // Recurse to get next token.
 	}
 
@@ -1554,6 +1560,303 @@ GDScriptTokenizer::Token GDScriptTokenizer::scan() {
 	}
 }
 
+// Pre-tokenized scripts.
+
+void GDScriptTokenizer::_binary_check_indent(int p_indent_count) {
+	// Same as check_indent(), minus the error checking. make_binary() doesn't store scripts with indentation errors,
+	// but lines inside brackets are only checked by the parser (like lambda bodies), so mismatches keep the closest level.
+	if (p_indent_count == 0) {
+		pending_indents -= indent_level();
+		indent_stack.clear();
+		return;
+	}
+
+	int previous_indent = 0;
+	if (indent_level() > 0) {
+		previous_indent = indent_stack.back()->get();
+	}
+	if (p_indent_count > previous_indent) {
+		indent_stack.push_back(p_indent_count);
+		pending_indents++;
+	} else if (p_indent_count < previous_indent) {
+		while (indent_level() > 0 && indent_stack.back()->get() > p_indent_count) {
+			indent_stack.pop_back();
+			pending_indents--;
+		}
+		if (indent_level() == 0 || indent_stack.back()->get() != p_indent_count) {
+			indent_stack.push_back(p_indent_count);
+		}
+	}
+}
+
+GDScriptTokenizer::Token GDScriptTokenizer::_scan_binary() {
+	if (pending_indents != 0) {
+		Token indent(pending_indents > 0 ? Token::INDENT : Token::DEDENT);
+		pending_indents += pending_indents > 0 ? -1 : 1;
+		indent.start_line = line;
+		indent.end_line = line;
+		indent.start_column = 1;
+		indent.end_column = column;
+		indent.leftmost_column = 1;
+		indent.rightmost_column = column;
+		return indent;
+	}
+
+	if (binary_current >= binary_tokens.size()) {
+		Token end(Token::TK_EOF);
+		if (!binary_ended) {
+			// Like at the end of the source code, add a newline and close every indentation level.
+			binary_ended = true;
+			pending_indents -= indent_level();
+			indent_stack.clear();
+			if (!multiline_mode && binary_current > 0) {
+				end.type = Token::NEWLINE;
+			} else if (pending_indents != 0) {
+				return _scan_binary();
+			}
+		}
+		end.start_line = line;
+		end.end_line = line;
+		end.start_column = column;
+		end.end_column = column;
+		end.leftmost_column = column;
+		end.rightmost_column = column;
+		return end;
+	}
+
+	if (binary_current_line < binary_lines.size() && binary_lines[binary_current_line].token == binary_current) {
+		const BinaryLine &bl = binary_lines[binary_current_line++];
+		int previous_line = line;
+		line = bl.line;
+		column = binary_columns[binary_current * 2];
+		if (bl.newline) {
+			if (!multiline_mode) {
+				_binary_check_indent(column - 1);
+			}
+			if (!multiline_mode && binary_current > 0) {
+				Token newline(Token::NEWLINE);
+				newline.start_line = previous_line;
+				newline.end_line = previous_line;
+				return newline;
+			}
+			if (pending_indents != 0) {
+				return _scan_binary();
+			}
+		}
+	}
+
+	uint32_t data = binary_tokens[binary_current];
+	Token token((Token::Type)(data & 0xFF));
+	token.start_line = line;
+	token.end_line = line;
+	token.start_column = binary_columns[binary_current * 2];
+	token.end_column = binary_columns[binary_current * 2 + 1];
+	token.leftmost_column = token.start_column;
+	token.rightmost_column = token.end_column;
+	binary_current++;
+
+	uint32_t payload = data >> 8;
+	if (token.type == Token::LITERAL) {
+		token.literal = binary_constants[payload];
+	} else if (token.type == Token::ANNOTATION) {
+		token.source = binary_identifiers[payload];
+		token.literal = StringName(token.source);
+	} else if (token.is_node_name()) {
+		token.source = binary_identifiers[payload];
+	}
+
+	return token;
+}
+
+Error GDScriptTokenizer::set_binary(const Vector<uint8_t> &p_binary) {
+	const uint8_t *buf = p_binary.ptr();
+	int total = p_binary.size();
+	ERR_FAIL_COND_V(total < 28, ERR_INVALID_DATA);
+
+	// Reported apart from corrupted data, as it means the project was exported with another engine version.
+	if (buf[0] != 'G' || buf[1] != 'D' || buf[2] != 'S' || buf[3] != 'C' || decode_uint32(&buf[4]) != BINARY_VERSION || decode_uint32(&buf[8]) != Token::TK_MAX) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	uint32_t identifier_count = decode_uint32(&buf[12]);
+	uint32_t constant_count = decode_uint32(&buf[16]);
+	uint32_t line_count = decode_uint32(&buf[20]);
+	uint32_t token_count = decode_uint32(&buf[24]);
+	buf += 28;
+	total -= 28;
+
+	binary_identifiers.resize(identifier_count);
+	for (uint32_t i = 0; i < identifier_count; i++) {
+		ERR_FAIL_COND_V(total < 4, ERR_INVALID_DATA);
+		uint32_t len = decode_uint32(buf);
+		buf += 4;
+		total -= 4;
+		ERR_FAIL_COND_V(len > (uint32_t)total, ERR_INVALID_DATA);
+		binary_identifiers.write[i].parse_utf8((const char *)buf, len);
+		buf += len;
+		total -= len;
+	}
+
+	binary_constants.resize(constant_count);
+	for (uint32_t i = 0; i < constant_count; i++) {
+		int len = 0;
+		Error err = decode_variant(binary_constants.write[i], buf, total, &len, false);
+		ERR_FAIL_COND_V(err != OK, ERR_INVALID_DATA);
+		buf += len;
+		total -= len;
+	}
+
+	ERR_FAIL_COND_V((uint64_t)line_count * 8 + (uint64_t)token_count * 12 > (uint64_t)total, ERR_INVALID_DATA);
+	binary_lines.resize(line_count);
+	for (uint32_t i = 0; i < line_count; i++) {
+		BinaryLine &bl = binary_lines.write[i];
+		bl.token = decode_uint32(&buf[0]);
+		uint32_t line_data = decode_uint32(&buf[4]);
+		bl.line = line_data & 0x7FFFFFFF;
+		bl.newline = line_data >> 31;
+		ERR_FAIL_COND_V(bl.token < 0 || (uint32_t)bl.token >= token_count, ERR_INVALID_DATA);
+		buf += 8;
+	}
+
+	binary_tokens.resize(token_count);
+	binary_columns.resize(token_count * 2);
+	uint32_t *tokens = binary_tokens.ptrw();
+	uint32_t *columns = binary_columns.ptrw();
+	for (uint32_t i = 0; i < token_count; i++) {
+		tokens[i] = decode_uint32(&buf[0]);
+		columns[i * 2] = decode_uint32(&buf[4]);
+		columns[i * 2 + 1] = decode_uint32(&buf[8]);
+		buf += 12;
+
+		uint32_t type = tokens[i] & 0xFF;
+		uint32_t payload = tokens[i] >> 8;
+		ERR_FAIL_COND_V(type >= Token::TK_MAX, ERR_INVALID_DATA);
+		if (type == Token::LITERAL) {
+			ERR_FAIL_COND_V(payload >= constant_count, ERR_INVALID_DATA);
+		} else if (type == Token::ANNOTATION || Token((Token::Type)type).is_node_name()) {
+			ERR_FAIL_COND_V(payload >= identifier_count, ERR_INVALID_DATA);
+		}
+	}
+
+	binary_mode = true;
+	binary_ended = false;
+	binary_current = 0;
+	binary_current_line = 0;
+	line = 1;
+	column = 1;
+	return OK;
+}
+
+Vector<uint8_t> GDScriptTokenizer::make_binary(const String &p_source_code) {
+	GDScriptTokenizer tokenizer;
+	tokenizer.set_source_code(p_source_code);
+
+	HashMap<String, uint32_t> identifier_map;
+	Vector<String> identifiers;
+	HashMap<Variant, uint32_t, VariantHasher, VariantComparator> constant_map;
+	Vector<Variant> constants;
+	Vector<BinaryLine> lines;
+	Vector<uint32_t> tokens;
+
+	int last_line = 0;
+	int last_end_line = 0;
+	int continuations = 0;
+
+	Vector<uint32_t> columns;
+
+	for (Token token = tokenizer.scan(); token.type != Token::TK_EOF; token = tokenizer.scan()) {
+		// Like the parser, ignore newlines and indentation inside brackets, so indentation errors are only reported where it would.
+		tokenizer.set_multiline_mode(!tokenizer.paren_stack.is_empty());
+
+		if (token.type == Token::ERROR) {
+			ERR_PRINT(vformat("Can't tokenize script at line %d: %s", token.start_line, token.literal));
+			return Vector<uint8_t>();
+		}
+		// Whitespace tokens are not stored, they depend on the multiline mode used by the parser.
+		if (token.type == Token::NEWLINE || token.type == Token::INDENT || token.type == Token::DEDENT) {
+			continue;
+		}
+
+		uint32_t payload = 0;
+		if (token.type == Token::LITERAL) {
+			if (!constant_map.has(token.literal)) {
+				constant_map[token.literal] = constants.size();
+				constants.push_back(token.literal);
+			}
+			payload = constant_map[token.literal];
+		} else if (token.type == Token::ANNOTATION || token.is_node_name()) {
+			if (!identifier_map.has(token.source)) {
+				identifier_map[token.source] = identifiers.size();
+				identifiers.push_back(token.source);
+			}
+			payload = identifier_map[token.source];
+		}
+
+		if (tokens.is_empty() || token.start_line != last_line) {
+			BinaryLine bl;
+			bl.token = tokens.size();
+			bl.line = token.start_line;
+			bl.newline = tokens.is_empty() || (token.start_line > last_end_line && tokenizer.continuation_count == continuations);
+			lines.push_back(bl);
+			last_line = token.start_line;
+		}
+		last_end_line = token.end_line;
+		continuations = tokenizer.continuation_count;
+
+		tokens.push_back(uint32_t(token.type) | (payload << 8));
+		columns.push_back(token.start_column);
+		columns.push_back(token.end_column);
+	}
+
+	Vector<uint8_t> buf;
+	buf.resize(28);
+	uint8_t *w = buf.ptrw();
+	w[0] = 'G';
+	w[1] = 'D';
+	w[2] = 'S';
+	w[3] = 'C';
+	encode_uint32(BINARY_VERSION, &w[4]);
+	encode_uint32(Token::TK_MAX, &w[8]);
+	encode_uint32(identifiers.size(), &w[12]);
+	encode_uint32(constants.size(), &w[16]);
+	encode_uint32(lines.size(), &w[20]);
+	encode_uint32(tokens.size(), &w[24]);
+
+	for (const String &identifier : identifiers) {
+		CharString cs = identifier.utf8();
+		int ofs = buf.size();
+		buf.resize(ofs + 4 + cs.length());
+		encode_uint32(cs.length(), &buf.write[ofs]);
+		memcpy(&buf.write[ofs + 4], cs.get_data(), cs.length());
+	}
+
+	for (const Variant &constant : constants) {
+		int len = 0;
+		Error err = encode_variant(constant, nullptr, len, false);
+		ERR_FAIL_COND_V(err != OK, Vector<uint8_t>());
+		int ofs = buf.size();
+		buf.resize(ofs + len);
+		encode_variant(constant, &buf.write[ofs], len, false);
+	}
+
+	int ofs = buf.size();
+	buf.resize(ofs + lines.size() * 8 + tokens.size() * 12);
+	w = buf.ptrw() + ofs;
+	for (const BinaryLine &bl : lines) {
+		encode_uint32(bl.token, &w[0]);
+		encode_uint32(uint32_t(bl.line) | (bl.newline ? 0x80000000 : 0), &w[4]);
+		w += 8;
+	}
+	for (int i = 0; i < tokens.size(); i++) {
+		encode_uint32(tokens[i], &w[0]);
+		encode_uint32(columns[i * 2], &w[4]);
+		encode_uint32(columns[i * 2 + 1], &w[8]);
+		w += 12;
+	}
+
+	return buf;
+}
+
 GDScriptTokenizer::GDScriptTokenizer() {
 #ifdef TOOLS_ENABLED
 	if (EditorSettings::get_singleton()) {
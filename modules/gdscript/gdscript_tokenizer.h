@@ -199,6 +199,26 @@ public:
 #endif // TOOLS_ENABLED
 
 private:
+	// Pre-tokenized scripts don't store whitespace tokens, only where lines start.
+	// Newlines and indentation are generated from that when scanning, as they depend on the multiline mode.
+	// The indentation of a line is the column of its first token.
+	struct BinaryLine {
+		int token = 0;
+		int line = 0;
+		bool newline = false; // Whether a new statement line starts here, as opposed to a line continuation.
+	};
+
+	bool binary_mode = false;
+	bool binary_ended = false;
+	int binary_current = 0;
+	int binary_current_line = 0;
+	Vector<uint32_t> binary_tokens;
+	Vector<uint32_t> binary_columns; // Start and end column of each token.
+	Vector<String> binary_identifiers;
+	Vector<Variant> binary_constants;
+	Vector<BinaryLine> binary_lines;
+	int continuation_count = 0; // Amount of line continuations scanned, needed to tell them apart from new lines.
+
 	String source;
 	const char32_t *_source = nullptr;
 	const char32_t *_current = nullptr;
@@ -263,10 +283,19 @@ private:
 	Token string();
 	Token annotation();
 
+	void _binary_check_indent(int p_indent_count);
+	Token _scan_binary();
+
 public:
+	enum {
+		BINARY_VERSION = 3, // Increase when the format or the token list changes, binary scripts from other versions fail to load.
+	};
+
 	Token scan();
 
 	void set_source_code(const String &p_source_code);
+	Error set_binary(const Vector<uint8_t> &p_binary);
+	static Vector<uint8_t> make_binary(const String &p_source_code);
 
 	int get_cursor_line() const;
 	int get_cursor_column() const;
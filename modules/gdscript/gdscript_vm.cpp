@@ -201,6 +201,8 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {        \
 		&&OPCODE_OPERATOR,                           \
 		&&OPCODE_OPERATOR_VALIDATED,                 \
+		&&OPCODE_OPERATOR_INT,                       \
+		&&OPCODE_OPERATOR_FLOAT,                     \
 		&&OPCODE_TYPE_TEST_BUILTIN,                  \
 		&&OPCODE_TYPE_TEST_ARRAY,                    \
 		&&OPCODE_TYPE_TEST_NATIVE,                   \
@@ -208,9 +210,19 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_SET_KEYED,                          \
 		&&OPCODE_SET_KEYED_VALIDATED,                \
 		&&OPCODE_SET_INDEXED_VALIDATED,              \
+		&&OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY,      \
+		&&OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,     \
+		&&OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,     \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,   \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,   \
 		&&OPCODE_GET_KEYED,                          \
 		&&OPCODE_GET_KEYED_VALIDATED,                \
 		&&OPCODE_GET_INDEXED_VALIDATED,              \
+		&&OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY,      \
+		&&OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,     \
+		&&OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,     \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,   \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,   \
 		&&OPCODE_SET_NAMED,                          \
 		&&OPCODE_SET_NAMED_VALIDATED,                \
 		&&OPCODE_GET_NAMED,                          \
@@ -306,6 +318,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_ITERATE_BEGIN_STRING,               \
 		&&OPCODE_ITERATE_BEGIN_DICTIONARY,           \
 		&&OPCODE_ITERATE_BEGIN_ARRAY,                \
+		&&OPCODE_ITERATE_BEGIN_ARRAY_INT,            \
+		&&OPCODE_ITERATE_BEGIN_ARRAY_FLOAT,          \
 		&&OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY,    \
 		&&OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY,   \
 		&&OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY,   \
@@ -326,6 +340,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_ITERATE_STRING,                     \
 		&&OPCODE_ITERATE_DICTIONARY,                 \
 		&&OPCODE_ITERATE_ARRAY,                      \
+		&&OPCODE_ITERATE_ARRAY_INT,                  \
+		&&OPCODE_ITERATE_ARRAY_FLOAT,                \
 		&&OPCODE_ITERATE_PACKED_BYTE_ARRAY,          \
 		&&OPCODE_ITERATE_PACKED_INT32_ARRAY,         \
 		&&OPCODE_ITERATE_PACKED_INT64_ARRAY,         \
@@ -599,6 +615,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	String err_text;
 
+	bool sampled = GDScriptSamplingProfiler::is_active();
+	if (sampled) {
+		GDScriptSamplingProfiler::enter_function(this, &line);
+	}
+
 #ifdef DEBUG_ENABLED
 
 	if (EngineDebugger::is_active()) {
@@ -745,6 +766,102 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_INT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				// Same preconditions as the validated evaluators: operand and result types are known.
+				const int64_t left = *VariantInternal::get_int(a);
+				const int64_t right = *VariantInternal::get_int(b);
+
+				switch (_code_ptr[ip + 4]) {
+					case Variant::OP_ADD:
+						*VariantInternal::get_int(dst) = left + right;
+						break;
+					case Variant::OP_SUBTRACT:
+						*VariantInternal::get_int(dst) = left - right;
+						break;
+					case Variant::OP_MULTIPLY:
+						*VariantInternal::get_int(dst) = left * right;
+						break;
+					case Variant::OP_EQUAL:
+						*VariantInternal::get_bool(dst) = left == right;
+						break;
+					case Variant::OP_NOT_EQUAL:
+						*VariantInternal::get_bool(dst) = left != right;
+						break;
+					case Variant::OP_LESS:
+						*VariantInternal::get_bool(dst) = left < right;
+						break;
+					case Variant::OP_LESS_EQUAL:
+						*VariantInternal::get_bool(dst) = left <= right;
+						break;
+					case Variant::OP_GREATER:
+						*VariantInternal::get_bool(dst) = left > right;
+						break;
+					case Variant::OP_GREATER_EQUAL:
+						*VariantInternal::get_bool(dst) = left >= right;
+						break;
+					default:
+						break;
+				}
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_FLOAT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				const double left = *VariantInternal::get_float(a);
+				const double right = *VariantInternal::get_float(b);
+
+				switch (_code_ptr[ip + 4]) {
+					case Variant::OP_ADD:
+						*VariantInternal::get_float(dst) = left + right;
+						break;
+					case Variant::OP_SUBTRACT:
+						*VariantInternal::get_float(dst) = left - right;
+						break;
+					case Variant::OP_MULTIPLY:
+						*VariantInternal::get_float(dst) = left * right;
+						break;
+					case Variant::OP_DIVIDE:
+						*VariantInternal::get_float(dst) = left / right;
+						break;
+					case Variant::OP_EQUAL:
+						*VariantInternal::get_bool(dst) = left == right;
+						break;
+					case Variant::OP_NOT_EQUAL:
+						*VariantInternal::get_bool(dst) = left != right;
+						break;
+					case Variant::OP_LESS:
+						*VariantInternal::get_bool(dst) = left < right;
+						break;
+					case Variant::OP_LESS_EQUAL:
+						*VariantInternal::get_bool(dst) = left <= right;
+						break;
+					case Variant::OP_GREATER:
+						*VariantInternal::get_bool(dst) = left > right;
+						break;
+					case Variant::OP_GREATER_EQUAL:
+						*VariantInternal::get_bool(dst) = left >= right;
+						break;
+					default:
+						break;
+				}
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -935,6 +1052,40 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#ifdef DEBUG_ENABLED
+#define OPCODE_INDEXED_PACKED_ARRAY_OOB(m_what, m_base)                                                                                      \
+	err_text = "Out of bounds " m_what " index '" + itos(*VariantInternal::get_int(index)) + "' (on base: '" + _get_var_type(m_base) + "')"; \
+	OPCODE_BREAK
+#else
+#define OPCODE_INDEXED_PACKED_ARRAY_OOB(m_what, m_base)
+#endif
+
+#define OPCODE_SET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_value_get_func) \
+	OPCODE(OPCODE_SET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                   \
+		CHECK_SPACE(4);                                                                        \
+		GET_VARIANT_PTR(dst, 0);                                                               \
+		GET_VARIANT_PTR(index, 1);                                                             \
+		GET_VARIANT_PTR(value, 2);                                                             \
+		Vector<m_elem_type> *array = VariantInternal::m_get_func(dst);                         \
+		int64_t int_index = *VariantInternal::get_int(index);                                  \
+		if (int_index < 0) {                                                                   \
+			int_index += array->size();                                                        \
+		}                                                                                      \
+		if (likely(int_index >= 0 && int_index < array->size())) {                             \
+			array->write[int_index] = *VariantInternal::m_value_get_func(value);               \
+		} else {                                                                               \
+			OPCODE_INDEXED_PACKED_ARRAY_OOB("set", dst);                                       \
+		}                                                                                      \
+		ip += 4;                                                                               \
+	}                                                                                          \
+	DISPATCH_OPCODE
+
+			OPCODE_SET_INDEXED_PACKED_ARRAY(BYTE, uint8_t, get_byte_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, get_float);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, get_float);
+
 			OPCODE(OPCODE_GET_KEYED) {
 				CHECK_SPACE(3);
 
@@ -1035,8 +1186,35 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_GET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_ret_type, m_ret_get_func) \
+	OPCODE(OPCODE_GET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                             \
+		CHECK_SPACE(4);                                                                                  \
+		GET_VARIANT_PTR(src, 0);                                                                         \
+		GET_VARIANT_PTR(index, 1);                                                                       \
+		GET_VARIANT_PTR(dst, 2);                                                                         \
+		const Vector<m_elem_type> *array = VariantInternal::m_get_func((const Variant *)src);            \
+		int64_t int_index = *VariantInternal::get_int(index);                                            \
+		if (int_index < 0) {                                                                             \
+			int_index += array->size();                                                                  \
+		}                                                                                                \
+		if (likely(int_index >= 0 && int_index < array->size())) {                                       \
+			VariantTypeChanger<m_ret_type>::change(dst);                                                 \
+			*VariantInternal::m_ret_get_func(dst) = array->ptr()[int_index];                             \
+		} else {                                                                                         \
+			OPCODE_INDEXED_PACKED_ARRAY_OOB("get", src);                                                 \
+		}                                                                                                \
+		ip += 4;                                                                                         \
+	}                                                                                                    \
+	DISPATCH_OPCODE
+
+			OPCODE_GET_INDEXED_PACKED_ARRAY(BYTE, uint8_t, get_byte_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, double, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, double, get_float);
+
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1046,8 +1224,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				_inline_caches_ptr[cache_idx].set_named(dst, *index, *value, valid);
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1064,7 +1245,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1084,7 +1265,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1094,13 +1275,17 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				GDScriptInlineCache *cache = &_inline_caches_ptr[cache_idx];
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				Variant ret = cache->get_named(src, *index, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+				*dst = cache->get_named(src, *index, valid);
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1109,7 +1294,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1599,7 +1784,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1610,6 +1795,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				GDScriptInlineCache *cache = &_inline_caches_ptr[cache_idx];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1629,7 +1818,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Object *base_obj = base->get_validated_object();
 					StringName base_class = base_obj ? base_obj->get_class_name() : StringName();
 #endif
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					cache->callp(base, *methodname, (const Variant **)argptrs, argc, *ret, err);
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1663,7 +1852,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					cache->callp(base, *methodname, (const Variant **)argptrs, argc, ret, err);
+				}
+				if (unlikely(GDScriptSamplingProfiler::is_active())) {
+					GDScriptSamplingProfiler::poll_call(base, *methodname);
 				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
@@ -1708,7 +1900,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -1758,6 +1950,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					method->call(base_obj, (const Variant **)argptrs, argc, err);
 				}
 
+				if (unlikely(GDScriptSamplingProfiler::is_active())) {
+					GDScriptSamplingProfiler::poll_native(method);
+				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
@@ -1866,6 +2061,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				*ret = method->call(nullptr, argptrs, argc, err);
 
+				if (unlikely(GDScriptSamplingProfiler::is_active())) {
+					GDScriptSamplingProfiler::poll_native(method);
+				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
@@ -1917,6 +2115,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		if (GDScriptLanguage::get_singleton()->profiling) {                          \
 			function_call_time += OS::get_singleton()->get_ticks_usec() - call_time; \
 		}                                                                            \
+		if (unlikely(GDScriptSamplingProfiler::is_active())) {                       \
+			GDScriptSamplingProfiler::poll_native(method);                           \
+		}                                                                            \
 		ip += 3;                                                                     \
 	}                                                                                \
 	DISPATCH_OPCODE
@@ -1939,6 +2140,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		VariantInternal::initialize(ret, Variant::m_type);                        \
 		void *ret_opaque = VariantInternal::OP_GET_##m_type(ret);                 \
 		method->ptrcall(base_obj, argptrs, ret_opaque);                           \
+		if (unlikely(GDScriptSamplingProfiler::is_active())) {                    \
+			GDScriptSamplingProfiler::poll_native(method);                        \
+		}                                                                         \
 		ip += 3;                                                                  \
 	}                                                                             \
 	DISPATCH_OPCODE
@@ -2033,6 +2237,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					VariantInternal::update_object_id(ret);
 				}
 
+				if (unlikely(GDScriptSamplingProfiler::is_active())) {
+					GDScriptSamplingProfiler::poll_native(method);
+				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
@@ -2085,6 +2292,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				VariantInternal::initialize(ret, Variant::NIL);
 				method->ptrcall(base_obj, argptrs, nullptr);
 
+				if (unlikely(GDScriptSamplingProfiler::is_active())) {
+					GDScriptSamplingProfiler::poll_native(method);
+				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
@@ -2406,17 +2616,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(lambda_index < 0 || lambda_index >= _lambdas_count);
 				GDScriptFunction *lambda = _lambdas_ptr[lambda_index];
 
-				Vector<Variant> captures;
-				captures.resize(captures_count);
-				for (int i = 0; i < captures_count; i++) {
-					GET_INSTRUCTION_ARG(arg, i);
-					captures.write[i] = *arg;
-				}
-
-				GDScriptLambdaCallable *callable = memnew(GDScriptLambdaCallable(Ref<GDScript>(script), lambda, captures));
-
 				GET_INSTRUCTION_ARG(result, captures_count);
-				*result = Callable(callable);
+				if (lambda->shares_lambda_callable) {
+					*result = GDScriptLambdaCallable::get_shared(Ref<GDScript>(script), lambda);
+				} else {
+					Vector<Variant> captures;
+					captures.resize(captures_count);
+					for (int i = 0; i < captures_count; i++) {
+						GET_INSTRUCTION_ARG(arg, i);
+						captures.write[i] = *arg;
+					}
+
+					GDScriptLambdaCallable *callable = memnew(GDScriptLambdaCallable(Ref<GDScript>(script), lambda, captures));
+					*result = Callable(callable);
+				}
 
 				ip += 3;
 			}
@@ -2986,6 +3199,36 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+// Typed arrays only hold elements of their type, so the loop variable is written in place.
+#define OPCODE_ITERATE_BEGIN_TYPED_ARRAY(m_elem_var_type, m_get_func)                            \
+	OPCODE(OPCODE_ITERATE_BEGIN_ARRAY_##m_elem_var_type) {                                       \
+		CHECK_SPACE(8);                                                                          \
+		GET_VARIANT_PTR(counter, 0);                                                             \
+		GET_VARIANT_PTR(container, 1);                                                           \
+		const Array *array = VariantInternal::get_array((const Variant *)container);             \
+		VariantInternal::initialize(counter, Variant::INT);                                      \
+		*VariantInternal::get_int(counter) = 0;                                                  \
+		if (!array->is_empty()) {                                                                \
+			GET_VARIANT_PTR(iterator, 2);                                                        \
+			const Variant &element = (*array)[0];                                                \
+			if (likely(element.get_type() == Variant::m_elem_var_type)) {                        \
+				VariantInternal::initialize(iterator, Variant::m_elem_var_type);                 \
+				*VariantInternal::m_get_func(iterator) = *VariantInternal::m_get_func(&element); \
+			} else {                                                                             \
+				*iterator = element;                                                             \
+			}                                                                                    \
+			ip += 5;                                                                             \
+		} else {                                                                                 \
+			int jumpto = _code_ptr[ip + 4];                                                      \
+			GD_ERR_BREAK(jumpto<0 || jumpto> _code_size);                                        \
+			ip = jumpto;                                                                         \
+		}                                                                                        \
+	}                                                                                            \
+	DISPATCH_OPCODE
+
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(INT, get_int);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(FLOAT, get_float);
+
 #define OPCODE_ITERATE_BEGIN_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_var_ret_type, m_ret_type, m_ret_get_func) \
 	OPCODE(OPCODE_ITERATE_BEGIN_PACKED_##m_var_type##_ARRAY) {                                                             \
 		CHECK_SPACE(8);                                                                                                    \
@@ -3319,6 +3562,34 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_ITERATE_TYPED_ARRAY(m_elem_var_type, m_get_func)                                                               \
+	OPCODE(OPCODE_ITERATE_ARRAY_##m_elem_var_type) {                                                                          \
+		CHECK_SPACE(4);                                                                                                       \
+		GET_VARIANT_PTR(counter, 0);                                                                                          \
+		GET_VARIANT_PTR(container, 1);                                                                                        \
+		const Array *array = VariantInternal::get_array((const Variant *)container);                                          \
+		int64_t *idx = VariantInternal::get_int(counter);                                                                     \
+		(*idx)++;                                                                                                             \
+		if (*idx >= array->size()) {                                                                                          \
+			int jumpto = _code_ptr[ip + 4];                                                                                   \
+			GD_ERR_BREAK(jumpto<0 || jumpto> _code_size);                                                                     \
+			ip = jumpto;                                                                                                      \
+		} else {                                                                                                              \
+			GET_VARIANT_PTR(iterator, 2);                                                                                     \
+			const Variant &element = (*array)[*idx];                                                                          \
+			if (likely(element.get_type() == Variant::m_elem_var_type && iterator->get_type() == Variant::m_elem_var_type)) { \
+				*VariantInternal::m_get_func(iterator) = *VariantInternal::m_get_func(&element);                              \
+			} else {                                                                                                          \
+				*iterator = element;                                                                                          \
+			}                                                                                                                 \
+			ip += 5;                                                                                                          \
+		}                                                                                                                     \
+	}                                                                                                                         \
+	DISPATCH_OPCODE
+
+			OPCODE_ITERATE_TYPED_ARRAY(INT, get_int);
+			OPCODE_ITERATE_TYPED_ARRAY(FLOAT, get_float);
+
 #define OPCODE_ITERATE_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_ret_get_func)            \
 	OPCODE(OPCODE_ITERATE_PACKED_##m_var_type##_ARRAY) {                                            \
 		CHECK_SPACE(4);                                                                             \
@@ -3520,6 +3791,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+				if (unlikely(GDScriptSamplingProfiler::is_active())) {
+					// Charge the line that just finished.
+					GDScriptSamplingProfiler::poll();
+				}
+
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
@@ -3603,6 +3879,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 
 	OPCODES_OUT
+	if (sampled) {
+		GDScriptSamplingProfiler::exit_function();
+	}
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
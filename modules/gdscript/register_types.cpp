@@ -83,7 +83,18 @@ public:
 			return;
 		}
 
-		return;
+		// The encryption filters match paths, so a "*.gd" filter would leave the pre-tokenized file readable.
+		// The source is exported then, it's read through the encrypted PCK as usual.
+		if (preset.is_valid() && preset->get_enc_pck() && !script_key.is_empty()) {
+			return;
+		}
+
+		// Ship the script pre-tokenized instead of its source, so it doesn't need to be read as text and tokenized at load.
+		Vector<uint8_t> binary = GDScriptTokenizer::make_binary(FileAccess::get_file_as_string(p_path));
+		// Scripts with errors are exported as source, so loading them reports the same errors as in the editor.
+		ERR_FAIL_COND_MSG(binary.is_empty(), vformat("Can't export \"%s\" pre-tokenized, it has syntax errors.", p_path));
+		// Remapped, so the source isn't exported and loading the original path loads the binary tokens.
+		add_file(p_path.get_basename() + ".gdc", binary, true);
 	}
 
 	virtual String _get_name() const override { return "GDScript"; }
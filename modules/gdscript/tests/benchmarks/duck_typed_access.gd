@@ -0,0 +1,26 @@
+extends RefCounted
+
+class Agent:
+	var health := 100
+	var position := Vector2()
+
+	func think(delta):
+		position.x += delta
+		return health
+
+class Scout extends Agent:
+	func think(delta):
+		position.y += delta
+		return health - 1
+
+func benchmark():
+	var agents = [Agent.new(), Scout.new(), Agent.new(), Scout.new()]
+	var resource = Resource.new()
+	var total = 0
+	for i in 100000:
+		for agent in agents:
+			total += agent.think(0.5)
+			agent.health = i % 100
+		resource.resource_name = "agent"
+		total += resource.get_name().length()
+	return total
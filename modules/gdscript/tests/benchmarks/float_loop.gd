@@ -0,0 +1,13 @@
+extends RefCounted
+
+func benchmark():
+	var position := 0.0
+	var velocity := 10.0
+	var delta := 1.0 / 60.0
+	for _i in 2000000:
+		velocity -= 9.8 * delta
+		position += velocity * delta
+		if position < 0.0:
+			position = -position
+			velocity = -velocity * 0.9
+	return position
@@ -0,0 +1,9 @@
+extends RefCounted
+
+func benchmark():
+	var result := 0
+	var i := 0
+	while i < 2000000:
+		result = result * 31 + i
+		i += 1
+	return result
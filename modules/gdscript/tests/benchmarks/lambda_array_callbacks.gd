@@ -0,0 +1,14 @@
+extends RefCounted
+
+func benchmark():
+	var values = []
+	for i in 1000:
+		values.push_back((i * 7919) % 1000)
+	var total = 0
+	for i in 200:
+		var threshold = i % 1000
+		var doubled = values.map(func(x): return x * 2)
+		var kept = doubled.filter(func(x): return x > threshold)
+		total += kept.reduce(func(accum, x): return accum + x, 0)
+		kept.sort_custom(func(a, b): return a < b)
+	return total
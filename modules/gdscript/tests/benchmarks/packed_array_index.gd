@@ -0,0 +1,23 @@
+extends RefCounted
+
+func benchmark():
+	var size := 100000
+	var a := PackedFloat32Array()
+	var b := PackedFloat32Array()
+	a.resize(size)
+	b.resize(size)
+	for i in size:
+		b[i] = i * 0.25
+
+	for _n in 20:
+		for i in size:
+			a[i] = a[i] * 0.5 + b[i]
+
+	var bytes := PackedByteArray()
+	bytes.resize(size)
+	var checksum := 0
+	for _n in 20:
+		for i in size:
+			bytes[i] = (bytes[i] + i) & 255
+			checksum += bytes[i]
+	return checksum + a[size - 1]
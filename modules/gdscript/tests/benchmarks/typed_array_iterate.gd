@@ -0,0 +1,17 @@
+extends RefCounted
+
+func benchmark():
+	var ints: Array[int] = []
+	var floats: Array[float] = []
+	for i in 100000:
+		ints.push_back(i)
+		floats.push_back(i * 0.5)
+
+	var int_sum := 0
+	var float_sum := 0.0
+	for _n in 20:
+		for value in ints:
+			int_sum += value
+		for value in floats:
+			float_sum += value
+	return float_sum + int_sum
@@ -132,10 +132,11 @@ void finish_language() {
 
 StringName GDScriptTestRunner::test_function_name;
 
-GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames) {
+GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames, bool p_binary_tokens) {
 	test_function_name = StaticCString::create("test");
 	do_init_languages = p_init_language;
 	print_filenames = p_print_filenames;
+	binary_tokens = p_binary_tokens;
 
 	source_dir = p_source_dir;
 	if (!source_dir.ends_with("/")) {
@@ -295,7 +296,7 @@ bool GDScriptTestRunner::make_tests_for_dir(const String &p_dir) {
 				if (!is_generating && !dir->file_exists(out_file)) {
 					ERR_FAIL_V_MSG(false, "Could not find output file for " + next);
 				}
-				GDScriptTest test(current_dir.path_join(next), current_dir.path_join(out_file), source_dir);
+				GDScriptTest test(current_dir.path_join(next), current_dir.path_join(out_file), source_dir, binary_tokens);
 				tests.push_back(test);
 			}
 		}
@@ -336,10 +337,11 @@ bool GDScriptTestRunner::generate_class_index() {
 	return true;
 }
 
-GDScriptTest::GDScriptTest(const String &p_source_path, const String &p_output_path, const String &p_base_dir) {
+GDScriptTest::GDScriptTest(const String &p_source_path, const String &p_output_path, const String &p_base_dir, bool p_binary_tokens) {
 	source_file = p_source_path;
 	output_file = p_output_path;
 	base_dir = p_base_dir;
+	binary_tokens = p_binary_tokens;
 	_print_handler.printfunc = print_handler;
 	_error_handler.errfunc = error_handler;
 }
@@ -486,6 +488,18 @@ GDScriptTest::TestResult GDScriptTest::execute_test_code(bool p_is_generating) {
 	// Test parsing.
 	GDScriptParser parser;
 	err = parser.parse(script->get_source_code(), source_file, false);
+	if (err == OK && binary_tokens) {
+		// Parse again from the tokenized source. Errors are only checked with the source,
+		// as some (like indentation errors) are reported when tokenizing.
+		Vector<uint8_t> binary = GDScriptTokenizer::make_binary(script->get_source_code());
+		if (binary.is_empty()) {
+			enable_stdout();
+			result.status = GDTEST_PARSER_ERROR;
+			result.passed = false;
+			ERR_FAIL_V_MSG(result, "\nCould not tokenize source code for: '" + source_file + "'");
+		}
+		err = parser.parse_binary(binary, source_file);
+	}
 	if (err != OK) {
 		enable_stdout();
 		result.status = GDTEST_PARSER_ERROR;
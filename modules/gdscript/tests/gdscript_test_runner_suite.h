@@ -31,7 +31,14 @@
 #ifndef GDSCRIPT_TEST_RUNNER_SUITE_H
 #define GDSCRIPT_TEST_RUNNER_SUITE_H
 
+#include "../gdscript_cache.h"
+#include "../gdscript_parser.h"
+#include "../gdscript_sampling_profiler.h"
+#include "../gdscript_tokenizer.h"
 #include "gdscript_test_runner.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -47,6 +54,14 @@ TEST_SUITE("[Modules][GDScript]") {
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+	TEST_CASE("Script compilation and runtime from pre-tokenized scripts") {
+		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, true);
+		int fail_count = runner.run_tests();
+		INFO("Make sure `*.out` files have expected results.");
+		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass when pre-tokenized.");
+	}
 }
 
 TEST_CASE("[Modules][GDScript] Load source code dynamically and run it") {
@@ -70,6 +85,288 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Shared lambda callables keep their script alive") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+static func make_lambda():
+	return func(value): return value * 2
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Callable lambda = gdscript->call("make_lambda");
+	REQUIRE(lambda.is_valid());
+	CHECK_MESSAGE(Callable(gdscript->call("make_lambda")) == lambda, "Every evaluation of a non-capturing lambda should return the same callable.");
+
+	const ObjectID script_id = gdscript->get_instance_id();
+	gdscript.unref();
+	REQUIRE_MESSAGE(ObjectDB::get_instance(script_id) != nullptr, "The lambda should keep its script alive.");
+	const Variant argument = 21;
+	const Variant *arguments[1] = { &argument };
+	Variant result;
+	Callable::CallError call_error;
+	lambda.callp(arguments, 1, result, call_error);
+	CHECK(call_error.error == Callable::CallError::CALL_OK);
+	CHECK_MESSAGE(int(result) == 42, "The lambda should be callable after its script was released.");
+
+	lambda = Callable();
+	CHECK_MESSAGE(ObjectDB::get_instance(script_id) == nullptr, "The script should be freed with the last copy of the lambda.");
+}
+
+TEST_CASE("[Modules][GDScript] Pre-tokenized scripts") {
+	const String source = R"(func get_values(count):
+	var values = [
+			count,
+		count * 2,
+	]
+	return values
+)";
+	Vector<uint8_t> binary = GDScriptTokenizer::make_binary(source);
+	REQUIRE_FALSE(binary.is_empty());
+
+	// Whitespace tokens depend on the multiline mode, compare the rest.
+	GDScriptTokenizer from_source;
+	from_source.set_source_code(source);
+	from_source.set_multiline_mode(true);
+	GDScriptTokenizer from_binary;
+	REQUIRE(from_binary.set_binary(binary) == OK);
+	from_binary.set_multiline_mode(true);
+
+	for (;;) {
+		GDScriptTokenizer::Token expected = from_source.scan();
+		GDScriptTokenizer::Token token = from_binary.scan();
+		REQUIRE(token.type == expected.type);
+		if (expected.type == GDScriptTokenizer::Token::TK_EOF) {
+			break;
+		}
+		CHECK(token.start_line == expected.start_line);
+		CHECK(token.start_column == expected.start_column);
+		CHECK(token.end_column == expected.end_column);
+	}
+
+	Vector<uint8_t> other_version = binary;
+	other_version.write[4] += 1;
+	CHECK_MESSAGE(from_binary.set_binary(other_version) == ERR_FILE_UNRECOGNIZED, "Binary tokens of another version should be rejected.");
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_binary_tokens_source(binary);
+	CHECK_MESSAGE(gdscript->reload() == OK, "The script should compile from its binary tokens alone.");
+	CHECK_FALSE(gdscript->has_source_code());
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(GDScriptTokenizer::make_binary("func f():\n\t\tpass\n\tpass\n").is_empty(), "Indentation errors should fail tokenizing.");
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Modules][GDScript] Compile scripts as a batch") {
+	const String base_path = OS::get_singleton()->get_cache_path().path_join("gdscript_batch_base.gd");
+	const String derived_path = OS::get_singleton()->get_cache_path().path_join("gdscript_batch_derived.gd");
+
+	Ref<FileAccess> f = FileAccess::open(base_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string("extends RefCounted\n\nfunc get_value():\n\treturn 21\n");
+	f = FileAccess::open(derived_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(vformat("extends \"%s\"\n\nfunc get_value():\n\treturn super() * 2\n", base_path));
+	f.unref();
+
+	// The derived script comes first, the batch compiles its base before it anyway.
+	Vector<String> paths;
+	paths.push_back(derived_path);
+	paths.push_back(base_path);
+	CHECK_MESSAGE(GDScriptCache::compile_scripts(paths) == OK, "The scripts should compile successfully.");
+
+	Ref<GDScript> base = GDScriptCache::get_cached_script(base_path);
+	Ref<GDScript> derived = GDScriptCache::get_cached_script(derived_path);
+	REQUIRE(base.is_valid());
+	REQUIRE(derived.is_valid());
+	CHECK(base->is_valid());
+	CHECK(derived->is_valid());
+	CHECK(derived->get_base_script() == base);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(derived);
+	CHECK_MESSAGE(int(ref_counted->call("get_value")) == 42, "The derived script should call into its base.");
+
+	ref_counted.unref();
+	GDScriptCache::remove_script(derived_path);
+	GDScriptCache::remove_script(base_path);
+	DirAccess::remove_absolute(derived_path);
+	DirAccess::remove_absolute(base_path);
+}
+
+static void tick_sampling_profiler() {
+	GDScriptSamplingProfiler::tick();
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler attributes lines and native calls") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+signal ticked
+
+func on_line():
+	ticked.emit()
+
+func in_native():
+	emit_signal("ticked")
+
+func run():
+	on_line()
+	in_native()
+)");
+	REQUIRE(gdscript->reload() == OK);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	// Every emission takes exactly one sample, wherever the script is at.
+	ref_counted->connect("ticked", callable_mp_static(&tick_sampling_profiler));
+
+	Ref<GDScriptSamplingProfiler> profiler;
+	profiler.instantiate();
+	profiler->start(0);
+	// Outside of scripts, so it shouldn't be charged to anything.
+	GDScriptSamplingProfiler::tick();
+	ref_counted->call("run");
+	profiler->stop();
+
+	PackedStringArray stacks = profiler->get_collapsed_stacks().split("\n", false);
+	CHECK(stacks.size() == 2);
+	CHECK_MESSAGE(stacks.has("main;:run:13;:on_line:7 1"), "A sample taken while running a line should be charged to it.");
+	CHECK_MESSAGE(stacks.has("main;:run:14;:in_native:10;Object::emit_signal 1"), "A sample taken in a native call should be charged to the method.");
+
+	profiler.unref();
+	ref_counted.unref();
+}
+
+static void collect_scripts(const String &p_dir, PackedStringArray &r_paths) {
+	Ref<DirAccess> dir = DirAccess::open(p_dir);
+	if (dir.is_null()) {
+		return;
+	}
+	for (const String &file : dir->get_files()) {
+		if (file.get_extension() == "gd") {
+			r_paths.push_back(p_dir.path_join(file));
+		}
+	}
+	for (const String &subdir : dir->get_directories()) {
+		collect_scripts(p_dir.path_join(subdir), r_paths);
+	}
+}
+
+TEST_BENCHMARK("[Modules][GDScript] Load scripts from source and from binary tokens") {
+	// What an exported project reads for each script: the UTF-8 source, or the binary tokens replacing it.
+	PackedStringArray paths;
+	collect_scripts("modules/gdscript/tests/scripts", paths);
+
+	LocalVector<Vector<uint8_t>> sources;
+	LocalVector<Vector<uint8_t>> binaries;
+	uint64_t source_size = 0;
+	uint64_t binary_size = 0;
+	ERR_PRINT_OFF;
+	for (const String &path : paths) {
+		// Scripts testing errors aren't loaded by exported projects.
+		String source = FileAccess::get_file_as_string(path);
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(source);
+		if (gdscript->reload() != OK) {
+			continue;
+		}
+		Vector<uint8_t> binary = GDScriptTokenizer::make_binary(source);
+		if (binary.is_empty()) {
+			continue;
+		}
+		sources.push_back(FileAccess::get_file_as_bytes(path));
+		binaries.push_back(binary);
+		source_size += sources[sources.size() - 1].size();
+		binary_size += binary.size();
+	}
+	ERR_PRINT_ON;
+	REQUIRE_FALSE(sources.is_empty());
+
+	const int rounds = 10;
+	uint64_t parse_source_usec = 0;
+	uint64_t parse_binary_usec = 0;
+	uint64_t load_source_usec = 0;
+	uint64_t load_binary_usec = 0;
+	ERR_PRINT_OFF;
+	for (int round = 0; round < rounds; round++) {
+		for (uint32_t i = 0; i < sources.size(); i++) {
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			{
+				String source;
+				source.parse_utf8((const char *)sources[i].ptr(), sources[i].size());
+				GDScriptParser parser;
+				CHECK(parser.parse(source, String(), false) == OK);
+			}
+			parse_source_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			{
+				GDScriptParser parser;
+				CHECK(parser.parse_binary(binaries[i], String()) == OK);
+			}
+			parse_binary_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			// Parsing, analysis and compilation, as done for each script on startup.
+			begin = OS::get_singleton()->get_ticks_usec();
+			{
+				String source;
+				source.parse_utf8((const char *)sources[i].ptr(), sources[i].size());
+				Ref<GDScript> gdscript = memnew(GDScript);
+				gdscript->set_source_code(source);
+				CHECK(gdscript->reload() == OK);
+			}
+			load_source_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			{
+				Ref<GDScript> gdscript = memnew(GDScript);
+				gdscript->set_binary_tokens_source(binaries[i]);
+				CHECK(gdscript->reload() == OK);
+			}
+			load_binary_usec += OS::get_singleton()->get_ticks_usec() - begin;
+		}
+	}
+	ERR_PRINT_ON;
+
+	MESSAGE(vformat("%d scripts, %d bytes of source, %d bytes of binary tokens.", sources.size(), source_size, binary_size));
+	MESSAGE(vformat("Parse: %d usec from source, %d usec from binary tokens.", parse_source_usec / rounds, parse_binary_usec / rounds));
+	MESSAGE(vformat("Load: %d usec from source, %d usec from binary tokens.", load_source_usec / rounds, load_binary_usec / rounds));
+}
+
+TEST_BENCHMARK("[Modules][GDScript] Tight loops in the VM") {
+	const String benchmarks_path = "modules/gdscript/tests/benchmarks";
+	Ref<DirAccess> dir = DirAccess::open(benchmarks_path);
+	REQUIRE(dir.is_valid());
+
+	PackedStringArray files = dir->get_files();
+	files.sort();
+	for (const String &file : files) {
+		if (file.get_extension() != "gd") {
+			continue;
+		}
+
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(FileAccess::get_file_as_string(benchmarks_path.path_join(file)));
+		REQUIRE_MESSAGE(gdscript->reload() == OK, vformat("\"%s\" should compile.", file));
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		ref_counted->call("benchmark");
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%s: %d usec.", file, elapsed));
+	}
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,61 @@
+class Walker:
+	var speed = 1
+	var steps := 0
+	var energy: float = 10.0:
+		set(value):
+			energy = clampf(value, 0.0, 10.0)
+
+	func move():
+		steps += speed
+		return "walk"
+
+class Runner extends Walker:
+	func _init():
+		speed = 3
+
+	func move():
+		steps += speed * 2
+		return "run"
+
+class Flier:
+	var speed = 5
+	var steps := 0
+	var energy: float = 10.0
+
+	func move():
+		steps += speed
+		return "fly"
+
+class Named:
+	var resource_name = "script"
+
+	func get_name():
+		return "named"
+
+func test():
+	var agents = [Walker.new(), Runner.new(), Flier.new(), Walker.new()]
+	for i in 3:
+		for agent in agents:
+			agent.move()
+			agent.energy -= 4
+	for agent in agents:
+		print(agent.move(), " ", agent.steps, " ", agent.energy)
+
+	# Needs a conversion to the member type.
+	for agent in agents:
+		agent.energy = 5
+	print(typeof(agents[2].energy) == TYPE_FLOAT, " ", agents[2].energy)
+
+	var named = [Resource.new(), Named.new(), Resource.new()]
+	for i in named.size():
+		named[i].resource_name = str(i)
+	for thing in named:
+		print(thing.resource_name, " ", thing.get_name())
+
+	# More receiver types than a call site keeps.
+	var things = [Walker.new(), Flier.new(), Named.new(), Resource.new(), RefCounted.new(), Gradient.new()]
+	var classes = []
+	for i in 2:
+		for thing in things:
+			classes.append(thing.get_class())
+	print(classes)
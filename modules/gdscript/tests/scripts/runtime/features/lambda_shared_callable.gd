@@ -0,0 +1,43 @@
+# Non-capturing lambdas share one callable across evaluations,
+# the others still get a new callable every time.
+
+var offset = 100
+
+func make_double():
+	return func(x): return x * 2
+
+func make_adder(amount):
+	return func(x): return x + amount
+
+func test():
+	var double_a = make_double()
+	var double_b = make_double()
+	print(double_a == double_b)
+	print(double_a.call(21))
+
+	var add_one = make_adder(1)
+	var add_two = make_adder(2)
+	print(add_one == make_adder(1))
+	print(add_one.call(1), " ", add_two.call(1))
+
+	var with_self_a = func(x): return x + offset
+	var with_self_b = func(x): return x + offset
+	print(with_self_a == with_self_b)
+	print(with_self_a.call(1))
+
+	var values = [5, 3, 8, 1]
+	print(values.map(make_double()))
+	print(values.map(make_adder(10)))
+	print(values.filter(func(x): return x > 4))
+	var limit = 4
+	print(values.filter(func(x): return x <= limit))
+	print(values.reduce(func(accum, x): return accum + x, 0))
+	var factor = 2
+	print(values.reduce(func(accum, x): return accum + x * factor, 0))
+
+	var sorted = values.duplicate()
+	sorted.sort_custom(func(a, b): return a > b)
+	print(sorted)
+	var pivot = 6
+	sorted.sort_custom(func(a, b): return absi(a - pivot) < absi(b - pivot))
+	print(sorted)
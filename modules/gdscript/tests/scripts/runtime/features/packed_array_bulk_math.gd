@@ -0,0 +1,42 @@
+func test():
+	var floats := PackedFloat32Array([1.0, -2.0, 3.0, 4.5, 0.5])
+	floats.add_value(1.0)
+	print(floats)
+	floats.scale(2.0)
+	print(floats)
+	floats.add_elements(PackedFloat32Array([1.0, 1.0, 1.0, 1.0, 1.0]))
+	print(floats)
+	floats.multiply_elements(PackedFloat32Array([1.0, -1.0, -1.0, 0.5, 2.0]))
+	print(floats)
+	floats.lerp_elements(PackedFloat32Array([0.0, 4.0, 0.0, 0.0, 0.0]), 0.5)
+	print(floats)
+	floats.clamp_elements(-2.0, 2.0)
+	print(floats)
+	print(floats.sum(), " ", floats.min(), " ", floats.max())
+	print(floats.dot(PackedFloat32Array([1.0, 1.0, 1.0, 1.0, 1.0])))
+	print(PackedFloat32Array().sum())
+
+	var points := PackedVector2Array([Vector2(3, 4), Vector2(-1, 0), Vector2(0, 2)])
+	points.add_value(Vector2(1, 1))
+	print(points)
+	points.scale(0.5)
+	print(points)
+	points.transform(Transform2D(0, Vector2(10, 0)))
+	print(points)
+	print(points.sum())
+	print(PackedVector2Array([Vector2(3, 4), Vector2(0, 2)]).lengths())
+	print(PackedVector2Array([Vector2(1, 2), Vector2(3, 4)]).dots(PackedVector2Array([Vector2(1, 1), Vector2(0, 2)])))
+
+	var positions := PackedVector3Array([Vector3(1, 2, 3), Vector3(-4, 5, -6)])
+	positions.clamp_elements(Vector3(-2, -2, -2), Vector3(2, 2, 2))
+	print(positions)
+	positions.transform(Transform3D(Basis(), Vector3(0, 0, 1)))
+	print(positions)
+	print(positions.sum())
+
+	var colors := PackedColorArray([Color(0, 0, 0, 1), Color(1, 1, 1, 1)])
+	colors.lerp_elements(PackedColorArray([Color(1, 1, 1, 1), Color(0, 0, 0, 1)]), 0.25)
+	print(colors)
+	colors.multiply_elements(PackedColorArray([Color(2, 2, 2, 1), Color(1, 0, 1, 1)]))
+	colors.clamp_elements(Color(0, 0, 0, 0), Color(1, 1, 1, 1))
+	print(colors)
@@ -0,0 +1,34 @@
+func test():
+	var ints: Array[int] = [1, 2, 3, 4]
+	var int_sum := 0
+	for i in ints:
+		int_sum += i
+	print(int_sum)
+
+	var floats: Array[float] = [0.5, 1.5, 2.0]
+	var float_sum := 0.0
+	for f in floats:
+		float_sum += f
+	print(float_sum)
+
+	var empty: Array[int] = []
+	for i in empty:
+		print("unreachable")
+
+	var packed := PackedFloat32Array([1.0, 2.0, 3.0])
+	packed[0] = packed[1] * 2.0
+	packed[-1] = 0.25
+	print(packed)
+
+	var bytes := PackedByteArray([1, 2, 3])
+	bytes[1] = bytes[2] + 250
+	print(bytes[1])
+	print(bytes[-1])
+
+	var a := 7
+	var b := 3
+	print(a + b, " ", a - b, " ", a * b, " ", a < b, " ", a >= b, " ", a == b, " ", a != b)
+
+	var x := 1.5
+	var y := 0.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y, " ", x <= y, " ", x > y)
@@ -40,7 +40,8 @@
 // Version 3: new string ID for ext/subresources, breaks forward compat.
 #define FORMAT_VERSION 3
 
-#define BINARY_FORMAT_VERSION 4
+// Binary resource format version written when converting, must match the packed array encoding of ResourceFormatSaverBinaryInstance.
+#define BINARY_FORMAT_VERSION 6
 
 #include "core/io/dir_access.h"
 #include "core/version.h"
@@ -673,6 +674,11 @@ Error ResourceLoaderText::load() {
 		if (!missing_resource_properties.is_empty()) {
 			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
 		}
+
+		if (do_assign && !missing_resource && cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceLoader::is_sharing_subresources()) {
+			res = ResourceLoader::get_shared_subresource(res);
+			int_resources[id] = res;
+		}
 	}
 
 	while (true) {
@@ -1166,6 +1172,7 @@ Error ResourceLoaderText::save_as_binary(const String &p_path) {
 
 	//go with external resources
 
+	ResourceFormatSaverBinaryInstance binary_saver;
 	DummyReadData dummy_read;
 	VariantParser::ResourceParser rp_new;
 	rp_new.ext_func = _parse_ext_resource_dummys;
@@ -1312,7 +1319,7 @@ Error ResourceLoaderText::save_as_binary(const String &p_path) {
 				if (!assign.is_empty()) {
 					HashMap<StringName, int> empty_string_map; //unused
 					bs_save_unicode_string(wf2, assign, true);
-					ResourceFormatSaverBinaryInstance::write_variant(wf2, value, dummy_read.resource_index_map, dummy_read.external_resources, empty_string_map);
+					binary_saver.write_variant(wf2, value, dummy_read.resource_index_map, dummy_read.external_resources, empty_string_map);
 					prop_count++;
 
 				} else if (!next_tag.name.is_empty()) {
@@ -1374,7 +1381,7 @@ Error ResourceLoaderText::save_as_binary(const String &p_path) {
 
 				HashMap<StringName, int> empty_string_map; //unused
 				bs_save_unicode_string(wf2, name, true);
-				ResourceFormatSaverBinaryInstance::write_variant(wf2, value, dummy_read.resource_index_map, dummy_read.external_resources, empty_string_map);
+				binary_saver.write_variant(wf2, value, dummy_read.resource_index_map, dummy_read.external_resources, empty_string_map);
 				prop_count++;
 			}
 
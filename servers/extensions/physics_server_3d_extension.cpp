@@ -160,6 +160,9 @@ void PhysicsServer3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_set_param, "space", "param", "value");
 	GDVIRTUAL_BIND(_space_get_param, "space", "param");
 
+	GDVIRTUAL_BIND(_space_save_state, "space");
+	GDVIRTUAL_BIND(_space_restore_state, "space", "state");
+
 	GDVIRTUAL_BIND(_space_get_direct_state, "space");
 
 	GDVIRTUAL_BIND(_space_set_debug_contacts, "space", "max_contacts");
@@ -236,6 +236,9 @@ public:
 	EXBIND3(space_set_param, RID, SpaceParameter, real_t)
 	EXBIND2RC(real_t, space_get_param, RID, SpaceParameter)
 
+	EXBIND1R(PackedByteArray, space_save_state, RID)
+	EXBIND2R(Error, space_restore_state, RID, const PackedByteArray &)
+
 	EXBIND1R(PhysicsDirectSpaceState3D *, space_get_direct_state, RID)
 
 	EXBIND2(space_set_debug_contacts, RID, int)
@@ -34,6 +34,8 @@
 #include "godot_body_direct_state_2d.h"
 #include "godot_space_2d.h"
 
+#include "servers/physics_state_buffer.h"
+
 void GodotBody2D::_mass_properties_changed() {
 	if (get_space() && !mass_properties_update_list.in_list() && (calculate_inertia || calculate_center_of_mass)) {
 		get_space()->body_add_to_mass_properties_update_list(&mass_properties_update_list);
@@ -734,6 +736,99 @@ void GodotBody2D::set_force_integration_callback(const Callable &p_callable, con
 	}
 }
 
+void GodotBody2D::SavedState::write(PhysicsStateWriter &p_writer) const {
+	p_writer.put_transform_2d(transform);
+	p_writer.put_transform_2d(inv_transform);
+	p_writer.put_transform_2d(new_transform);
+	p_writer.put_vector2(linear_velocity);
+	p_writer.put_real(angular_velocity);
+	p_writer.put_vector2(prev_linear_velocity);
+	p_writer.put_real(prev_angular_velocity);
+	p_writer.put_vector2(constant_linear_velocity);
+	p_writer.put_real(constant_angular_velocity);
+	p_writer.put_vector2(applied_force);
+	p_writer.put_real(applied_torque);
+	p_writer.put_vector2(constant_force);
+	p_writer.put_real(constant_torque);
+	p_writer.put_real(still_time);
+	p_writer.put_bool(active);
+	p_writer.put_u32(shape_aabbs.size());
+	for (const Rect2 &aabb : shape_aabbs) {
+		p_writer.put_rect2(aabb);
+	}
+}
+
+void GodotBody2D::SavedState::read(PhysicsStateReader &p_reader) {
+	transform = p_reader.get_transform_2d();
+	inv_transform = p_reader.get_transform_2d();
+	new_transform = p_reader.get_transform_2d();
+	linear_velocity = p_reader.get_vector2();
+	angular_velocity = p_reader.get_real();
+	prev_linear_velocity = p_reader.get_vector2();
+	prev_angular_velocity = p_reader.get_real();
+	constant_linear_velocity = p_reader.get_vector2();
+	constant_angular_velocity = p_reader.get_real();
+	applied_force = p_reader.get_vector2();
+	applied_torque = p_reader.get_real();
+	constant_force = p_reader.get_vector2();
+	constant_torque = p_reader.get_real();
+	still_time = p_reader.get_real();
+	active = p_reader.get_bool();
+	shape_aabbs.resize(p_reader.get_count(sizeof(real_t) * 4));
+	for (Rect2 &aabb : shape_aabbs) {
+		aabb = p_reader.get_rect2();
+	}
+}
+
+void GodotBody2D::save_state(SavedState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.constant_linear_velocity = constant_linear_velocity;
+	r_state.constant_angular_velocity = constant_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_force = constant_force;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+
+	r_state.shape_aabbs.resize(get_shape_count());
+	for (int i = 0; i < get_shape_count(); i++) {
+		r_state.shape_aabbs[i] = get_shape_aabb(i);
+	}
+}
+
+void GodotBody2D::restore_state(const SavedState &p_state) {
+	// The space rebuilds its broadphase from the restored shape AABBs afterwards.
+	_set_transform(p_state.transform, false);
+	_set_inv_transform(p_state.inv_transform);
+	_update_transform_dependent();
+
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	constant_linear_velocity = p_state.constant_linear_velocity;
+	constant_angular_velocity = p_state.constant_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+
+	for (uint32_t i = 0; i < p_state.shape_aabbs.size(); i++) {
+		set_shape_aabb(i, p_state.shape_aabbs[i]);
+	}
+
+	set_active(p_state.active);
+}
+
 GodotPhysicsDirectBodyState2D *GodotBody2D::get_direct_state() {
 	if (!direct_state) {
 		direct_state = memnew(GodotPhysicsDirectBodyState2D);
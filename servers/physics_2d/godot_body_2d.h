@@ -40,6 +40,8 @@
 
 class GodotConstraint2D;
 class GodotPhysicsDirectBodyState2D;
+class PhysicsStateReader;
+class PhysicsStateWriter;
 
 class GodotBody2D : public GodotCollisionObject2D {
 	PhysicsServer2D::BodyMode mode = PhysicsServer2D::BODY_MODE_RIGID;
@@ -156,6 +158,32 @@ class GodotBody2D : public GodotCollisionObject2D {
 	friend class GodotPhysicsDirectBodyState2D; // i give up, too many functions to expose
 
 public:
+	// Dynamic state saved by GodotSpace2D::save_state(), everything else is considered configuration.
+	struct SavedState {
+		Transform2D transform;
+		Transform2D inv_transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 prev_linear_velocity;
+		real_t prev_angular_velocity = 0.0;
+		Vector2 constant_linear_velocity;
+		real_t constant_angular_velocity = 0.0;
+		Vector2 applied_force;
+		real_t applied_torque = 0.0;
+		Vector2 constant_force;
+		real_t constant_torque = 0.0;
+		real_t still_time = 0.0;
+		bool active = false;
+		LocalVector<Rect2> shape_aabbs;
+
+		void write(PhysicsStateWriter &p_writer) const;
+		void read(PhysicsStateReader &p_reader);
+	};
+
+	void save_state(SavedState &r_state) const;
+	void restore_state(const SavedState &p_state);
+
 	void set_state_sync_callback(const Callable &p_callable);
 	void set_force_integration_callback(const Callable &p_callable, const Variant &p_udata = Variant());
 
@@ -33,6 +33,8 @@
 #include "godot_collision_solver_2d.h"
 #include "godot_space_2d.h"
 
+#include "servers/physics_state_buffer.h"
+
 #define ACCUMULATE_IMPULSES
 
 #define MIN_VELOCITY 0.001
@@ -587,8 +589,103 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair2D::SavedState::write(PhysicsStateWriter &p_writer) const {
+	p_writer.put_vector2(offset_B);
+	p_writer.put_vector2(sep_axis);
+	p_writer.put_bool(collided);
+	p_writer.put_bool(check_ccd);
+	p_writer.put_bool(oneway_disabled);
+	p_writer.put_u32(contact_count);
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		p_writer.put_vector2(c.position);
+		p_writer.put_vector2(c.normal);
+		p_writer.put_vector2(c.local_A);
+		p_writer.put_vector2(c.local_B);
+		p_writer.put_vector2(c.acc_impulse);
+		p_writer.put_real(c.acc_normal_impulse);
+		p_writer.put_real(c.acc_tangent_impulse);
+		p_writer.put_real(c.acc_bias_impulse);
+		p_writer.put_real(c.acc_bias_impulse_center_of_mass);
+		p_writer.put_real(c.mass_normal);
+		p_writer.put_real(c.mass_tangent);
+		p_writer.put_real(c.bias);
+		p_writer.put_real(c.depth);
+		p_writer.put_bool(c.active);
+		p_writer.put_bool(c.used);
+		p_writer.put_vector2(c.rA);
+		p_writer.put_vector2(c.rB);
+		p_writer.put_real(c.bounce);
+	}
+}
+
+void GodotBodyPair2D::SavedState::read(PhysicsStateReader &p_reader) {
+	offset_B = p_reader.get_vector2();
+	sep_axis = p_reader.get_vector2();
+	collided = p_reader.get_bool();
+	check_ccd = p_reader.get_bool();
+	oneway_disabled = p_reader.get_bool();
+	contact_count = MIN(p_reader.get_u32(), (uint32_t)MAX_CONTACTS);
+	for (int i = 0; i < contact_count; i++) {
+		Contact &c = contacts[i];
+		c.position = p_reader.get_vector2();
+		c.normal = p_reader.get_vector2();
+		c.local_A = p_reader.get_vector2();
+		c.local_B = p_reader.get_vector2();
+		c.acc_impulse = p_reader.get_vector2();
+		c.acc_normal_impulse = p_reader.get_real();
+		c.acc_tangent_impulse = p_reader.get_real();
+		c.acc_bias_impulse = p_reader.get_real();
+		c.acc_bias_impulse_center_of_mass = p_reader.get_real();
+		c.mass_normal = p_reader.get_real();
+		c.mass_tangent = p_reader.get_real();
+		c.bias = p_reader.get_real();
+		c.depth = p_reader.get_real();
+		c.active = p_reader.get_bool();
+		c.used = p_reader.get_bool();
+		c.rA = p_reader.get_vector2();
+		c.rB = p_reader.get_vector2();
+		c.bounce = p_reader.get_real();
+	}
+}
+
+void GodotBodyPair2D::save_state(SavedState &r_state) const {
+	r_state.offset_B = offset_B;
+	r_state.sep_axis = sep_axis;
+	r_state.collided = collided;
+	r_state.check_ccd = check_ccd;
+	r_state.oneway_disabled = oneway_disabled;
+	r_state.contact_count = contact_count;
+	for (int i = 0; i < contact_count; i++) {
+		r_state.contacts[i] = contacts[i];
+	}
+}
+
+void GodotBodyPair2D::restore_state(const SavedState &p_state) {
+	offset_B = p_state.offset_B;
+	sep_axis = p_state.sep_axis;
+	collided = p_state.collided;
+	check_ccd = p_state.check_ccd;
+	oneway_disabled = p_state.oneway_disabled;
+	contact_count = p_state.contact_count;
+	for (int i = 0; i < contact_count; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+}
+
+void GodotBodyPair2D::reset_state() {
+	// Same as a newly created pair.
+	offset_B = Vector2();
+	sep_axis = Vector2();
+	collided = false;
+	check_ccd = false;
+	oneway_disabled = false;
+	contact_count = 0;
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
-		GodotConstraint2D(_arr, 2) {
+		GodotConstraint2D(_arr, 2),
+		space_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
@@ -596,9 +693,11 @@ GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p
 	space = A->get_space();
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
+	space->body_pair_add_to_list(&space_list);
 }
 
 GodotBodyPair2D::~GodotBodyPair2D() {
 	A->remove_constraint(this, 0);
 	B->remove_constraint(this, 1);
+	space->body_pair_remove_from_list(&space_list);
 }
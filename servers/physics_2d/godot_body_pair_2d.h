@@ -34,6 +34,11 @@
 #include "godot_body_2d.h"
 #include "godot_constraint_2d.h"
 
+#include "core/templates/self_list.h"
+
+class PhysicsStateReader;
+class PhysicsStateWriter;
+
 class GodotBodyPair2D : public GodotConstraint2D {
 	enum {
 		MAX_CONTACTS = 2
@@ -84,12 +89,37 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	bool oneway_disabled = false;
 	bool report_contacts_only = false;
 
+	SelfList<GodotBodyPair2D> space_list;
+
 	bool _test_ccd(real_t p_step, GodotBody2D *p_A, int p_shape_A, const Transform2D &p_xform_A, GodotBody2D *p_B, int p_shape_B, const Transform2D &p_xform_B);
 	void _validate_contacts();
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	// Contacts and accumulated impulses, saved by GodotSpace2D::save_state() to warm start the solver after a restore.
+	struct SavedState {
+		Vector2 offset_B;
+		Vector2 sep_axis;
+		bool collided = false;
+		bool check_ccd = false;
+		bool oneway_disabled = false;
+		int contact_count = 0;
+		Contact contacts[MAX_CONTACTS];
+
+		void write(PhysicsStateWriter &p_writer) const;
+		void read(PhysicsStateReader &p_reader);
+	};
+
+	void save_state(SavedState &r_state) const;
+	void restore_state(const SavedState &p_state);
+	void reset_state();
+
+	_FORCE_INLINE_ GodotBody2D *get_body_A() const { return A; }
+	_FORCE_INLINE_ GodotBody2D *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -157,6 +157,20 @@ void GodotCollisionObject2D::_unregister_shapes() {
 	}
 }
 
+void GodotCollisionObject2D::add_to_broadphase() {
+	ERR_FAIL_NULL(space);
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		if (s.disabled || s.bpid != 0) {
+			continue;
+		}
+
+		s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
+		space->get_broadphase()->set_static(s.bpid, _static);
+	}
+}
+
 void GodotCollisionObject2D::_update_shapes() {
 	if (!space) {
 		return;
@@ -258,6 +258,22 @@ real_t GodotPhysicsServer2D::space_get_param(RID p_space, SpaceParameter p_param
 	return space->get_param(p_param);
 }
 
+PackedByteArray GodotPhysicsServer2D::space_save_state(RID p_space) {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), PackedByteArray(), "Space state can't be saved while the space is being stepped.");
+
+	return space->save_state();
+}
+
+Error GodotPhysicsServer2D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(space->is_locked(), ERR_BUSY, "Space state can't be restored while the space is being stepped.");
+
+	return space->restore_state(p_state);
+}
+
 void GodotPhysicsServer2D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_COND(!space);
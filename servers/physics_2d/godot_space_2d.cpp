@@ -35,10 +35,13 @@
 
 #include "core/os/os.h"
 #include "core/templates/pair.h"
+#include "servers/physics_state_buffer.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
+#define SPACE_STATE_MAGIC 0x32535047 // "GPS2"
+
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject2D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
 		return false;
@@ -1034,6 +1037,11 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 		}
 
 	} else {
+		// Keep the same order whatever the broadphase reports, so the pair solves the same after a state restore.
+		if (B->get_self().get_id() < A->get_self().get_id()) {
+			SWAP(A, B);
+			SWAP(p_subindex_A, p_subindex_B);
+		}
 		GodotBodyPair2D *b = memnew(GodotBodyPair2D(static_cast<GodotBody2D *>(A), p_subindex_A, static_cast<GodotBody2D *>(B), p_subindex_B));
 		return b;
 	}
@@ -1074,6 +1082,38 @@ GodotBroadPhase2D *GodotSpace2D::get_broadphase() {
 	return broadphase;
 }
 
+void GodotSpace2D::rebuild_broadphase() {
+	// Removing the shapes first frees all the pairs through the unpair callback.
+	LocalVector<GodotCollisionObject2D *> sorted_objects;
+	for (GodotCollisionObject2D *E : objects) {
+		E->remove_from_broadphase();
+		sorted_objects.push_back(E);
+	}
+
+	memdelete(broadphase);
+	broadphase = GodotBroadPhase2D::create_func();
+	broadphase->set_pair_callback(_broadphase_pair, this);
+	broadphase->set_unpair_callback(_broadphase_unpair, this);
+
+	sorted_objects.sort_custom<PhysicsStateRIDSort>();
+	for (GodotCollisionObject2D *E : sorted_objects) {
+		E->add_to_broadphase();
+	}
+	broadphase->update();
+
+	// The next step would only find the area overlaps again after applying gravity and damping to the bodies.
+	for (GodotCollisionObject2D *E : sorted_objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_AREA) {
+			continue;
+		}
+		for (GodotConstraint2D *constraint : static_cast<GodotArea2D *>(E)->get_constraints()) {
+			if (constraint->setup(0.0)) {
+				constraint->pre_solve(0.0);
+			}
+		}
+	}
+}
+
 void GodotSpace2D::add_object(GodotCollisionObject2D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
@@ -1096,6 +1136,14 @@ void GodotSpace2D::body_remove_from_state_query_list(SelfList<GodotBody2D> *p_bo
 	state_query_list.remove(p_body);
 }
 
+void GodotSpace2D::body_pair_add_to_list(SelfList<GodotBodyPair2D> *p_body_pair) {
+	body_pair_list.add(p_body_pair);
+}
+
+void GodotSpace2D::body_pair_remove_from_list(SelfList<GodotBodyPair2D> *p_body_pair) {
+	body_pair_list.remove(p_body_pair);
+}
+
 void GodotSpace2D::area_add_to_monitor_query_list(SelfList<GodotArea2D> *p_area) {
 	monitor_query_list.add(p_area);
 }
@@ -1215,6 +1263,14 @@ GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 	return direct_access;
 }
 
+PackedByteArray GodotSpace2D::save_state() const {
+	return PhysicsSpaceState<GodotSpace2D, GodotCollisionObject2D, GodotBody2D, GodotBodyPair2D>::save(this, SPACE_STATE_MAGIC);
+}
+
+Error GodotSpace2D::restore_state(const PackedByteArray &p_state) {
+	return PhysicsSpaceState<GodotSpace2D, GodotCollisionObject2D, GodotBody2D, GodotBodyPair2D>::restore(this, SPACE_STATE_MAGIC, p_state);
+}
+
 GodotSpace2D::GodotSpace2D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_angular");
@@ -90,6 +90,13 @@ void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep2D::_pre_solve_islands(uint32_t p_island_count) {
+	setup_constraints_endtime = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		_pre_solve_island(constraint_islands[island_index]);
+	}
+}
+
 void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const {
 	const LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[p_island_index];
 
@@ -237,35 +244,33 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	// Setup, pre-solve and solve are submitted at once as a task graph, so this thread only blocks once.
+
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
-	}
+	WorkerThreadPool::GroupID setup_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
-	}
+	// Warning: This runs as a single task, because it involves thread-unsafe processing.
+	WorkerThreadPool::TaskID pre_solve_task = WorkerThreadPool::get_singleton()->add_template_dependent_task({ setup_task }, this, &GodotStep2D::_pre_solve_islands, island_count, SNAME("Physics2DConstraintPreSolveIslands"));
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	WorkerThreadPool::GroupID solve_task = WorkerThreadPool::get_singleton()->add_template_dependent_group_task({ pre_solve_task }, this, &GodotStep2D::_solve_island, nullptr, island_count, -1, SNAME("Physics2DConstraintSolveIslands"));
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(solve_task);
+	// Both already completed, this only releases them.
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(setup_task);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(pre_solve_task);
 
 	{ //profile
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS, setup_constraints_endtime - profile_begtime);
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - setup_constraints_endtime);
 		profile_begtime = profile_endtime;
 	}
 
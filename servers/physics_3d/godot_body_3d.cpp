@@ -34,6 +34,8 @@
 #include "godot_body_direct_state_3d.h"
 #include "godot_space_3d.h"
 
+#include "servers/physics_state_buffer.h"
+
 void GodotBody3D::_mass_properties_changed() {
 	if (get_space() && !mass_properties_update_list.in_list() && (calculate_inertia || calculate_center_of_mass)) {
 		get_space()->body_add_to_mass_properties_update_list(&mass_properties_update_list);
@@ -662,22 +664,24 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_angular_velocity = Vector3();
 	biased_linear_velocity = Vector3();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
-	}
+	integrated_motion = motion;
+	integrated_motion_pending = do_motion;
 
 	contact_count = 0;
 }
 
+void GodotBody3D::finish_integrate_forces() {
+	if (integrated_motion_pending) { //shapes temporarily extend for raycast
+		_update_shapes_with_motion(integrated_motion);
+		integrated_motion_pending = false;
+	}
+}
+
 void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
 	}
 
-	if (fi_callback_data || body_state_callback.get_object()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PhysicsServer3D::BodyAxis)(1 << i))) {
@@ -695,13 +699,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	}
 
 	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
-		_set_transform(new_transform, false);
-		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
-		}
-
-		return;
+		return; // Moves to new_transform in finish_integrate_velocities().
 	}
 
 	Vector3 total_angular_velocity = angular_velocity + biased_angular_velocity;
@@ -727,7 +725,29 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	integrated_transform = transform_new;
+}
+
+void GodotBody3D::finish_integrate_velocities() {
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback.get_object()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
+		_set_transform(new_transform, false);
+		_set_inv_transform(new_transform.affine_inverse());
+		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
+			set_active(false); //stopped moving, deactivate
+		}
+
+		return;
+	}
+
+	_set_transform(integrated_transform);
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependent();
@@ -813,6 +833,99 @@ void GodotBody3D::set_force_integration_callback(const Callable &p_callable, con
 	}
 }
 
+void GodotBody3D::SavedState::write(PhysicsStateWriter &p_writer) const {
+	p_writer.put_transform_3d(transform);
+	p_writer.put_transform_3d(inv_transform);
+	p_writer.put_transform_3d(new_transform);
+	p_writer.put_vector3(linear_velocity);
+	p_writer.put_vector3(angular_velocity);
+	p_writer.put_vector3(prev_linear_velocity);
+	p_writer.put_vector3(prev_angular_velocity);
+	p_writer.put_vector3(constant_linear_velocity);
+	p_writer.put_vector3(constant_angular_velocity);
+	p_writer.put_vector3(applied_force);
+	p_writer.put_vector3(applied_torque);
+	p_writer.put_vector3(constant_force);
+	p_writer.put_vector3(constant_torque);
+	p_writer.put_real(still_time);
+	p_writer.put_bool(active);
+	p_writer.put_u32(shape_aabbs.size());
+	for (const AABB &aabb : shape_aabbs) {
+		p_writer.put_aabb(aabb);
+	}
+}
+
+void GodotBody3D::SavedState::read(PhysicsStateReader &p_reader) {
+	transform = p_reader.get_transform_3d();
+	inv_transform = p_reader.get_transform_3d();
+	new_transform = p_reader.get_transform_3d();
+	linear_velocity = p_reader.get_vector3();
+	angular_velocity = p_reader.get_vector3();
+	prev_linear_velocity = p_reader.get_vector3();
+	prev_angular_velocity = p_reader.get_vector3();
+	constant_linear_velocity = p_reader.get_vector3();
+	constant_angular_velocity = p_reader.get_vector3();
+	applied_force = p_reader.get_vector3();
+	applied_torque = p_reader.get_vector3();
+	constant_force = p_reader.get_vector3();
+	constant_torque = p_reader.get_vector3();
+	still_time = p_reader.get_real();
+	active = p_reader.get_bool();
+	shape_aabbs.resize(p_reader.get_count(sizeof(real_t) * 6));
+	for (AABB &aabb : shape_aabbs) {
+		aabb = p_reader.get_aabb();
+	}
+}
+
+void GodotBody3D::save_state(SavedState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.constant_linear_velocity = constant_linear_velocity;
+	r_state.constant_angular_velocity = constant_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_force = constant_force;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+
+	r_state.shape_aabbs.resize(get_shape_count());
+	for (int i = 0; i < get_shape_count(); i++) {
+		r_state.shape_aabbs[i] = get_shape_aabb(i);
+	}
+}
+
+void GodotBody3D::restore_state(const SavedState &p_state) {
+	// The space rebuilds its broadphase from the restored shape AABBs afterwards.
+	_set_transform(p_state.transform, false);
+	_set_inv_transform(p_state.inv_transform);
+	_update_transform_dependent();
+
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	constant_linear_velocity = p_state.constant_linear_velocity;
+	constant_angular_velocity = p_state.constant_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+
+	for (uint32_t i = 0; i < p_state.shape_aabbs.size(); i++) {
+		set_shape_aabb(i, p_state.shape_aabbs[i]);
+	}
+
+	set_active(p_state.active);
+}
+
 GodotPhysicsDirectBodyState3D *GodotBody3D::get_direct_state() {
 	if (!direct_state) {
 		direct_state = memnew(GodotPhysicsDirectBodyState3D);
@@ -38,6 +38,8 @@
 
 class GodotConstraint3D;
 class GodotPhysicsDirectBodyState3D;
+class PhysicsStateReader;
+class PhysicsStateWriter;
 
 class GodotBody3D : public GodotCollisionObject3D {
 	PhysicsServer3D::BodyMode mode = PhysicsServer3D::BODY_MODE_RIGID;
@@ -112,6 +114,11 @@ class GodotBody3D : public GodotCollisionObject3D {
 	virtual void _shapes_changed() override;
 	Transform3D new_transform;
 
+	// Results of integrate_forces() and integrate_velocities(), applied by their finish_*() counterpart.
+	Vector3 integrated_motion;
+	bool integrated_motion_pending = false;
+	Transform3D integrated_transform;
+
 	HashMap<GodotConstraint3D *, int> constraint_map;
 
 	Vector<AreaCMP> areas;
@@ -150,6 +157,32 @@ class GodotBody3D : public GodotCollisionObject3D {
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
 
 public:
+	// Dynamic state saved by GodotSpace3D::save_state(), everything else is considered configuration.
+	struct SavedState {
+		Transform3D transform;
+		Transform3D inv_transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		Vector3 constant_linear_velocity;
+		Vector3 constant_angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		Vector3 constant_force;
+		Vector3 constant_torque;
+		real_t still_time = 0.0;
+		bool active = false;
+		LocalVector<AABB> shape_aabbs;
+
+		void write(PhysicsStateWriter &p_writer) const;
+		void read(PhysicsStateReader &p_reader);
+	};
+
+	void save_state(SavedState &r_state) const;
+	void restore_state(const SavedState &p_state);
+
 	void set_state_sync_callback(const Callable &p_callable);
 	void set_force_integration_callback(const Callable &p_callable, const Variant &p_udata = Variant());
 
@@ -315,8 +348,12 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// The integration steps only change the body itself, so they can run for many bodies at once
+	// on worker threads. The finish_*() calls then update the space and broadphase, and must run on a single thread.
 	void integrate_forces(real_t p_step);
+	void finish_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finish_integrate_velocities();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
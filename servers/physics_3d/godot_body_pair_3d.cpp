@@ -34,6 +34,7 @@
 #include "godot_space_3d.h"
 
 #include "core/os/os.h"
+#include "servers/physics_state_buffer.h"
 
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math_PI / 8)
@@ -595,8 +596,95 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::SavedState::write(PhysicsStateWriter &p_writer) const {
+	p_writer.put_vector3(sep_axis);
+	p_writer.put_bool(collided);
+	p_writer.put_bool(check_ccd);
+	p_writer.put_u32(contact_count);
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		p_writer.put_vector3(c.position);
+		p_writer.put_vector3(c.normal);
+		p_writer.put_u32(c.index_A);
+		p_writer.put_u32(c.index_B);
+		p_writer.put_vector3(c.local_A);
+		p_writer.put_vector3(c.local_B);
+		p_writer.put_vector3(c.acc_impulse);
+		p_writer.put_real(c.acc_normal_impulse);
+		p_writer.put_vector3(c.acc_tangent_impulse);
+		p_writer.put_real(c.acc_bias_impulse);
+		p_writer.put_real(c.acc_bias_impulse_center_of_mass);
+		p_writer.put_real(c.mass_normal);
+		p_writer.put_real(c.bias);
+		p_writer.put_real(c.bounce);
+		p_writer.put_real(c.depth);
+		p_writer.put_bool(c.active);
+		p_writer.put_bool(c.used);
+		p_writer.put_vector3(c.rA);
+		p_writer.put_vector3(c.rB);
+	}
+}
+
+void GodotBodyPair3D::SavedState::read(PhysicsStateReader &p_reader) {
+	sep_axis = p_reader.get_vector3();
+	collided = p_reader.get_bool();
+	check_ccd = p_reader.get_bool();
+	contact_count = MIN(p_reader.get_u32(), (uint32_t)MAX_CONTACTS);
+	for (int i = 0; i < contact_count; i++) {
+		Contact &c = contacts[i];
+		c.position = p_reader.get_vector3();
+		c.normal = p_reader.get_vector3();
+		c.index_A = p_reader.get_u32();
+		c.index_B = p_reader.get_u32();
+		c.local_A = p_reader.get_vector3();
+		c.local_B = p_reader.get_vector3();
+		c.acc_impulse = p_reader.get_vector3();
+		c.acc_normal_impulse = p_reader.get_real();
+		c.acc_tangent_impulse = p_reader.get_vector3();
+		c.acc_bias_impulse = p_reader.get_real();
+		c.acc_bias_impulse_center_of_mass = p_reader.get_real();
+		c.mass_normal = p_reader.get_real();
+		c.bias = p_reader.get_real();
+		c.bounce = p_reader.get_real();
+		c.depth = p_reader.get_real();
+		c.active = p_reader.get_bool();
+		c.used = p_reader.get_bool();
+		c.rA = p_reader.get_vector3();
+		c.rB = p_reader.get_vector3();
+	}
+}
+
+void GodotBodyPair3D::save_state(SavedState &r_state) const {
+	r_state.sep_axis = sep_axis;
+	r_state.collided = collided;
+	r_state.check_ccd = check_ccd;
+	r_state.contact_count = contact_count;
+	for (int i = 0; i < contact_count; i++) {
+		r_state.contacts[i] = contacts[i];
+	}
+}
+
+void GodotBodyPair3D::restore_state(const SavedState &p_state) {
+	sep_axis = p_state.sep_axis;
+	collided = p_state.collided;
+	check_ccd = p_state.check_ccd;
+	contact_count = p_state.contact_count;
+	for (int i = 0; i < contact_count; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+}
+
+void GodotBodyPair3D::reset_state() {
+	// Same as a newly created pair.
+	sep_axis = Vector3();
+	collided = false;
+	check_ccd = false;
+	contact_count = 0;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
-		GodotBodyContact3D(_arr, 2) {
+		GodotBodyContact3D(_arr, 2),
+		space_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
@@ -604,11 +692,13 @@ GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p
 	space = A->get_space();
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
+	space->body_pair_add_to_list(&space_list);
 }
 
 GodotBodyPair3D::~GodotBodyPair3D() {
 	A->remove_constraint(this);
 	B->remove_constraint(this);
+	space->body_pair_remove_from_list(&space_list);
 }
 
 void GodotBodySoftBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
@@ -36,6 +36,10 @@
 #include "godot_soft_body_3d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
+
+class PhysicsStateReader;
+class PhysicsStateWriter;
 
 class GodotBodyContact3D : public GodotConstraint3D {
 protected:
@@ -97,6 +101,8 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	SelfList<GodotBodyPair3D> space_list;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
@@ -105,6 +111,27 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	// Contacts and accumulated impulses, saved by GodotSpace3D::save_state() to warm start the solver after a restore.
+	struct SavedState {
+		Vector3 sep_axis;
+		bool collided = false;
+		bool check_ccd = false;
+		int contact_count = 0;
+		Contact contacts[MAX_CONTACTS];
+
+		void write(PhysicsStateWriter &p_writer) const;
+		void read(PhysicsStateReader &p_reader);
+	};
+
+	void save_state(SavedState &r_state) const;
+	void restore_state(const SavedState &p_state);
+	void reset_state();
+
+	_FORCE_INLINE_ GodotBody3D *get_body_A() const { return A; }
+	_FORCE_INLINE_ GodotBody3D *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -123,6 +123,7 @@ GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 }
 
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
+	bvh.params_set_threaded_pairing(true);
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
 }
@@ -115,6 +115,10 @@ public:
 
 	void _shape_changed() override;
 
+	// Used by GodotSpace3D::rebuild_broadphase(), the shapes are added back with their current AABBs.
+	_FORCE_INLINE_ void remove_from_broadphase() { _unregister_shapes(); }
+	void add_to_broadphase();
+
 	_FORCE_INLINE_ Type get_type() const { return type; }
 	void add_shape(GodotShape3D *p_shape, const Transform3D &p_transform = Transform3D(), bool p_disabled = false);
 	void set_shape(int p_index, GodotShape3D *p_shape);
@@ -136,6 +140,11 @@ public:
 		CRASH_BAD_INDEX(p_index, shapes.size());
 		return shapes[p_index].aabb_cache;
 	}
+	// Each update grows the AABB from its previous size, so bodies save it with their state.
+	_FORCE_INLINE_ void set_shape_aabb(int p_index, const AABB &p_aabb) {
+		CRASH_BAD_INDEX(p_index, shapes.size());
+		shapes.write[p_index].aabb_cache = p_aabb;
+	}
 	_FORCE_INLINE_ real_t get_shape_area(int p_index) const {
 		CRASH_BAD_INDEX(p_index, shapes.size());
 		return shapes[p_index].area_cache;
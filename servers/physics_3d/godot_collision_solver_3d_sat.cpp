@@ -31,13 +31,18 @@
 #include "godot_collision_solver_3d_sat.h"
 
 #include "gjk_epa.h"
+#include "godot_simd_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/templates/local_vector.h"
 
 #define fallback_collision_solver gjk_epa_calculate_penetration
 
 #define _BACKFACE_NORMAL_THRESHOLD -0.0002
 
+// Largest scratch buffer of the convex edge tests put on the stack, bigger hulls use a per-thread buffer.
+#define _EDGE_SCRATCH_STACK_MAX 8192
+
 // Cylinder SAT analytic methods and face-circle contact points for cylinder-trimesh and cylinder-box collision are based on ODE colliders.
 
 /*
@@ -2025,16 +2030,6 @@ static void _collision_cylinder_face(const GodotShape3D *p_a, const Transform3D
 	separator.generate_contacts();
 }
 
-static _FORCE_INLINE_ bool is_minkowski_face(const Vector3 &A, const Vector3 &B, const Vector3 &B_x_A, const Vector3 &C, const Vector3 &D, const Vector3 &D_x_C) {
-	// Test if arcs AB and CD intersect on the unit sphere
-	real_t CBA = C.dot(B_x_A);
-	real_t DBA = D.dot(B_x_A);
-	real_t ADC = A.dot(D_x_C);
-	real_t BDC = B.dot(D_x_C);
-
-	return (CBA * DBA < 0.0f) && (ADC * BDC < 0.0f) && (CBA * BDC > 0.0f);
-}
-
 template <bool withMargin>
 static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, const Transform3D &p_transform_a, const GodotShape3D *p_b, const Transform3D &p_transform_b, _CollectorCallback *p_collector, real_t p_margin_a, real_t p_margin_b) {
 	const GodotConvexPolygonShape3D *convex_polygon_A = static_cast<const GodotConvexPolygonShape3D *>(p_a);
@@ -2090,6 +2085,41 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 
 	// A<->B edges
 
+	// The edges of B are transformed once, and kept as arcs on the unit sphere
+	// so each edge of A can be tested against several of them at a time.
+	int arc_stride_B = GodotSIMD3D::get_arc_stride(edge_count_B);
+	uint32_t arcs_size = sizeof(real_t) * 9 * arc_stride_B;
+	uint32_t edge_dirs_size = sizeof(Vector3) * edge_count_B;
+	uint32_t scratch_size = arcs_size + edge_dirs_size + sizeof(int) * arc_stride_B;
+	uint8_t *scratch = nullptr;
+	if (scratch_size <= _EDGE_SCRATCH_STACK_MAX) {
+		scratch = (uint8_t *)alloca(scratch_size);
+	} else {
+		// Collisions are solved on worker threads, whose stack is too small for large hulls.
+		// The buffer is kept, so it's only allocated when a thread meets a larger hull than before.
+		thread_local LocalVector<uint8_t> large_scratch;
+		if (large_scratch.size() < scratch_size) {
+			large_scratch.resize(scratch_size);
+		}
+		scratch = large_scratch.ptr();
+	}
+
+	real_t *arcs_B = (real_t *)scratch;
+	memset(arcs_B, 0, arcs_size);
+	Vector3 *edge_dirs_B = (Vector3 *)(scratch + arcs_size);
+	int *minkowski_edges_B = (int *)(scratch + arcs_size + edge_dirs_size);
+
+	for (int j = 0; j < edge_count_B; j++) {
+		Vector3 p2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_a]);
+		Vector3 q2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_b]);
+		Vector3 e2 = q2 - p2;
+		Vector3 u2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
+		Vector3 v2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
+
+		edge_dirs_B[j] = e2;
+		GodotSIMD3D::set_arc(arcs_B, arc_stride_B, j, -u2, -v2, -e2);
+	}
+
 	for (int i = 0; i < edge_count_A; i++) {
 		Vector3 p1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_a]);
 		Vector3 q1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_b]);
@@ -2097,19 +2127,14 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 		Vector3 u1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_a].plane.normal).normalized();
 		Vector3 v1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_b].plane.normal).normalized();
 
-		for (int j = 0; j < edge_count_B; j++) {
-			Vector3 p2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_a]);
-			Vector3 q2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_b]);
-			Vector3 e2 = q2 - p2;
-			Vector3 u2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
-			Vector3 v2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
+		// Only the edge pairs whose arcs (u1, v1) and (-u2, -v2) intersect on the unit sphere build a face of the Minkowski difference.
+		int minkowski_count = GodotSIMD3D::find_minkowski_faces(u1, v1, -e1, arcs_B, arc_stride_B, edge_count_B, minkowski_edges_B);
 
-			if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
-				Vector3 axis = e1.cross(e2).normalized();
+		for (int j = 0; j < minkowski_count; j++) {
+			Vector3 axis = e1.cross(edge_dirs_B[minkowski_edges_B[j]]).normalized();
 
-				if (!separator.test_axis(axis)) {
-					return;
-				}
+			if (!separator.test_axis(axis)) {
+				return;
 			}
 		}
 	}
@@ -30,6 +30,8 @@
 
 #include "godot_shape_3d.h"
 
+#include "godot_simd_3d.h"
+
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
@@ -830,16 +832,13 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		r_min = p_normal.dot(p_transform.xform(get_support(-n)));
 		r_max = p_normal.dot(p_transform.xform(get_support(n)));
 	} else {
-		for (uint32_t i = 0; i < vertex_count; i++) {
-			real_t d = p_normal.dot(p_transform.xform(vrts[i]));
+		// Project the vertices on the axis in local space, rather than transforming each of them.
+		Vector3 local_normal = p_transform.basis.xform_inv(p_normal);
+		real_t offset = p_normal.dot(p_transform.origin);
 
-			if (i == 0 || d > r_max) {
-				r_max = d;
-			}
-			if (i == 0 || d < r_min) {
-				r_min = d;
-			}
-		}
+		GodotSIMD3D::project_range(vrts, vertex_count, local_normal, r_min, r_max);
+		r_min += offset;
+		r_max += offset;
 	}
 }
 
@@ -852,6 +851,11 @@ Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 	// Get the array of vertices
 	const Vector3 *const vertices_array = mesh.vertices.ptr();
 
+	// If every vertex is an extreme vertex, a straight scan over all of them is fastest.
+	if (extreme_vertices.size() == mesh.vertices.size()) {
+		return vertices_array[GodotSIMD3D::get_support_index(vertices_array, mesh.vertices.size(), p_normal)];
+	}
+
 	// Start with an initial assumption of the first extreme vertex.
 	int best_vertex = extreme_vertices[0];
 	real_t max_support = p_normal.dot(vertices_array[best_vertex]);
@@ -865,11 +869,6 @@ Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 		}
 	}
 
-	// If we checked all vertices in the mesh then we're done.
-	if (extreme_vertices.size() == mesh.vertices.size()) {
-		return vertices_array[best_vertex];
-	}
-
 	// Move along the surface until we reach the true support vertex.
 	int last_vertex = -1;
 	while (true) {
@@ -912,17 +911,7 @@ void GodotConvexPolygonShape3D::get_supports(const Vector3 &p_normal, int p_max,
 	ERR_FAIL_COND_MSG(vc == 0, "Convex polygon shape has no vertices.");
 
 	//find vertex first
-	real_t max = 0;
-	int vtx = 0;
-
-	for (int i = 0; i < vc; i++) {
-		real_t d = p_normal.dot(vertices[i]);
-
-		if (i == 0 || d > max) {
-			max = d;
-			vtx = i;
-		}
-	}
+	int vtx = GodotSIMD3D::get_support_index(vertices, vc, p_normal);
 
 	for (int i = 0; i < fc; i++) {
 		if (faces[i].plane.normal.dot(p_normal) > face_support_threshold) {
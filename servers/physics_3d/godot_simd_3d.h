@@ -0,0 +1,369 @@
+/**************************************************************************/
+/*  godot_simd_3d.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_SIMD_3D_H
+#define GODOT_SIMD_3D_H
+
+#include "core/math/vector3.h"
+#include "core/variant/packed_array_simd.h"
+
+// Vectorized versions of the inner loops of the convex collision tests.
+// They use the same instruction set as PackedArraySIMD, when real_t is
+// float. Define PHYSICS_3D_SIMD_DISABLED to build the scalar versions only.
+#if !defined(PHYSICS_3D_SIMD_DISABLED) && !defined(REAL_T_IS_DOUBLE)
+#if defined(PACKED_ARRAY_SIMD_SSE2)
+#define GODOT_SIMD_3D_SSE2
+#elif defined(PACKED_ARRAY_SIMD_NEON)
+#define GODOT_SIMD_3D_NEON
+#endif
+#endif
+
+class GodotSIMD3D {
+	static_assert(sizeof(Vector3) == 3 * sizeof(real_t), "Vector3 arrays are read as packed real_t triples.");
+
+public:
+	enum {
+		LANES = PackedArraySIMD::LANES,
+	};
+
+	static const char *get_instruction_set() {
+#if defined(GODOT_SIMD_3D_SSE2)
+		return "SSE2";
+#elif defined(GODOT_SIMD_3D_NEON)
+		return "NEON";
+#else
+		return "scalar";
+#endif
+	}
+
+	/* PROJECT RANGE */
+
+	// Smallest and largest projection of the points on the axis. p_count must be at least 1.
+	static void project_range_scalar(const Vector3 *p_points, int p_count, const Vector3 &p_axis, real_t &r_min, real_t &r_max) {
+		r_min = r_max = p_axis.dot(p_points[0]);
+		for (int i = 1; i < p_count; i++) {
+			real_t d = p_axis.dot(p_points[i]);
+			if (d > r_max) {
+				r_max = d;
+			}
+			if (d < r_min) {
+				r_min = d;
+			}
+		}
+	}
+
+	static void project_range(const Vector3 *p_points, int p_count, const Vector3 &p_axis, real_t &r_min, real_t &r_max) {
+#if defined(GODOT_SIMD_3D_SSE2)
+		if (p_count >= LANES) {
+			const __m128 axis_x = _mm_set1_ps(p_axis.x);
+			const __m128 axis_y = _mm_set1_ps(p_axis.y);
+			const __m128 axis_z = _mm_set1_ps(p_axis.z);
+
+			__m128 x, y, z;
+			PackedArraySIMD::load_points(p_points, x, y, z);
+			__m128 min = PackedArraySIMD::dot_components(x, y, z, axis_x, axis_y, axis_z);
+			__m128 max = min;
+
+			int i = LANES;
+			for (; i + LANES <= p_count; i += LANES) {
+				PackedArraySIMD::load_points(p_points + i, x, y, z);
+				__m128 d = PackedArraySIMD::dot_components(x, y, z, axis_x, axis_y, axis_z);
+				min = _mm_min_ps(min, d);
+				max = _mm_max_ps(max, d);
+			}
+
+			min = _mm_min_ps(min, _mm_shuffle_ps(min, min, _MM_SHUFFLE(2, 3, 0, 1)));
+			min = _mm_min_ps(min, _mm_shuffle_ps(min, min, _MM_SHUFFLE(1, 0, 3, 2)));
+			max = _mm_max_ps(max, _mm_shuffle_ps(max, max, _MM_SHUFFLE(2, 3, 0, 1)));
+			max = _mm_max_ps(max, _mm_shuffle_ps(max, max, _MM_SHUFFLE(1, 0, 3, 2)));
+			r_min = _mm_cvtss_f32(min);
+			r_max = _mm_cvtss_f32(max);
+
+			for (; i < p_count; i++) {
+				real_t d = p_axis.dot(p_points[i]);
+				r_max = MAX(r_max, d);
+				r_min = MIN(r_min, d);
+			}
+			return;
+		}
+#elif defined(GODOT_SIMD_3D_NEON)
+		if (p_count >= LANES) {
+			const float32x4_t axis_x = vdupq_n_f32(p_axis.x);
+			const float32x4_t axis_y = vdupq_n_f32(p_axis.y);
+			const float32x4_t axis_z = vdupq_n_f32(p_axis.z);
+
+			float32x4x3_t p = vld3q_f32(&p_points->x);
+			float32x4_t min = PackedArraySIMD::dot_components(p.val[0], p.val[1], p.val[2], axis_x, axis_y, axis_z);
+			float32x4_t max = min;
+
+			int i = LANES;
+			for (; i + LANES <= p_count; i += LANES) {
+				p = vld3q_f32(&p_points[i].x);
+				float32x4_t d = PackedArraySIMD::dot_components(p.val[0], p.val[1], p.val[2], axis_x, axis_y, axis_z);
+				min = vminq_f32(min, d);
+				max = vmaxq_f32(max, d);
+			}
+
+			float mins[LANES];
+			float maxs[LANES];
+			vst1q_f32(mins, min);
+			vst1q_f32(maxs, max);
+			r_min = MIN(MIN(mins[0], mins[1]), MIN(mins[2], mins[3]));
+			r_max = MAX(MAX(maxs[0], maxs[1]), MAX(maxs[2], maxs[3]));
+
+			for (; i < p_count; i++) {
+				real_t d = p_axis.dot(p_points[i]);
+				r_max = MAX(r_max, d);
+				r_min = MIN(r_min, d);
+			}
+			return;
+		}
+#endif
+		project_range_scalar(p_points, p_count, p_axis, r_min, r_max);
+	}
+
+	/* SUPPORT */
+
+	// Index of the point furthest along the direction, the first one if there is a tie.
+	// p_count must be at least 1.
+	static int get_support_index_scalar(const Vector3 *p_points, int p_count, const Vector3 &p_dir) {
+		int best = 0;
+		real_t best_d = p_dir.dot(p_points[0]);
+		for (int i = 1; i < p_count; i++) {
+			real_t d = p_dir.dot(p_points[i]);
+			if (d > best_d) {
+				best = i;
+				best_d = d;
+			}
+		}
+		return best;
+	}
+
+	static int get_support_index(const Vector3 *p_points, int p_count, const Vector3 &p_dir) {
+#if defined(GODOT_SIMD_3D_SSE2) || defined(GODOT_SIMD_3D_NEON)
+		if (p_count >= LANES) {
+			float lane_d[LANES];
+			int32_t lane_index[LANES];
+
+#if defined(GODOT_SIMD_3D_SSE2)
+			const __m128 dir_x = _mm_set1_ps(p_dir.x);
+			const __m128 dir_y = _mm_set1_ps(p_dir.y);
+			const __m128 dir_z = _mm_set1_ps(p_dir.z);
+
+			__m128 x, y, z;
+			PackedArraySIMD::load_points(p_points, x, y, z);
+			__m128 best_d = PackedArraySIMD::dot_components(x, y, z, dir_x, dir_y, dir_z);
+			__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+			__m128i best_index = index;
+			const __m128i step = _mm_set1_epi32(LANES);
+
+			int i = LANES;
+			for (; i + LANES <= p_count; i += LANES) {
+				PackedArraySIMD::load_points(p_points + i, x, y, z);
+				__m128 d = PackedArraySIMD::dot_components(x, y, z, dir_x, dir_y, dir_z);
+				index = _mm_add_epi32(index, step);
+
+				// Strictly greater, so each lane keeps its first best point.
+				__m128 greater = _mm_cmpgt_ps(d, best_d);
+				__m128i greater_i = _mm_castps_si128(greater);
+				best_d = _mm_or_ps(_mm_and_ps(greater, d), _mm_andnot_ps(greater, best_d));
+				best_index = _mm_or_si128(_mm_and_si128(greater_i, index), _mm_andnot_si128(greater_i, best_index));
+			}
+
+			_mm_storeu_ps(lane_d, best_d);
+			_mm_storeu_si128((__m128i *)lane_index, best_index);
+#else
+			const float32x4_t dir_x = vdupq_n_f32(p_dir.x);
+			const float32x4_t dir_y = vdupq_n_f32(p_dir.y);
+			const float32x4_t dir_z = vdupq_n_f32(p_dir.z);
+
+			float32x4x3_t p = vld3q_f32(&p_points->x);
+			float32x4_t best_d = PackedArraySIMD::dot_components(p.val[0], p.val[1], p.val[2], dir_x, dir_y, dir_z);
+			const int32_t first_index[LANES] = { 0, 1, 2, 3 };
+			int32x4_t index = vld1q_s32(first_index);
+			int32x4_t best_index = index;
+			const int32x4_t step = vdupq_n_s32(LANES);
+
+			int i = LANES;
+			for (; i + LANES <= p_count; i += LANES) {
+				p = vld3q_f32(&p_points[i].x);
+				float32x4_t d = PackedArraySIMD::dot_components(p.val[0], p.val[1], p.val[2], dir_x, dir_y, dir_z);
+				index = vaddq_s32(index, step);
+
+				// Strictly greater, so each lane keeps its first best point.
+				uint32x4_t greater = vcgtq_f32(d, best_d);
+				best_d = vbslq_f32(greater, d, best_d);
+				best_index = vbslq_s32(greater, index, best_index);
+			}
+
+			vst1q_f32(lane_d, best_d);
+			vst1q_s32(lane_index, best_index);
+#endif
+
+			// On a tie between lanes, the lower index came first.
+			int best_lane = 0;
+			for (int l = 1; l < LANES; l++) {
+				if (lane_d[l] > lane_d[best_lane] || (lane_d[l] == lane_d[best_lane] && lane_index[l] < lane_index[best_lane])) {
+					best_lane = l;
+				}
+			}
+
+			int best = lane_index[best_lane];
+			real_t best_dot = lane_d[best_lane];
+			for (; i < p_count; i++) {
+				real_t d = p_dir.dot(p_points[i]);
+				if (d > best_dot) {
+					best = i;
+					best_dot = d;
+				}
+			}
+			return best;
+		}
+#endif
+		return get_support_index_scalar(p_points, p_count, p_dir);
+	}
+
+	/* MINKOWSKI FACES */
+
+	// For the SAT edge-edge axes, the arcs C -> D of a list of edges, along with D x C, are kept
+	// as 9 rows (C.x, C.y, C.z, D.x, ... (D x C).z) of get_arc_stride() values each.
+	// The padding at the end of the rows must be zero.
+	static int get_arc_stride(int p_count) {
+		return (p_count + LANES - 1) & ~(LANES - 1);
+	}
+
+	static _FORCE_INLINE_ void set_arc(real_t *p_arcs, int p_stride, int p_index, const Vector3 &p_c, const Vector3 &p_d, const Vector3 &p_d_x_c) {
+		for (int k = 0; k < 3; k++) {
+			p_arcs[k * p_stride + p_index] = p_c[k];
+			p_arcs[(3 + k) * p_stride + p_index] = p_d[k];
+			p_arcs[(6 + k) * p_stride + p_index] = p_d_x_c[k];
+		}
+	}
+
+	// Writes the indices of the arcs that intersect the arc A -> B on the unit sphere to r_indices,
+	// in increasing order, and returns how many there are.
+	static int find_minkowski_faces_scalar(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_b_x_a, const real_t *p_arcs, int p_stride, int p_count, int *r_indices) {
+		int found = 0;
+		for (int i = 0; i < p_count; i++) {
+			Vector3 c(p_arcs[i], p_arcs[p_stride + i], p_arcs[2 * p_stride + i]);
+			Vector3 d(p_arcs[3 * p_stride + i], p_arcs[4 * p_stride + i], p_arcs[5 * p_stride + i]);
+			Vector3 d_x_c(p_arcs[6 * p_stride + i], p_arcs[7 * p_stride + i], p_arcs[8 * p_stride + i]);
+
+			real_t cba = c.dot(p_b_x_a);
+			real_t dba = d.dot(p_b_x_a);
+			real_t adc = p_a.dot(d_x_c);
+			real_t bdc = p_b.dot(d_x_c);
+
+			if ((cba * dba < 0.0f) && (adc * bdc < 0.0f) && (cba * bdc > 0.0f)) {
+				r_indices[found++] = i;
+			}
+		}
+		return found;
+	}
+
+	static int find_minkowski_faces(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_b_x_a, const real_t *p_arcs, int p_stride, int p_count, int *r_indices) {
+#if defined(GODOT_SIMD_3D_SSE2)
+		const __m128 a_x = _mm_set1_ps(p_a.x);
+		const __m128 a_y = _mm_set1_ps(p_a.y);
+		const __m128 a_z = _mm_set1_ps(p_a.z);
+		const __m128 b_x = _mm_set1_ps(p_b.x);
+		const __m128 b_y = _mm_set1_ps(p_b.y);
+		const __m128 b_z = _mm_set1_ps(p_b.z);
+		const __m128 ba_x = _mm_set1_ps(p_b_x_a.x);
+		const __m128 ba_y = _mm_set1_ps(p_b_x_a.y);
+		const __m128 ba_z = _mm_set1_ps(p_b_x_a.z);
+		const __m128 zero = _mm_setzero_ps();
+
+		int found = 0;
+		// The zero padding never passes the test, so whole groups of lanes can be tested.
+		for (int i = 0; i < p_count; i += LANES) {
+			const float *row = p_arcs + i;
+			__m128 cba = PackedArraySIMD::dot_components(_mm_loadu_ps(row), _mm_loadu_ps(row + p_stride), _mm_loadu_ps(row + 2 * p_stride), ba_x, ba_y, ba_z);
+			__m128 dba = PackedArraySIMD::dot_components(_mm_loadu_ps(row + 3 * p_stride), _mm_loadu_ps(row + 4 * p_stride), _mm_loadu_ps(row + 5 * p_stride), ba_x, ba_y, ba_z);
+			__m128 dc_x = _mm_loadu_ps(row + 6 * p_stride);
+			__m128 dc_y = _mm_loadu_ps(row + 7 * p_stride);
+			__m128 dc_z = _mm_loadu_ps(row + 8 * p_stride);
+			__m128 adc = PackedArraySIMD::dot_components(a_x, a_y, a_z, dc_x, dc_y, dc_z);
+			__m128 bdc = PackedArraySIMD::dot_components(b_x, b_y, b_z, dc_x, dc_y, dc_z);
+
+			__m128 pass = _mm_and_ps(_mm_cmplt_ps(_mm_mul_ps(cba, dba), zero), _mm_cmplt_ps(_mm_mul_ps(adc, bdc), zero));
+			pass = _mm_and_ps(pass, _mm_cmpgt_ps(_mm_mul_ps(cba, bdc), zero));
+
+			int mask = _mm_movemask_ps(pass);
+			for (int l = 0; mask; l++, mask >>= 1) {
+				if (mask & 1) {
+					r_indices[found++] = i + l;
+				}
+			}
+		}
+		return found;
+#elif defined(GODOT_SIMD_3D_NEON)
+		const float32x4_t a_x = vdupq_n_f32(p_a.x);
+		const float32x4_t a_y = vdupq_n_f32(p_a.y);
+		const float32x4_t a_z = vdupq_n_f32(p_a.z);
+		const float32x4_t b_x = vdupq_n_f32(p_b.x);
+		const float32x4_t b_y = vdupq_n_f32(p_b.y);
+		const float32x4_t b_z = vdupq_n_f32(p_b.z);
+		const float32x4_t ba_x = vdupq_n_f32(p_b_x_a.x);
+		const float32x4_t ba_y = vdupq_n_f32(p_b_x_a.y);
+		const float32x4_t ba_z = vdupq_n_f32(p_b_x_a.z);
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+
+		int found = 0;
+		// The zero padding never passes the test, so whole groups of lanes can be tested.
+		for (int i = 0; i < p_count; i += LANES) {
+			const float *row = p_arcs + i;
+			float32x4_t cba = PackedArraySIMD::dot_components(vld1q_f32(row), vld1q_f32(row + p_stride), vld1q_f32(row + 2 * p_stride), ba_x, ba_y, ba_z);
+			float32x4_t dba = PackedArraySIMD::dot_components(vld1q_f32(row + 3 * p_stride), vld1q_f32(row + 4 * p_stride), vld1q_f32(row + 5 * p_stride), ba_x, ba_y, ba_z);
+			float32x4_t dc_x = vld1q_f32(row + 6 * p_stride);
+			float32x4_t dc_y = vld1q_f32(row + 7 * p_stride);
+			float32x4_t dc_z = vld1q_f32(row + 8 * p_stride);
+			float32x4_t adc = PackedArraySIMD::dot_components(a_x, a_y, a_z, dc_x, dc_y, dc_z);
+			float32x4_t bdc = PackedArraySIMD::dot_components(b_x, b_y, b_z, dc_x, dc_y, dc_z);
+
+			uint32x4_t pass = vandq_u32(vcltq_f32(vmulq_f32(cba, dba), zero), vcltq_f32(vmulq_f32(adc, bdc), zero));
+			pass = vandq_u32(pass, vcgtq_f32(vmulq_f32(cba, bdc), zero));
+
+			uint32_t lanes[LANES];
+			vst1q_u32(lanes, pass);
+			for (int l = 0; l < LANES; l++) {
+				if (lanes[l]) {
+					r_indices[found++] = i + l;
+				}
+			}
+		}
+		return found;
+#else
+		return find_minkowski_faces_scalar(p_a, p_b, p_b_x_a, p_arcs, p_stride, p_count, r_indices);
+#endif
+	}
+};
+
+#endif // GODOT_SIMD_3D_H
@@ -34,10 +34,14 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "servers/physics_state_buffer.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
+#define SPACE_STATE_MAGIC 0x33535047 // "GPS3"
+
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
 		return false;
@@ -105,16 +109,14 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices, RayResult &r_result) {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -125,21 +127,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(r_cull_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -201,17 +203,16 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
 
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_COND_V(!shape, 0);
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, r_result);
+}
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+int GodotPhysicsDirectSpaceState3D::_intersect_shape(const ShapeParameters &p_parameters, const GodotShape3D *p_shape, const Transform3D &p_transform, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices, ShapeResult *r_results, int p_result_max) {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	int cc = 0;
 
@@ -222,20 +223,20 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -256,6 +257,103 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
+int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_COND_V(!shape, 0);
+
+	return _intersect_shape(p_parameters, shape, p_parameters.transform, space->intersection_query_results, space->intersection_query_subindex_results, r_results, p_result_max);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_rays_batch_chunk(uint32_t p_chunk, RayBatch *p_batch) {
+	// The cull buffers of the space can only be used by one query at a time, each chunk has its own.
+	GodotCollisionObject3D *cull_results[GodotSpace3D::INTERSECTION_QUERY_MAX];
+	int cull_subindices[GodotSpace3D::INTERSECTION_QUERY_MAX];
+
+	int begin = p_chunk * BATCH_CHUNK_SIZE;
+	int end = MIN(begin + BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = begin; i < end; i++) {
+		p_batch->hits[i] = _intersect_ray(*p_batch->parameters, p_batch->from[i], p_batch->to[i], cull_results, cull_subindices, p_batch->results[i]);
+	}
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.count = p_count;
+
+	// The broadphase serializes the culls, the narrowphase tests of each ray run in parallel.
+	uint32_t chunk_count = (p_count + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE;
+	if (chunk_count == 1) {
+		_intersect_rays_batch_chunk(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_rays_batch_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectRaysBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		hit_count += r_hits[i] ? 1 : 0;
+	}
+	return hit_count;
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shapes_batch_chunk(uint32_t p_chunk, ShapeBatch *p_batch) {
+	GodotCollisionObject3D *cull_results[GodotSpace3D::INTERSECTION_QUERY_MAX];
+	int cull_subindices[GodotSpace3D::INTERSECTION_QUERY_MAX];
+
+	int begin = p_chunk * BATCH_CHUNK_SIZE;
+	int end = MIN(begin + BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = begin; i < end; i++) {
+		p_batch->result_counts[i] = _intersect_shape(*p_batch->parameters, p_batch->shape, p_batch->transforms[i], cull_results, cull_subindices, &p_batch->results[i * p_batch->result_max], p_batch->result_max);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_shapes_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+	if (p_result_max <= 0) {
+		for (int i = 0; i < p_count; i++) {
+			r_result_counts[i] = 0;
+		}
+		return;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_COND(!shape);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+	batch.count = p_count;
+
+	uint32_t chunk_count = (p_count + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE;
+	if (chunk_count == 1) {
+		_intersect_shapes_batch_chunk(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shapes_batch_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectShapesBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+}
+
 bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_COND_V(!shape, false);
@@ -1057,6 +1155,11 @@ void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A
 			GodotBodySoftBodyPair3D *soft_pair = memnew(GodotBodySoftBodyPair3D(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotSoftBody3D *>(B)));
 			return soft_pair;
 		} else {
+			// Keep the same order whatever the broadphase reports, so the pair solves the same after a state restore.
+			if (B->get_self().get_id() < A->get_self().get_id()) {
+				SWAP(A, B);
+				SWAP(p_subindex_A, p_subindex_B);
+			}
 			GodotBodyPair3D *b = memnew(GodotBodyPair3D(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotBody3D *>(B), p_subindex_B));
 			return b;
 		}
@@ -1102,6 +1205,38 @@ GodotBroadPhase3D *GodotSpace3D::get_broadphase() {
 	return broadphase;
 }
 
+void GodotSpace3D::rebuild_broadphase() {
+	// Removing the shapes first frees all the pairs through the unpair callback.
+	LocalVector<GodotCollisionObject3D *> sorted_objects;
+	for (GodotCollisionObject3D *E : objects) {
+		E->remove_from_broadphase();
+		sorted_objects.push_back(E);
+	}
+
+	memdelete(broadphase);
+	broadphase = GodotBroadPhase3D::create_func();
+	broadphase->set_pair_callback(_broadphase_pair, this);
+	broadphase->set_unpair_callback(_broadphase_unpair, this);
+
+	sorted_objects.sort_custom<PhysicsStateRIDSort>();
+	for (GodotCollisionObject3D *E : sorted_objects) {
+		E->add_to_broadphase();
+	}
+	broadphase->update();
+
+	// The next step would only find the area overlaps again after applying gravity and damping to the bodies.
+	for (GodotCollisionObject3D *E : sorted_objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_AREA) {
+			continue;
+		}
+		for (GodotConstraint3D *constraint : static_cast<GodotArea3D *>(E)->get_constraints()) {
+			if (constraint->setup(0.0)) {
+				constraint->pre_solve(0.0);
+			}
+		}
+	}
+}
+
 void GodotSpace3D::add_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
@@ -1124,6 +1259,14 @@ void GodotSpace3D::body_remove_from_state_query_list(SelfList<GodotBody3D> *p_bo
 	state_query_list.remove(p_body);
 }
 
+void GodotSpace3D::body_pair_add_to_list(SelfList<GodotBodyPair3D> *p_body_pair) {
+	body_pair_list.add(p_body_pair);
+}
+
+void GodotSpace3D::body_pair_remove_from_list(SelfList<GodotBodyPair3D> *p_body_pair) {
+	body_pair_list.remove(p_body_pair);
+}
+
 void GodotSpace3D::area_add_to_monitor_query_list(SelfList<GodotArea3D> *p_area) {
 	monitor_query_list.add(p_area);
 }
@@ -1249,6 +1392,14 @@ GodotPhysicsDirectSpaceState3D *GodotSpace3D::get_direct_state() {
 	return direct_access;
 }
 
+PackedByteArray GodotSpace3D::save_state() const {
+	return PhysicsSpaceState<GodotSpace3D, GodotCollisionObject3D, GodotBody3D, GodotBodyPair3D>::save(this, SPACE_STATE_MAGIC);
+}
+
+Error GodotSpace3D::restore_state(const PackedByteArray &p_state) {
+	return PhysicsSpaceState<GodotSpace3D, GodotCollisionObject3D, GodotBody3D, GodotBodyPair3D>::restore(this, SPACE_STATE_MAGIC, p_state);
+}
+
 GodotSpace3D::GodotSpace3D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_angular");
@@ -41,6 +41,9 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+// Below this many active bodies, integrating on the calling thread is cheaper than dispatching a group task.
+#define INTEGRATE_TASK_MIN_BODIES 128
+
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -112,6 +115,23 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_collect_active_bodies(const SelfList<GodotBody3D>::List *p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody3D> *b = p_body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+}
+
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -130,6 +150,13 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep3D::_pre_solve_islands(uint32_t p_island_count) {
+	setup_constraints_endtime = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		_pre_solve_island(constraint_islands[island_index]);
+	}
+}
+
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
@@ -201,13 +228,21 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	// The bodies are integrated on worker threads, then update the broadphase here in list order.
+	_collect_active_bodies(body_list);
+	int active_count = active_bodies.size();
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	if (active_count < INTEGRATE_TASK_MIN_BODIES) {
+		for (int i = 0; i < active_count; i++) {
+			_integrate_forces(i);
+		}
+	} else {
+		WorkerThreadPool::GroupID integrate_forces_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_count, -1, true, SNAME("Physics3DIntegrateForces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(integrate_forces_task);
+	}
+
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_forces();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
@@ -260,7 +295,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody3D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -341,45 +376,53 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	// Setup, pre-solve and solve are submitted at once as a task graph, so this thread only blocks once.
+
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
-	}
+	WorkerThreadPool::GroupID setup_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
-	}
+	// Warning: This runs as a single task, because it involves thread-unsafe processing.
+	WorkerThreadPool::TaskID pre_solve_task = WorkerThreadPool::get_singleton()->add_template_dependent_task({ setup_task }, this, &GodotStep3D::_pre_solve_islands, island_count, SNAME("Physics3DConstraintPreSolveIslands"));
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	WorkerThreadPool::GroupID solve_task = WorkerThreadPool::get_singleton()->add_template_dependent_group_task({ pre_solve_task }, this, &GodotStep3D::_solve_island, nullptr, island_count, -1, SNAME("Physics3DConstraintSolveIslands"));
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(solve_task);
+	// Both already completed, this only releases them.
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(setup_task);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(pre_solve_task);
 
 	{ //profile
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, setup_constraints_endtime - profile_begtime);
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - setup_constraints_endtime);
 		profile_begtime = profile_endtime;
 	}
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	// Constraint setup can wake up bodies, so the active list is collected again.
+	_collect_active_bodies(body_list);
+
+	if (active_bodies.size() < INTEGRATE_TASK_MIN_BODIES) {
+		for (uint32_t i = 0; i < active_bodies.size(); i++) {
+			_integrate_velocities(i);
+		}
+	} else {
+		WorkerThreadPool::GroupID integrate_velocities_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(integrate_velocities_task);
+	}
+
+	// Finishing can deactivate kinematic bodies, which removes them from the active list.
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
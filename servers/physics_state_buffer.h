@@ -0,0 +1,410 @@
+/**************************************************************************/
+/*  physics_state_buffer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PHYSICS_STATE_BUFFER_H
+#define PHYSICS_STATE_BUFFER_H
+
+#include "core/io/marshalls.h"
+#include "core/math/transform_2d.h"
+#include "core/math/transform_3d.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
+#include "core/variant/variant.h"
+
+// Little-endian encoding of the blobs returned by space_save_state(), shared by the 2D and 3D servers.
+
+class PhysicsStateWriter {
+	LocalVector<uint8_t> data;
+
+	_FORCE_INLINE_ uint8_t *_grow(uint32_t p_bytes) {
+		uint32_t offset = data.size();
+		data.resize(offset + p_bytes);
+		return data.ptr() + offset;
+	}
+
+public:
+	_FORCE_INLINE_ void put_bool(bool p_value) { *_grow(1) = p_value ? 1 : 0; }
+	_FORCE_INLINE_ void put_u32(uint32_t p_value) { encode_uint32(p_value, _grow(4)); }
+	_FORCE_INLINE_ void put_u64(uint64_t p_value) { encode_uint64(p_value, _grow(8)); }
+
+	_FORCE_INLINE_ void put_real(real_t p_value) {
+#ifdef REAL_T_IS_DOUBLE
+		encode_double(p_value, _grow(8));
+#else
+		encode_float(p_value, _grow(4));
+#endif
+	}
+
+	_FORCE_INLINE_ void put_vector2(const Vector2 &p_value) {
+		put_real(p_value.x);
+		put_real(p_value.y);
+	}
+
+	_FORCE_INLINE_ void put_vector3(const Vector3 &p_value) {
+		put_real(p_value.x);
+		put_real(p_value.y);
+		put_real(p_value.z);
+	}
+
+	_FORCE_INLINE_ void put_rect2(const Rect2 &p_value) {
+		put_vector2(p_value.position);
+		put_vector2(p_value.size);
+	}
+
+	_FORCE_INLINE_ void put_aabb(const AABB &p_value) {
+		put_vector3(p_value.position);
+		put_vector3(p_value.size);
+	}
+
+	_FORCE_INLINE_ void put_transform_2d(const Transform2D &p_value) {
+		for (int i = 0; i < 3; i++) {
+			put_vector2(p_value.columns[i]);
+		}
+	}
+
+	_FORCE_INLINE_ void put_transform_3d(const Transform3D &p_value) {
+		for (int i = 0; i < 3; i++) {
+			put_vector3(p_value.basis.rows[i]);
+		}
+		put_vector3(p_value.origin);
+	}
+
+	PackedByteArray get_data() const {
+		PackedByteArray ret;
+		ret.resize(data.size());
+		if (data.size()) {
+			memcpy(ret.ptrw(), data.ptr(), data.size());
+		}
+		return ret;
+	}
+};
+
+// Reading past the end returns zeroes and flags the reader as failed, so a whole record can be read before checking.
+class PhysicsStateReader {
+	const uint8_t *data = nullptr;
+	uint32_t size = 0;
+	uint32_t position = 0;
+	bool failed = false;
+
+	_FORCE_INLINE_ const uint8_t *_advance(uint32_t p_bytes) {
+		if (failed || size - position < p_bytes) {
+			failed = true;
+			return nullptr;
+		}
+		const uint8_t *ptr = data + position;
+		position += p_bytes;
+		return ptr;
+	}
+
+public:
+	_FORCE_INLINE_ bool has_failed() const { return failed; }
+	_FORCE_INLINE_ uint32_t get_remaining() const { return size - position; }
+
+	_FORCE_INLINE_ bool get_bool() {
+		const uint8_t *ptr = _advance(1);
+		return ptr ? *ptr != 0 : false;
+	}
+
+	_FORCE_INLINE_ uint32_t get_u32() {
+		const uint8_t *ptr = _advance(4);
+		return ptr ? decode_uint32(ptr) : 0;
+	}
+
+	_FORCE_INLINE_ uint64_t get_u64() {
+		const uint8_t *ptr = _advance(8);
+		return ptr ? decode_uint64(ptr) : 0;
+	}
+
+	// Reads the size of an array, failing if there aren't enough bytes left for that many items of the given size.
+	_FORCE_INLINE_ uint32_t get_count(uint32_t p_item_size) {
+		uint32_t count = get_u32();
+		if (count > get_remaining() / p_item_size) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	_FORCE_INLINE_ real_t get_real() {
+#ifdef REAL_T_IS_DOUBLE
+		const uint8_t *ptr = _advance(8);
+		return ptr ? decode_double(ptr) : 0.0;
+#else
+		const uint8_t *ptr = _advance(4);
+		return ptr ? decode_float(ptr) : 0.0;
+#endif
+	}
+
+	_FORCE_INLINE_ Vector2 get_vector2() {
+		Vector2 ret;
+		ret.x = get_real();
+		ret.y = get_real();
+		return ret;
+	}
+
+	_FORCE_INLINE_ Vector3 get_vector3() {
+		Vector3 ret;
+		ret.x = get_real();
+		ret.y = get_real();
+		ret.z = get_real();
+		return ret;
+	}
+
+	_FORCE_INLINE_ Rect2 get_rect2() {
+		Rect2 ret;
+		ret.position = get_vector2();
+		ret.size = get_vector2();
+		return ret;
+	}
+
+	_FORCE_INLINE_ AABB get_aabb() {
+		AABB ret;
+		ret.position = get_vector3();
+		ret.size = get_vector3();
+		return ret;
+	}
+
+	_FORCE_INLINE_ Transform2D get_transform_2d() {
+		Transform2D ret;
+		for (int i = 0; i < 3; i++) {
+			ret.columns[i] = get_vector2();
+		}
+		return ret;
+	}
+
+	_FORCE_INLINE_ Transform3D get_transform_3d() {
+		Transform3D ret;
+		for (int i = 0; i < 3; i++) {
+			ret.basis.rows[i] = get_vector3();
+		}
+		ret.origin = get_vector3();
+		return ret;
+	}
+
+	PhysicsStateReader(const PackedByteArray &p_data) {
+		data = p_data.ptr();
+		size = p_data.size();
+	}
+};
+
+// Identifies a saved body pair by the RIDs of its bodies, the lowest one first, and their shape indices.
+struct PhysicsBodyPairStateKey {
+	uint64_t body_A = 0;
+	uint64_t body_B = 0;
+	uint32_t shape_A = 0;
+	uint32_t shape_B = 0;
+	uint32_t index = 0; // Of the pair or of its saved state, not part of the key.
+
+	_FORCE_INLINE_ bool operator<(const PhysicsBodyPairStateKey &p_other) const {
+		if (body_A != p_other.body_A) {
+			return body_A < p_other.body_A;
+		}
+		if (body_B != p_other.body_B) {
+			return body_B < p_other.body_B;
+		}
+		if (shape_A != p_other.shape_A) {
+			return shape_A < p_other.shape_A;
+		}
+		return shape_B < p_other.shape_B;
+	}
+
+	_FORCE_INLINE_ bool matches(const PhysicsBodyPairStateKey &p_other) const {
+		return body_A == p_other.body_A && body_B == p_other.body_B && shape_A == p_other.shape_A && shape_B == p_other.shape_B;
+	}
+
+	void write(PhysicsStateWriter &p_writer) const {
+		p_writer.put_u64(body_A);
+		p_writer.put_u32(shape_A);
+		p_writer.put_u64(body_B);
+		p_writer.put_u32(shape_B);
+	}
+
+	void read(PhysicsStateReader &p_reader) {
+		body_A = p_reader.get_u64();
+		shape_A = p_reader.get_u32();
+		body_B = p_reader.get_u64();
+		shape_B = p_reader.get_u32();
+	}
+
+	PhysicsBodyPairStateKey() {}
+
+	template <class T_BodyPair>
+	PhysicsBodyPairStateKey(const T_BodyPair *p_pair, uint32_t p_index) {
+		body_A = p_pair->get_body_A()->get_self().get_id();
+		body_B = p_pair->get_body_B()->get_self().get_id();
+		shape_A = p_pair->get_shape_A();
+		shape_B = p_pair->get_shape_B();
+		index = p_index;
+	}
+};
+
+struct PhysicsStateRIDSort {
+	template <class T>
+	_FORCE_INLINE_ bool operator()(const T *p_a, const T *p_b) const {
+		return p_a->get_self().get_id() < p_b->get_self().get_id();
+	}
+};
+
+// Implements save_state() and restore_state() for GodotSpace2D and GodotSpace3D, which only differ by their types.
+template <class T_Space, class T_CollisionObject, class T_Body, class T_BodyPair>
+class PhysicsSpaceState {
+	static constexpr uint32_t VERSION = 2;
+
+	static void _get_bodies(const T_Space *p_space, LocalVector<T_Body *> &r_bodies) {
+		for (T_CollisionObject *E : p_space->get_objects()) {
+			if (E->get_type() == T_CollisionObject::TYPE_BODY) {
+				r_bodies.push_back(static_cast<T_Body *>(E));
+			}
+		}
+		r_bodies.template sort_custom<PhysicsStateRIDSort>();
+	}
+
+	static void _get_pairs(const T_Space *p_space, LocalVector<T_BodyPair *> &r_pairs, LocalVector<PhysicsBodyPairStateKey> &r_keys) {
+		for (const SelfList<T_BodyPair> *E = p_space->get_body_pair_list().first(); E; E = E->next()) {
+			r_keys.push_back(PhysicsBodyPairStateKey(E->self(), r_pairs.size()));
+			r_pairs.push_back(E->self());
+		}
+		r_keys.sort();
+	}
+
+public:
+	// Bodies and pairs are written sorted by RID, so the same state always gives the same bytes.
+	static PackedByteArray save(const T_Space *p_space, uint32_t p_magic) {
+		LocalVector<T_Body *> bodies;
+		_get_bodies(p_space, bodies);
+
+		LocalVector<T_BodyPair *> pairs;
+		LocalVector<PhysicsBodyPairStateKey> pair_keys;
+		_get_pairs(p_space, pairs, pair_keys);
+
+		PhysicsStateWriter writer;
+		writer.put_u32(p_magic);
+		writer.put_u32(VERSION);
+		writer.put_u32(sizeof(real_t));
+
+		writer.put_u32(bodies.size());
+		for (const T_Body *body : bodies) {
+			typename T_Body::SavedState state;
+			body->save_state(state);
+			writer.put_u64(body->get_self().get_id());
+			state.write(writer);
+		}
+
+		writer.put_u32(pair_keys.size());
+		for (const PhysicsBodyPairStateKey &key : pair_keys) {
+			typename T_BodyPair::SavedState state;
+			pairs[key.index]->save_state(state);
+			key.write(writer);
+			state.write(writer);
+		}
+
+		return writer.get_data();
+	}
+
+	static Error restore(T_Space *p_space, uint32_t p_magic, const PackedByteArray &p_state) {
+		PhysicsStateReader reader(p_state);
+		uint32_t magic = reader.get_u32();
+		uint32_t version = reader.get_u32();
+		ERR_FAIL_COND_V_MSG(magic != p_magic || version != VERSION, ERR_INVALID_DATA, "Invalid physics space state.");
+		ERR_FAIL_COND_V_MSG(reader.get_u32() != sizeof(real_t), ERR_INVALID_DATA, "Physics space state was saved with a different floating-point precision.");
+
+		// Read and validate everything first, so the space is left untouched on error.
+		HashMap<uint64_t, T_Body *> body_map;
+		for (T_CollisionObject *E : p_space->get_objects()) {
+			if (E->get_type() == T_CollisionObject::TYPE_BODY) {
+				body_map.insert(E->get_self().get_id(), static_cast<T_Body *>(E));
+			}
+		}
+
+		uint32_t body_count = reader.get_count(sizeof(uint64_t));
+		ERR_FAIL_COND_V_MSG(reader.has_failed(), ERR_INVALID_DATA, "Invalid physics space state.");
+		LocalVector<T_Body *> bodies;
+		LocalVector<typename T_Body::SavedState> body_states;
+		bodies.resize(body_count);
+		body_states.resize(body_count);
+		for (uint32_t i = 0; i < body_count; i++) {
+			uint64_t id = reader.get_u64();
+			body_states[i].read(reader);
+			ERR_FAIL_COND_V_MSG(reader.has_failed(), ERR_INVALID_DATA, "Invalid physics space state.");
+			T_Body **body = body_map.getptr(id);
+			ERR_FAIL_NULL_V_MSG(body, ERR_INVALID_DATA, "Physics space state contains a body that is not in this space anymore.");
+			ERR_FAIL_COND_V_MSG(body_states[i].shape_aabbs.size() != (uint32_t)(*body)->get_shape_count(), ERR_INVALID_DATA, "Physics space state doesn't match the shapes of a body.");
+			bodies[i] = *body;
+		}
+
+		uint32_t pair_count = reader.get_count(sizeof(uint64_t) * 2);
+		ERR_FAIL_COND_V_MSG(reader.has_failed(), ERR_INVALID_DATA, "Invalid physics space state.");
+		LocalVector<PhysicsBodyPairStateKey> saved_pair_keys;
+		LocalVector<typename T_BodyPair::SavedState> pair_states;
+		saved_pair_keys.resize(pair_count);
+		pair_states.resize(pair_count);
+		for (uint32_t i = 0; i < pair_count; i++) {
+			saved_pair_keys[i].read(reader);
+			saved_pair_keys[i].index = i;
+			pair_states[i].read(reader);
+		}
+		ERR_FAIL_COND_V_MSG(reader.has_failed() || reader.get_remaining() != 0, ERR_INVALID_DATA, "Invalid physics space state.");
+
+		// Deactivating first puts the restored bodies back in the active list in RID order.
+		for (T_Body *body : bodies) {
+			body->set_active(false);
+		}
+		for (uint32_t i = 0; i < body_count; i++) {
+			bodies[i]->restore_state(body_states[i]);
+		}
+
+		// Which pairs the broadphase keeps, and in which order it reports them, depends on its whole history.
+		// Rebuilding it from scratch makes stepping after a restore depend on the saved state only,
+		// then the pairs that existed when saving get their contacts back.
+		p_space->rebuild_broadphase();
+
+		LocalVector<T_BodyPair *> pairs;
+		LocalVector<PhysicsBodyPairStateKey> pair_keys;
+		_get_pairs(p_space, pairs, pair_keys);
+		saved_pair_keys.sort();
+
+		uint32_t saved_index = 0;
+		for (const PhysicsBodyPairStateKey &key : pair_keys) {
+			while (saved_index < pair_count && saved_pair_keys[saved_index] < key) {
+				saved_index++;
+			}
+			if (saved_index < pair_count && saved_pair_keys[saved_index].matches(key)) {
+				pairs[key.index]->restore_state(pair_states[saved_pair_keys[saved_index].index]);
+			} else {
+				pairs[key.index]->reset_state();
+			}
+		}
+
+		return OK;
+	}
+};
+
+#endif // PHYSICS_STATE_BUFFER_H
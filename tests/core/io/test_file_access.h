@@ -31,7 +31,13 @@
 #ifndef TEST_FILE_ACCESS_H
 #define TEST_FILE_ACCESS_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
+#include "core/io/pck_packer.h"
+#include "core/object/script_language.h"
+#include "core/os/os.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -105,6 +111,157 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Memory mapping") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("translations.csv"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+
+	const uint8_t *mapped = f->map_memory();
+	if (!mapped) {
+		// Not supported by this platform.
+		return;
+	}
+	CHECK_MESSAGE(f->map_memory() == mapped, "Mapping the same file twice should return the same view.");
+
+	Vector<uint8_t> contents = f->get_buffer(f->get_length());
+	REQUIRE(contents.size() == int64_t(f->get_length()));
+	CHECK(memcmp(contents.ptr(), mapped, contents.size()) == 0);
+
+	const String write_path = OS::get_singleton()->get_cache_path().path_join("mapped_write.txt");
+	Ref<FileAccess> f_write = FileAccess::open(write_path, FileAccess::WRITE);
+	REQUIRE(!f_write.is_null());
+	CHECK_MESSAGE(f_write->map_memory() == nullptr, "Files opened for writing should never be mapped.");
+	f_write.unref();
+	DirAccess::remove_absolute(write_path);
+}
+
+TEST_CASE("[FileAccess] Reading from memory mapped packs") {
+	const String source_path = OS::get_singleton()->get_cache_path().path_join("mapped_pack_source.bin");
+	const String pack_path = OS::get_singleton()->get_cache_path().path_join("mapped_pack.pck");
+
+	Vector<uint8_t> data;
+	data.resize(1000);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i * 7) & 0xff;
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(!f.is_null());
+		f->store_buffer(data.ptr(), data.size());
+	}
+
+	// Encrypted with the key packs are decrypted with.
+	String key;
+	for (int i = 0; i < 32; i++) {
+		key += String::num_int64(script_encryption_key[i], 16).lpad(2, "0");
+	}
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(pack_path, 32, key) == OK);
+	REQUIRE(pck_packer.add_file("res://mapped_pack/plain.bin", source_path) == OK);
+	REQUIRE(pck_packer.add_file("res://mapped_pack/encrypted.bin", source_path, true) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	bool mapping_supported = false;
+	{
+		Ref<FileAccess> f = FileAccess::open(pack_path, FileAccess::READ);
+		REQUIRE(!f.is_null());
+		mapping_supported = f->map_memory() != nullptr;
+	}
+
+	for (int mapping = 0; mapping < 2; mapping++) {
+		PackedData *packed_data = memnew(PackedData);
+		packed_data->set_memory_mapping_enabled(mapping);
+		REQUIRE(packed_data->add_pack(pack_path, false, 0) == OK);
+
+		const String paths[] = { "res://mapped_pack/plain.bin", "res://mapped_pack/encrypted.bin" };
+		for (const String &path : paths) {
+			Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+			REQUIRE_MESSAGE(!f.is_null(), vformat("\"%s\" should open from the pack.", path));
+
+			// Encrypted files are always decrypted through a nested file.
+			const bool mapped = mapping && mapping_supported && path.ends_with("plain.bin");
+			CHECK_MESSAGE((f->map_memory() != nullptr) == mapped, vformat("\"%s\" should %sbe read from the mapping.", path, mapped ? "" : "not "));
+
+			CHECK(f->get_length() == uint64_t(data.size()));
+			CHECK(f->get_buffer(data.size()) == data);
+			CHECK(!f->eof_reached());
+			f->get_8();
+			CHECK(f->eof_reached());
+
+			f->seek(10);
+			CHECK(f->get_8() == data[10]);
+			CHECK(f->get_32() == decode_uint32(data.ptr() + 11));
+			CHECK(f->get_64() == decode_uint64(data.ptr() + 15));
+			f->seek(data.size() - 2);
+			CHECK(f->get_buffer(10).size() == 2);
+			CHECK(f->eof_reached());
+		}
+
+		memdelete(packed_data);
+	}
+
+	DirAccess::remove_absolute(pack_path);
+	DirAccess::remove_absolute(source_path);
+}
+
+TEST_CASE("[FileAccess] Compressed files") {
+	// Several blocks, so the last one is partial and reading crosses block boundaries.
+	const int size = 65536 * 5 + 1234;
+	Vector<uint8_t> data;
+	data.resize(size);
+	for (int i = 0; i < size; i++) {
+		data.write[i] = (i * 7 + i / 1000) & 0xff;
+	}
+
+	const String path = OS::get_singleton()->get_cache_path().path_join("compressed.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(!f.is_null());
+		f->store_buffer(data.ptr(), size);
+	}
+
+	Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(!f.is_null());
+	CHECK(f->get_length() == uint64_t(size));
+
+	Vector<uint8_t> contents = f->get_buffer(size);
+	CHECK(contents == data);
+	CHECK(f->get_position() == uint64_t(size));
+	CHECK(!f->eof_reached());
+	f->get_8();
+	CHECK(f->eof_reached());
+
+	const int positions[] = { 200000, 0, 65535, 65536, size - 1, 131071 };
+	for (int pos : positions) {
+		f->seek(pos);
+		CHECK(f->get_position() == uint64_t(pos));
+		CHECK_MESSAGE(f->get_8() == data[pos], vformat("Reading after seeking to %d.", pos));
+	}
+
+	f->seek(65530);
+	Vector<uint8_t> across = f->get_buffer(20);
+	CHECK(across == data.slice(65530, 65550));
+
+	f->seek(size - 10);
+	CHECK(f->get_buffer(20).size() == 10);
+	CHECK(f->eof_reached());
+
+	// A block-aligned size, empty files and files smaller than a block.
+	const int sizes[] = { 65536 * 2, 0, 100 };
+	for (int s : sizes) {
+		{
+			Ref<FileAccess> fw = FileAccess::open_compressed(path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+			REQUIRE(!fw.is_null());
+			fw->store_buffer(data.ptr(), s);
+		}
+		Ref<FileAccess> fr = FileAccess::open_compressed(path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(!fr.is_null());
+		CHECK(fr->get_length() == uint64_t(s));
+		CHECK(fr->get_buffer(s) == data.slice(0, s));
+		fr->get_8();
+		CHECK(fr->eof_reached());
+	}
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
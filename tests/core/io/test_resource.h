@@ -34,6 +34,7 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -109,6 +110,277 @@ TEST_CASE("[Resource] Saving and loading") {
 			loaded_child_resource_text->get_name() == "I'm a child resource",
 			"The loaded child resource name should be equal to the expected value.");
 }
+
+TEST_CASE("[Resource] Saving and loading packed arrays") {
+	PackedByteArray bytes;
+	PackedInt32Array ints;
+	PackedFloat64Array doubles;
+	PackedVector3Array vectors;
+	PackedColorArray colors;
+	// Large enough to span several compressed blocks.
+	for (int i = 0; i < 100000; i++) {
+		bytes.push_back(i % 7);
+		ints.push_back(i * 3);
+		doubles.push_back(i * 0.25);
+		vectors.push_back(Vector3(i, -i, i * 0.5));
+		colors.push_back(Color(i % 2, 0.5, 0.25, 1.0));
+	}
+	// Also store a small array, and an odd-sized one which misaligns what follows.
+	PackedFloat32Array small_floats = { 1.5, -2.0, 3.25 };
+	PackedByteArray odd_bytes = { 1, 2, 3 };
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("bytes", bytes);
+	resource->set_meta("odd_bytes", odd_bytes);
+	resource->set_meta("ints", ints);
+	resource->set_meta("doubles", doubles);
+	resource->set_meta("vectors", vectors);
+	resource->set_meta("colors", colors);
+	resource->set_meta("small_floats", small_floats);
+
+	const uint32_t flags[] = { ResourceSaver::FLAG_NONE, ResourceSaver::FLAG_COMPRESS_PACKED_ARRAYS };
+	for (uint32_t flag : flags) {
+		const String save_path = OS::get_singleton()->get_cache_path().path_join("resource_packed_arrays.res");
+		REQUIRE(ResourceSaver::save(resource, save_path, flag) == OK);
+
+		Ref<Resource> loaded_resource = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded_resource.is_valid());
+		CHECK(loaded_resource->get_meta("bytes") == Variant(bytes));
+		CHECK(loaded_resource->get_meta("odd_bytes") == Variant(odd_bytes));
+		CHECK(loaded_resource->get_meta("ints") == Variant(ints));
+		CHECK(loaded_resource->get_meta("doubles") == Variant(doubles));
+		CHECK(loaded_resource->get_meta("vectors") == Variant(vectors));
+		CHECK(loaded_resource->get_meta("colors") == Variant(colors));
+		CHECK(loaded_resource->get_meta("small_floats") == Variant(small_floats));
+	}
+}
+
+// Saves a resource referencing `p_count` external resources, which are saved next to it.
+static String save_resource_with_dependencies(const String &p_name, int p_count) {
+	const String base_path = OS::get_singleton()->get_cache_path().path_join(p_name);
+	Ref<Resource> resource = memnew(Resource);
+	Array dependencies;
+	for (int i = 0; i < p_count; i++) {
+		Ref<Resource> dependency = memnew(Resource);
+		dependency->set_name(itos(i));
+		dependency->set_meta("data", PackedInt32Array({ i, i + 1, i + 2 }));
+		const String dependency_path = base_path + "_dependency_" + itos(i) + ".res";
+		ResourceSaver::save(dependency, dependency_path);
+		dependency->set_path(dependency_path);
+		dependencies.push_back(dependency);
+	}
+	resource->set_meta("dependencies", dependencies);
+	const String save_path = base_path + ".res";
+	ResourceSaver::save(resource, save_path);
+	return save_path;
+}
+
+TEST_CASE("[Resource] Threaded loading with external dependencies") {
+	const String save_path = save_resource_with_dependencies("resource_threaded", 16);
+
+	REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true) == OK);
+	Error err = FAILED;
+	Ref<Resource> loaded_resource = ResourceLoader::load_threaded_get(save_path, &err);
+	REQUIRE(err == OK);
+	REQUIRE(loaded_resource.is_valid());
+
+	const Array dependencies = loaded_resource->get_meta("dependencies");
+	REQUIRE(dependencies.size() == 16);
+	for (int i = 0; i < dependencies.size(); i++) {
+		const Ref<Resource> dependency = dependencies[i];
+		REQUIRE(dependency.is_valid());
+		CHECK(dependency->get_name() == itos(i));
+		CHECK(dependency->get_meta("data") == Variant(PackedInt32Array({ i, i + 1, i + 2 })));
+	}
+	CHECK_MESSAGE(
+			ResourceLoader::load_threaded_get_status(save_path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE,
+			"The load task should be released once its result was retrieved.");
+}
+
+struct PoolThreadLoad {
+	String path;
+	SafeNumeric<uint32_t> loaded;
+};
+
+static void _load_on_pool_thread(void *p_userdata, uint32_t p_index) {
+	PoolThreadLoad *load = (PoolThreadLoad *)p_userdata;
+	if (ResourceLoader::load_threaded_request(load->path, "", true) != OK) {
+		return;
+	}
+	Ref<Resource> resource = ResourceLoader::load_threaded_get(load->path);
+	if (resource.is_valid() && Array(resource->get_meta("dependencies")).size() == 16) {
+		load->loaded.increment();
+	}
+}
+
+TEST_CASE("[Resource] Threaded loading from pool threads") {
+	// Several workers load the same resource at once. All but one of them wait for a load they don't own,
+	// while that load and its dependencies may be queued on their own threads.
+	PoolThreadLoad load;
+	load.path = save_resource_with_dependencies("resource_pool_threads", 16);
+
+	const int load_count = MAX(4, WorkerThreadPool::get_singleton()->get_thread_count() * 2);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_load_on_pool_thread, &load, load_count, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK_MESSAGE(load.loaded.get() == uint32_t(load_count), "Every worker should get the loaded resource with its dependencies.");
+	CHECK(ResourceLoader::load_threaded_get_status(load.path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+}
+
+TEST_CASE("[Resource] Threaded loading with shared dependencies") {
+	// The scene depends on A and C, A depends on B and C depends on A. Depending on scheduling, C may
+	// request A while A waits for B on the same worker, which is not a cyclic load.
+	const String base_path = OS::get_singleton()->get_cache_path().path_join("resource_diamond");
+	const String scene_path = base_path + ".res";
+	const String a_path = base_path + "_a.res";
+	const String b_path = base_path + "_b.res";
+	const String c_path = base_path + "_c.res";
+	{
+		Ref<Resource> b = memnew(Resource);
+		b->set_name("b");
+		ResourceSaver::save(b, b_path);
+		b->set_path(b_path);
+
+		Ref<Resource> a = memnew(Resource);
+		a->set_name("a");
+		a->set_meta("dependency", b);
+		ResourceSaver::save(a, a_path);
+		a->set_path(a_path);
+
+		Ref<Resource> c = memnew(Resource);
+		c->set_name("c");
+		c->set_meta("dependency", a);
+		ResourceSaver::save(c, c_path);
+		c->set_path(c_path);
+
+		Ref<Resource> scene = memnew(Resource);
+		Array dependencies;
+		dependencies.push_back(a);
+		dependencies.push_back(c);
+		scene->set_meta("dependencies", dependencies);
+		ResourceSaver::save(scene, scene_path);
+	}
+
+	for (int i = 0; i < 20; i++) {
+		REQUIRE(ResourceLoader::load_threaded_request(scene_path, "", true) == OK);
+		Error err = FAILED;
+		Ref<Resource> scene = ResourceLoader::load_threaded_get(scene_path, &err);
+		REQUIRE(err == OK);
+		REQUIRE(scene.is_valid());
+
+		const Array dependencies = scene->get_meta("dependencies");
+		REQUIRE(dependencies.size() == 2);
+		const Ref<Resource> a = dependencies[0];
+		const Ref<Resource> c = dependencies[1];
+		REQUIRE(a.is_valid());
+		REQUIRE(c.is_valid());
+		CHECK(a->get_name() == "a");
+		CHECK(c->get_name() == "c");
+		CHECK_MESSAGE(Ref<Resource>(c->get_meta("dependency")) == a, "Both paths to A should get the same resource.");
+		const Ref<Resource> b = a->get_meta("dependency");
+		REQUIRE(b.is_valid());
+		CHECK(b->get_name() == "b");
+	}
+}
+
+TEST_CASE("[Resource] Sharing identical built-in subresources") {
+	Vector<String> paths;
+	for (int i = 0; i < 4; i++) {
+		Ref<Resource> resource = memnew(Resource);
+		Ref<Resource> shared_child = memnew(Resource);
+		shared_child->set_meta("data", PackedInt32Array({ 1, 2, 3 }));
+		Ref<Resource> own_child = memnew(Resource);
+		own_child->set_meta("data", PackedInt32Array({ i }));
+		Ref<Resource> local_child = memnew(Resource);
+		local_child->set_local_to_scene(true);
+		resource->set_meta("shared_child", shared_child);
+		resource->set_meta("own_child", own_child);
+		resource->set_meta("local_child", local_child);
+
+		// Both formats load built-in subresources on their own.
+		const String path = OS::get_singleton()->get_cache_path().path_join("resource_shared_" + itos(i) + (i % 2 ? ".res" : ".tres"));
+		REQUIRE(ResourceSaver::save(resource, path) == OK);
+		paths.push_back(path);
+	}
+
+	ResourceLoader::set_share_subresources(true);
+	const uint32_t hits_before = ResourceCache::get_shared_hit_count();
+	const uint64_t saved_before = ResourceCache::get_shared_bytes_saved();
+
+	Vector<Ref<Resource>> loaded;
+	for (const String &path : paths) {
+		Ref<Resource> resource = ResourceLoader::load(path);
+		REQUIRE(resource.is_valid());
+		loaded.push_back(resource);
+	}
+	ResourceLoader::set_share_subresources(false);
+
+	const Ref<Resource> first_shared = loaded[0]->get_meta("shared_child");
+	for (int i = 0; i < loaded.size(); i++) {
+		const Ref<Resource> shared_child = loaded[i]->get_meta("shared_child");
+		CHECK_MESSAGE(shared_child == first_shared, "Identical subresources should be loaded as a single instance.");
+		const Ref<Resource> own_child = loaded[i]->get_meta("own_child");
+		CHECK(own_child->get_meta("data") == Variant(PackedInt32Array({ i })));
+		for (int j = 0; j < i; j++) {
+			CHECK(loaded[j]->get_meta("own_child") != Variant(own_child));
+			CHECK(loaded[j]->get_meta("local_child") != loaded[i]->get_meta("local_child"));
+		}
+	}
+
+	CHECK(ResourceCache::get_shared_hit_count() - hits_before == 3);
+	CHECK(ResourceCache::get_shared_bytes_saved() > saved_before);
+}
+
+TEST_BENCHMARK("[Resource] Load a resource with 1000 external dependencies") {
+	const String save_path = save_resource_with_dependencies("resource_benchmark", 1000);
+
+	for (int use_sub_threads = 0; use_sub_threads < 2; use_sub_threads++) {
+		// Everything is released after each iteration, so nothing is reused from the resource cache.
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		REQUIRE(ResourceLoader::load_threaded_request(save_path, "", use_sub_threads) == OK);
+		Ref<Resource> loaded_resource = ResourceLoader::load_threaded_get(save_path);
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+		REQUIRE(loaded_resource.is_valid());
+		CHECK(Array(loaded_resource->get_meta("dependencies")).size() == 1000);
+
+		MESSAGE(vformat("Loading with sub-threads %s: %d usec.", use_sub_threads ? "enabled" : "disabled", elapsed));
+	}
+}
+
+TEST_BENCHMARK("[Resource] Load a large text resource") {
+	// Similar to what level tools generate: many subresources holding large packed arrays.
+	Ref<Resource> resource = memnew(Resource);
+	Array subresources;
+	for (int i = 0; i < 200; i++) {
+		Ref<Resource> subresource = memnew(Resource);
+		subresource->set_name("Subresource " + itos(i));
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		PackedColorArray colors;
+		for (int j = 0; j < 5000; j++) {
+			vertices.push_back(Vector3(j * 0.125, -j * 0.5, i + j * 0.0625));
+			indices.push_back(j * 3 + i);
+			colors.push_back(Color(0.5, j % 2, 0.25, 1.0));
+		}
+		subresource->set_meta("vertices", vertices);
+		subresource->set_meta("indices", indices);
+		subresource->set_meta("colors", colors);
+		subresources.push_back(subresource);
+	}
+	resource->set_meta("subresources", subresources);
+
+	const String save_path = OS::get_singleton()->get_cache_path().path_join("resource_large.tres");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+	const uint64_t size = FileAccess::get_file_as_bytes(save_path).size();
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Ref<Resource> loaded_resource = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(Array(loaded_resource->get_meta("subresources")).size() == 200);
+
+	MESSAGE(vformat("Loaded %.1f MiB in %d usec (%.1f MiB/s).", size / 1048576.0, elapsed, size / 1048576.0 / (elapsed / 1000000.0)));
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
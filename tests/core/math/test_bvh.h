@@ -0,0 +1,127 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct PairingItem {
+	int id = 0;
+};
+
+template <class T>
+class PairingTestFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		// Odd items don't pair with each other, to check pairs rejected by the user function.
+		return (p_a->id % 2 == 0) || (p_b->id % 2 == 0);
+	}
+};
+
+template <class T>
+class PairingCullFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<PairingItem, 1, true, 32, PairingTestFunction<PairingItem>, PairingCullFunction<PairingItem>> PairingBVH;
+
+// Records every pair and unpair as "+a,b" and "-a,b", in the order they happen.
+static void *pairing_pair_callback(void *p_self, uint32_t, PairingItem *p_a, int, uint32_t, PairingItem *p_b, int) {
+	Vector<String> *log = (Vector<String> *)p_self;
+	log->push_back(vformat("+%d,%d", p_a->id, p_b->id));
+	return nullptr;
+}
+
+static void pairing_unpair_callback(void *p_self, uint32_t, PairingItem *p_a, int, uint32_t, PairingItem *p_b, int, void *) {
+	Vector<String> *log = (Vector<String> *)p_self;
+	log->push_back(vformat("-%d,%d", p_a->id, p_b->id));
+}
+
+static AABB random_item_aabb(RandomPCG &p_rng) {
+	Vector3 position(p_rng.randf() * 100, p_rng.randf() * 100, p_rng.randf() * 100);
+	return AABB(position, Vector3(1, 1, 1) * (1 + p_rng.randf() * 4));
+}
+
+static void run_pairing(bool p_threaded, const Vector<PairingItem> &p_items, Vector<String> &r_log) {
+	PairingBVH bvh;
+	bvh.params_set_threaded_pairing(p_threaded);
+	// Both callbacks get the pair callback userdata.
+	bvh.set_pair_callback(pairing_pair_callback, &r_log);
+	bvh.set_unpair_callback(pairing_unpair_callback, &r_log);
+
+	RandomPCG rng(1234);
+	LocalVector<BVHHandle> handles;
+	for (int i = 0; i < p_items.size(); i++) {
+		handles.push_back(bvh.create(const_cast<PairingItem *>(&p_items[i]), true, 0, 1, random_item_aabb(rng)));
+	}
+	bvh.update();
+
+	// Moving every item puts them all on the changed list at once.
+	for (int step = 0; step < 3; step++) {
+		for (const BVHHandle &h : handles) {
+			bvh.move(h, random_item_aabb(rng));
+		}
+		bvh.update();
+	}
+
+	for (const BVHHandle &h : handles) {
+		bvh.erase(h);
+	}
+}
+
+TEST_CASE("[BVH] Threaded pairing matches serial pairing") {
+	Vector<PairingItem> items;
+	items.resize(1000);
+	for (int i = 0; i < items.size(); i++) {
+		items.write[i].id = i;
+	}
+
+	Vector<String> serial_log;
+	run_pairing(false, items, serial_log);
+
+	Vector<String> threaded_log;
+	run_pairing(true, items, threaded_log);
+
+	CHECK_MESSAGE(serial_log.size() > 100, "Items should pair and unpair as they move.");
+	CHECK_MESSAGE(serial_log == threaded_log, "Pairs and unpairs should be the same, and in the same order, when pairing on worker threads.");
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
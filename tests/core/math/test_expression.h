@@ -32,6 +32,7 @@
 #define TEST_EXPRESSION_H
 
 #include "core/math/expression.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -321,6 +322,112 @@ TEST_CASE("[Expression] Expressions with variables") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[Expression] Repeated execution with changing input types") {
+	Expression expression;
+
+	PackedStringArray parameter_names;
+	parameter_names.push_back("a");
+	parameter_names.push_back("b");
+	CHECK_MESSAGE(
+			expression.parse("a + b * 2", parameter_names) == OK,
+			"The expression should parse successfully.");
+
+	Array ints;
+	ints.push_back(1);
+	ints.push_back(2);
+	CHECK_MESSAGE(
+			Variant(expression.execute(ints)) == Variant(5),
+			"The expression should return the expected value with integers.");
+
+	Array floats;
+	floats.push_back(0.5);
+	floats.push_back(1.25);
+	CHECK_MESSAGE(
+			Variant(expression.execute(floats)) == Variant(3.0),
+			"The expression should return the expected value with floats.");
+
+	Array vectors;
+	vectors.push_back(Vector2(1, 2));
+	vectors.push_back(Vector2(3, 4));
+	CHECK_MESSAGE(
+			Variant(expression.execute(vectors)) == Variant(Vector2(7, 10)),
+			"The expression should return the expected value with vectors.");
+
+	Array strings;
+	strings.push_back("a");
+	strings.push_back("b");
+	ERR_PRINT_OFF;
+	expression.execute(strings);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			expression.has_execute_failed(),
+			"Multiplying a string should fail.");
+
+	CHECK_MESSAGE(
+			Variant(expression.execute(ints)) == Variant(5),
+			"The expression should work again after a failed execution.");
+	CHECK_FALSE(expression.has_execute_failed());
+
+	CHECK_MESSAGE(
+			expression.parse("a / b", parameter_names) == OK,
+			"The expression should parse successfully.");
+	Array zero;
+	zero.push_back(1);
+	zero.push_back(0);
+	ERR_PRINT_OFF;
+	expression.execute(zero);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			expression.has_execute_failed(),
+			"Integer division by zero should still fail.");
+}
+
+TEST_CASE("[Expression] Batched execution") {
+	Expression expression;
+
+	PackedStringArray parameter_names;
+	parameter_names.push_back("v");
+	parameter_names.push_back("s");
+	CHECK_MESSAGE(
+			expression.parse("[v.length() + v.x, s.split(\",\"), max(v.y, 1.5), Vector2(2, 3) * 2]", parameter_names) == OK,
+			"The expression should parse successfully.");
+
+	Array rows;
+	for (int i = 0; i < 3; i++) {
+		Array row;
+		row.push_back(Vector2(3, 4) * i);
+		row.push_back(itos(i) + "," + itos(i + 1));
+		rows.push_back(row);
+	}
+
+	Array results = expression.execute_batch(rows);
+	CHECK_FALSE(expression.has_execute_failed());
+	REQUIRE(results.size() == 3);
+	for (int i = 0; i < 3; i++) {
+		const Array result = results[i];
+		const PackedStringArray split = result[1];
+		CHECK(double(result[0]) == doctest::Approx(8.0 * i));
+		CHECK(split.size() == 2);
+		CHECK(split[0] == itos(i));
+		CHECK(double(result[2]) == doctest::Approx(MAX(4.0 * i, 1.5)));
+		CHECK(Vector2(result[3]) == Vector2(4, 6));
+		CHECK(Variant(results[i]) == expression.execute(rows[i]));
+	}
+
+	Array invalid_rows;
+	invalid_rows.push_back(rows[0]);
+	Array missing_input;
+	missing_input.push_back(Vector2());
+	invalid_rows.push_back(missing_input);
+	ERR_PRINT_OFF;
+	CHECK(expression.execute_batch(invalid_rows).is_empty());
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			expression.has_execute_failed(),
+			"A row with a missing input should make the batch fail.");
+	CHECK(expression.get_error_text() == "Invalid input 1 (not passed) in expression");
+}
+
 TEST_CASE("[Expression] Invalid expressions") {
 	Expression expression;
 
@@ -439,6 +546,58 @@ TEST_CASE("[Expression] Unusual expressions") {
 	//		int64_t(expression.execute()) == 0,
 	//		"`(-9223372036854775807 - 1) / -1` should return the expected result.");
 }
+
+TEST_BENCHMARK("[Expression] Execute rows one at a time and in a batch") {
+	Expression expression;
+	PackedStringArray parameter_names;
+	parameter_names.push_back("x");
+	parameter_names.push_back("y");
+	parameter_names.push_back("scale");
+	parameter_names.push_back("dir");
+	REQUIRE(expression.parse("sqrt(x * x + y * y) * scale + Vector2(x, y).dot(dir) - abs(y - 0.5) * 2.0", parameter_names) == OK);
+
+	const int row_count = 100000;
+	Array rows;
+	rows.resize(row_count);
+	for (int i = 0; i < row_count; i++) {
+		Array row;
+		row.push_back(i * 0.01);
+		row.push_back(i * 0.02);
+		row.push_back(1.5);
+		row.push_back(Vector2(0.6, 0.8));
+		rows[i] = row;
+	}
+
+	double total = 0.0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < row_count; i++) {
+		total += double(expression.execute(rows[i]));
+	}
+	uint64_t execute_elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Array results = expression.execute_batch(rows);
+	uint64_t batch_elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	REQUIRE(results.size() == row_count);
+	double batch_total = 0.0;
+	for (int i = 0; i < row_count; i++) {
+		batch_total += double(results[i]);
+	}
+	CHECK(batch_total == total);
+
+	// The same rows through the tree walker the program replaced.
+	expression.set_use_program(false);
+	double tree_total = 0.0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < row_count; i++) {
+		tree_total += double(expression.execute(rows[i]));
+	}
+	uint64_t tree_elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(tree_total == total);
+
+	MESSAGE(vformat("%d rows, tree walker: %d usec, execute(): %d usec, execute_batch(): %d usec.", row_count, tree_elapsed, execute_elapsed, batch_elapsed));
+}
 } // namespace TestExpression
 
 #endif // TEST_EXPRESSION_H
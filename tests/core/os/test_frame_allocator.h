@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  test_frame_allocator.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ALLOCATOR_H
+#define TEST_FRAME_ALLOCATOR_H
+
+#include "core/os/frame_allocator.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameAllocator {
+
+TEST_CASE("[FrameAllocator] Allocations are aligned and distinct") {
+	FrameAllocator::next_frame();
+
+	uint8_t *a = (uint8_t *)FrameAllocator::alloc(3);
+	uint8_t *b = (uint8_t *)FrameAllocator::alloc(100);
+	CHECK(((uintptr_t)a % PAD_ALIGN) == 0);
+	CHECK(((uintptr_t)b % PAD_ALIGN) == 0);
+	CHECK(b >= a + 3);
+
+	memset(a, 0xAA, 3);
+	memset(b, 0xBB, 100);
+	CHECK(a[2] == 0xAA);
+	CHECK(b[0] == 0xBB);
+}
+
+TEST_CASE("[FrameAllocator] Reallocation keeps contents") {
+	FrameAllocator::next_frame();
+
+	uint32_t *data = (uint32_t *)FrameAllocator::alloc(sizeof(uint32_t) * 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		data[i] = i;
+	}
+	// Growing the last allocation happens in place.
+	uint32_t *grown = (uint32_t *)FrameAllocator::realloc(data, sizeof(uint32_t) * 64);
+	CHECK(grown == data);
+
+	// Growing an older allocation copies it.
+	FrameAllocator::alloc(16);
+	uint32_t *moved = (uint32_t *)FrameAllocator::realloc(grown, sizeof(uint32_t) * 128);
+	CHECK(moved != grown);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(moved[i] == i);
+	}
+
+	// Larger than a chunk.
+	uint8_t *large = (uint8_t *)FrameAllocator::alloc(1024 * 1024);
+	large[1024 * 1024 - 1] = 1;
+	CHECK(large[1024 * 1024 - 1] == 1);
+}
+
+TEST_CASE("[FrameAllocator] FrameLocalVector") {
+	FrameAllocator::next_frame();
+
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 10000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 10000);
+	CHECK(vector[0] == 0);
+	CHECK(vector[9999] == 9999);
+
+	FrameAllocator::next_frame();
+	CHECK(FrameAllocator::get_last_frame_usage() >= sizeof(int) * 10000);
+	CHECK(FrameAllocator::get_max_frame_usage() >= FrameAllocator::get_last_frame_usage());
+	CHECK(FrameAllocator::get_reserved() > 0);
+}
+
+} // namespace TestFrameAllocator
+
+#endif // TEST_FRAME_ALLOCATOR_H
@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName from_cstring = StringName("string_name_interning_test");
+	const StringName from_string = StringName(String("string_name_interning_test"));
+	const StringName from_static = StringName(StaticCString::create("string_name_interning_test"));
+
+	CHECK(from_cstring.data_unique_pointer() == from_string.data_unique_pointer());
+	CHECK(from_cstring.data_unique_pointer() == from_static.data_unique_pointer());
+	CHECK(StringName::search("string_name_interning_test") == from_cstring);
+	CHECK(StringName::search("string_name_not_interned_test") == StringName());
+}
+
+struct ConcurrentInterningData {
+	static const int name_count = 512;
+	static const int repetitions = 64;
+	Vector<StringName> kept;
+	SafeNumeric<uint32_t> mismatches;
+};
+
+static void concurrent_interning(void *p_arg, uint32_t p_index) {
+	ConcurrentInterningData *data = (ConcurrentInterningData *)p_arg;
+	for (int i = 0; i < ConcurrentInterningData::repetitions; i++) {
+		// Names are created and dropped all the time, so entries are also freed and re-created concurrently.
+		int name_index = (p_index + i * 31) % ConcurrentInterningData::name_count;
+		StringName name = StringName("concurrent_interning_" + itos(name_index));
+		StringName again = StringName(String(name));
+		StringName kept = StringName("concurrent_interning_kept_" + itos(name_index));
+		if (name.data_unique_pointer() != again.data_unique_pointer() || kept != data->kept[name_index]) {
+			data->mismatches.increment();
+		}
+	}
+}
+
+TEST_CASE("[StringName] Concurrent interning from many threads") {
+	ConcurrentInterningData data;
+
+	for (int i = 0; i < ConcurrentInterningData::name_count; i++) {
+		data.kept.push_back(StringName("concurrent_interning_kept_" + itos(i)));
+	}
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(concurrent_interning, &data, 4096, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	CHECK(data.mismatches.get() == 0);
+
+	// Names that stayed referenced the whole time must still resolve to the same entries.
+	for (int i = 0; i < ConcurrentInterningData::name_count; i++) {
+		CHECK(StringName::search("concurrent_interning_kept_" + itos(i)) == data.kept[i]);
+	}
+}
+
+static void benchmark_interning(void *p_arg, uint32_t p_index) {
+	const Vector<String> *names = (const Vector<String> *)p_arg;
+	for (const String &name : *names) {
+		StringName interned = StringName(name);
+	}
+}
+
+TEST_BENCHMARK("[StringName] Concurrent interning throughput") {
+	Vector<String> names;
+	for (int i = 0; i < 4096; i++) {
+		names.push_back("benchmark_interning_" + itos(i));
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	for (int tasks = 1; tasks <= pool->get_thread_count(); tasks++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(benchmark_interning, &names, tasks * 64, tasks, true);
+		pool->wait_for_group_task_completion(group);
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+		MESSAGE(vformat("%d threads: %d names/ms", tasks, uint64_t(tasks) * 64 * names.size() * 1000 / elapsed));
+	}
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
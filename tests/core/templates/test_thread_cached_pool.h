@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  test_thread_cached_pool.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_THREAD_CACHED_POOL_H
+#define TEST_THREAD_CACHED_POOL_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/thread_cached_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestThreadCachedPool {
+
+// A type of its own for each test case, so each one starts with an empty pool.
+template <int ID>
+struct Counted {
+	static SafeNumeric<int> alive;
+	uint64_t value = 0;
+
+	Counted(uint64_t p_value) {
+		value = p_value;
+		alive.increment();
+	}
+	~Counted() {
+		alive.decrement();
+	}
+};
+
+template <int ID>
+SafeNumeric<int> Counted<ID>::alive;
+
+TEST_CASE("[ThreadCachedPool] Allocate and free") {
+	typedef Counted<0> Object;
+	const int count = 4096;
+	LocalVector<Object *> objects;
+	for (int i = 0; i < count; i++) {
+		objects.push_back(ThreadCachedPool<Object>::alloc(i));
+	}
+	CHECK(Object::alive.get() == count);
+
+	bool all_match = true;
+	for (int i = 0; i < count; i++) {
+		all_match = all_match && objects[i]->value == uint64_t(i);
+	}
+	CHECK_MESSAGE(all_match, "Objects should keep their values, without overlapping.");
+
+	for (Object *object : objects) {
+		ThreadCachedPool<Object>::free(object);
+	}
+	CHECK(Object::alive.get() == 0);
+}
+
+TEST_CASE("[ThreadCachedPool] Release slabs once their blocks are free") {
+	typedef Counted<1> Object;
+	const int count = 4096;
+	LocalVector<Object *> objects;
+	objects.reserve(count);
+	uint64_t allocs_before = Memory::get_alloc_count();
+	for (int i = 0; i < count; i++) {
+		objects.push_back(ThreadCachedPool<Object>::alloc(i));
+	}
+	const uint64_t slab_allocs = Memory::get_alloc_count() - allocs_before;
+	CHECK(slab_allocs >= uint64_t(count) / 256);
+	CHECK(slab_allocs <= uint64_t(count) / 256 + 1);
+
+	for (Object *object : objects) {
+		ThreadCachedPool<Object>::free(object);
+	}
+	// The thread cache keeps a few blocks, and with them their slabs, and one empty slab is kept.
+	CHECK(Memory::get_alloc_count() - allocs_before <= 4);
+}
+
+static void free_objects(void *p_arg, uint32_t p_index) {
+	typedef Counted<2> Object;
+	LocalVector<Object *> *objects = (LocalVector<Object *> *)p_arg;
+	for (uint32_t i = p_index; i < objects->size(); i += 4) {
+		ThreadCachedPool<Object>::free((*objects)[i]);
+	}
+	// Allocated and freed on this thread, while others free theirs.
+	for (int i = 0; i < 100; i++) {
+		ThreadCachedPool<Object>::free(ThreadCachedPool<Object>::alloc(i));
+	}
+}
+
+TEST_CASE("[ThreadCachedPool] Free objects on other threads") {
+	typedef Counted<2> Object;
+	const int count = 4096;
+	LocalVector<Object *> objects;
+	for (int i = 0; i < count; i++) {
+		objects.push_back(ThreadCachedPool<Object>::alloc(i));
+	}
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(free_objects, &objects, 4, 4, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	CHECK(Object::alive.get() == 0);
+
+	// Blocks freed by other threads can be allocated again here.
+	objects.clear();
+	for (int i = 0; i < count; i++) {
+		objects.push_back(ThreadCachedPool<Object>::alloc(i));
+	}
+	CHECK(Object::alive.get() == count);
+	for (Object *object : objects) {
+		ThreadCachedPool<Object>::free(object);
+	}
+	CHECK(Object::alive.get() == 0);
+}
+
+} // namespace TestThreadCachedPool
+
+#endif // TEST_THREAD_CACHED_POOL_H
@@ -153,6 +153,110 @@ TEST_CASE("[WorkerThreadPool] Process 256 elements on native task group low prio
 	CHECK(callable_group_counter.get() == count - 1);
 }
 
+static void static_nested_group_test(void *p_arg, uint32_t p_index) {
+	// Posting from a pool thread pushes to its own queue, so the rest of the pool has to steal the work.
+	const int count = 64;
+	WorkerThreadPool::TaskID tasks[count];
+	for (int i = 0; i < count; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_test, p_arg, true);
+	}
+	for (int i = 0; i < count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from pool threads") {
+	const int count = 16;
+	SafeNumeric<uint32_t> counter;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_group_test, &counter, count, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	CHECK(counter.get() == count * 64);
+}
+
+struct DependencyTestData {
+	SafeNumeric<uint32_t> stage_one;
+	SafeNumeric<uint32_t> stage_two;
+	SafeNumeric<uint32_t> stage_one_seen_by_two;
+	SafeNumeric<uint32_t> stage_two_seen_by_three;
+};
+
+static void static_dependency_stage_one(void *p_arg, uint32_t p_index) {
+	DependencyTestData *data = (DependencyTestData *)p_arg;
+	data->stage_one.increment();
+}
+
+static void static_dependency_stage_two(void *p_arg, uint32_t p_index) {
+	DependencyTestData *data = (DependencyTestData *)p_arg;
+	data->stage_one_seen_by_two.exchange_if_greater(data->stage_one.get());
+	data->stage_two.increment();
+}
+
+static void static_dependency_stage_three(void *p_arg) {
+	DependencyTestData *data = (DependencyTestData *)p_arg;
+	data->stage_two_seen_by_three.set(data->stage_two.get());
+}
+
+TEST_CASE("[WorkerThreadPool] Dependent tasks and groups run after their dependencies") {
+	const int count = 256;
+	DependencyTestData data;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	WorkerThreadPool::GroupID one = pool->add_native_group_task(static_dependency_stage_one, &data, count, -1, true);
+	WorkerThreadPool::GroupID two = pool->add_native_dependent_group_task({ one }, static_dependency_stage_two, &data, count);
+	WorkerThreadPool::TaskID three = pool->add_native_dependent_task({ two }, static_dependency_stage_three, &data);
+
+	pool->wait_for_task_completion(three);
+	pool->wait_for_group_task_completion(two);
+	pool->wait_for_group_task_completion(one);
+
+	CHECK(data.stage_one_seen_by_two.get() == count);
+	CHECK(data.stage_two_seen_by_three.get() == count);
+
+	// Dependencies that were already waited for count as completed.
+	DependencyTestData late_data;
+	WorkerThreadPool::TaskID late = pool->add_native_dependent_task({ one, two, three }, static_dependency_stage_three, &late_data);
+	pool->wait_for_task_completion(late);
+	CHECK(late_data.stage_two_seen_by_three.get() == 0);
+}
+
+TEST_CASE("[WorkerThreadPool] Empty dependent group waits for its dependencies") {
+	DependencyTestData data;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	WorkerThreadPool::GroupID one = pool->add_native_group_task(static_dependency_stage_one, &data, 64, -1, true);
+	WorkerThreadPool::GroupID empty = pool->add_native_dependent_group_task({ one }, static_dependency_stage_two, &data, 0);
+	WorkerThreadPool::TaskID last = pool->add_native_dependent_task({ empty }, static_dependency_stage_three, &data);
+
+	pool->wait_for_task_completion(last);
+	CHECK(pool->is_group_task_completed(one));
+	CHECK(data.stage_one.get() == 64);
+	CHECK(data.stage_two.get() == 0);
+
+	pool->wait_for_group_task_completion(empty);
+	pool->wait_for_group_task_completion(one);
+}
+
+static void static_benchmark_group_test(void *p_arg, uint32_t p_index) {
+	SafeNumeric<uint64_t> *sum = (SafeNumeric<uint64_t> *)p_arg;
+	uint64_t hash = p_index;
+	for (int i = 0; i < 64; i++) {
+		hash = hash * 6364136223846793005ULL + 1442695040888963407ULL;
+	}
+	sum->add(hash & 1);
+}
+
+TEST_BENCHMARK("[WorkerThreadPool] Group task throughput for 1..N threads") {
+	const int count = 1 << 20;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	for (int tasks = 1; tasks <= pool->get_thread_count(); tasks++) {
+		SafeNumeric<uint64_t> sum;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_benchmark_group_test, &sum, count, tasks, true);
+		pool->wait_for_group_task_completion(group);
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+		MESSAGE(vformat("%d threads: %d elements/ms", tasks, uint64_t(count) * 1000 / elapsed));
+		CHECK(sum.get() <= uint64_t(count));
+	}
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
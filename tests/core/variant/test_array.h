@@ -31,6 +31,7 @@
 #ifndef TEST_ARRAY_H
 #define TEST_ARRAY_H
 
+#include "core/templates/local_vector.h"
 #include "core/variant/array.h"
 #include "tests/test_macros.h"
 #include "tests/test_tools.h"
@@ -516,6 +517,27 @@ TEST_CASE("[Array] Recursive self comparison") {
 	a2.clear();
 }
 
+TEST_CASE("[Array] Allocation count of small arrays") {
+	// Private blocks are pooled, leaving the element storage as the only allocation per array.
+	const int count = 1024;
+	LocalVector<Array> arrays;
+	arrays.reserve(count * 2);
+
+	uint64_t allocs_before = Memory::get_alloc_count();
+	for (int i = 0; i < count; i++) {
+		arrays.push_back(Array());
+	}
+	CHECK(Memory::get_alloc_count() - allocs_before < count / 16);
+
+	allocs_before = Memory::get_alloc_count();
+	for (int i = 0; i < count; i++) {
+		arrays.push_back(build_array(i, i + 1));
+	}
+	CHECK(Memory::get_alloc_count() - allocs_before < count + count / 16);
+
+	arrays.clear();
+}
+
 } // namespace TestArray
 
 #endif // TEST_ARRAY_H
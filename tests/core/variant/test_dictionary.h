@@ -31,6 +31,9 @@
 #ifndef TEST_DICTIONARY_H
 #define TEST_DICTIONARY_H
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/dictionary.h"
 #include "tests/test_macros.h"
 
@@ -531,6 +534,52 @@ TEST_CASE("[Dictionary] Order and find") {
 	CHECK_EQ(d.find_key("does not exist"), Variant());
 }
 
+TEST_CASE("[Dictionary] Allocation count of small dictionaries") {
+	// Private blocks and entries are pooled, leaving the two hash table buffers as the only allocations per dictionary.
+	const int count = 1024;
+	LocalVector<Dictionary> dictionaries;
+	dictionaries.reserve(count * 2);
+
+	uint64_t allocs_before = Memory::get_alloc_count();
+	for (int i = 0; i < count; i++) {
+		dictionaries.push_back(Dictionary());
+	}
+	CHECK(Memory::get_alloc_count() - allocs_before < count / 16);
+
+	allocs_before = Memory::get_alloc_count();
+	for (int i = 0; i < count; i++) {
+		Dictionary payload;
+		for (int j = 0; j < 4; j++) {
+			payload[j] = i + j;
+		}
+		dictionaries.push_back(payload);
+	}
+	CHECK(Memory::get_alloc_count() - allocs_before < 2 * count + count / 16);
+
+	dictionaries.clear();
+}
+
+static void benchmark_small_dictionaries(void *p_arg, uint32_t p_index) {
+	for (int i = 0; i < 1000; i++) {
+		// Like the payload of a signal or an RPC: a few entries, one of them an array.
+		Dictionary payload;
+		payload["id"] = i;
+		payload["position"] = Vector2(i, p_index);
+		payload["tags"] = build_array(i, p_index);
+	}
+}
+
+TEST_BENCHMARK("[Dictionary] Create and release small dictionaries on 1..N threads") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	for (int tasks = 1; tasks <= pool->get_thread_count(); tasks++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(benchmark_small_dictionaries, nullptr, tasks * 64, tasks, true);
+		pool->wait_for_group_task_completion(group);
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+		MESSAGE(vformat("%d threads: %d dictionaries/ms", tasks, uint64_t(tasks) * 64 * 1000 * 1000 / elapsed));
+	}
+}
+
 } // namespace TestDictionary
 
 #endif // TEST_DICTIONARY_H
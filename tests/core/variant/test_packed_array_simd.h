@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  test_packed_array_simd.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PACKED_ARRAY_SIMD_H
+#define TEST_PACKED_ARRAY_SIMD_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/packed_array_simd.h"
+#include "tests/test_macros.h"
+
+namespace TestPackedArraySIMD {
+
+// Compares the bits, so NaN is equal to itself.
+static bool floats_match(const float *p_a, const float *p_b, int p_count) {
+	return memcmp(p_a, p_b, sizeof(float) * p_count) == 0;
+}
+
+TEST_CASE("[PackedArraySIMD] Float kernels match the scalar versions") {
+	RandomPCG rng(42);
+
+	// Every size up to a few vectors, so the remainders after the vector loops are covered.
+	for (int count = 1; count < 40; count++) {
+		LocalVector<float> values;
+		LocalVector<float> other;
+		values.resize(count);
+		other.resize(count);
+		for (int i = 0; i < count; i++) {
+			values[i] = rng.random(-100.0f, 100.0f);
+			other[i] = rng.random(-100.0f, 100.0f);
+		}
+
+		CHECK(PackedArraySIMD::sum(values.ptr(), count) == PackedArraySIMD::sum_scalar(values.ptr(), count));
+		CHECK(PackedArraySIMD::dot(values.ptr(), other.ptr(), count) == PackedArraySIMD::dot_scalar(values.ptr(), other.ptr(), count));
+
+		if (count % 3 == 0) {
+			values[count / 2] = NAN;
+		}
+		float result = PackedArraySIMD::min_value(values.ptr(), count);
+		float expected = PackedArraySIMD::min_value_scalar(values.ptr(), count);
+		CHECK(floats_match(&result, &expected, 1));
+		result = PackedArraySIMD::max_value(values.ptr(), count);
+		expected = PackedArraySIMD::max_value_scalar(values.ptr(), count);
+		CHECK(floats_match(&result, &expected, 1));
+
+		LocalVector<float> simd = values;
+		LocalVector<float> scalar = values;
+		PackedArraySIMD::add(simd.ptr(), other.ptr(), count);
+		PackedArraySIMD::add_scalar(scalar.ptr(), other.ptr(), count);
+		CHECK(floats_match(simd.ptr(), scalar.ptr(), count));
+		PackedArraySIMD::multiply(simd.ptr(), other.ptr(), count);
+		PackedArraySIMD::multiply_scalar(scalar.ptr(), other.ptr(), count);
+		CHECK(floats_match(simd.ptr(), scalar.ptr(), count));
+		PackedArraySIMD::scale(simd.ptr(), 0.3f, count);
+		PackedArraySIMD::scale_scalar(scalar.ptr(), 0.3f, count);
+		CHECK(floats_match(simd.ptr(), scalar.ptr(), count));
+		PackedArraySIMD::lerp(simd.ptr(), other.ptr(), 0.7f, count);
+		PackedArraySIMD::lerp_scalar(scalar.ptr(), other.ptr(), 0.7f, count);
+		CHECK(floats_match(simd.ptr(), scalar.ptr(), count));
+
+		// Element types of 1 to 4 components, like floats, vectors and colors.
+		const float low[4] = { -50, -10, 0, 5 };
+		const float high[4] = { 50, 10, 20, 5 };
+		for (int components = 1; components <= 4; components++) {
+			int float_count = count - count % components;
+			simd = values;
+			scalar = values;
+			PackedArraySIMD::add_value(simd.ptr(), low, components, float_count);
+			PackedArraySIMD::add_value_scalar(scalar.ptr(), low, components, float_count);
+			CHECK(floats_match(simd.ptr(), scalar.ptr(), float_count));
+			PackedArraySIMD::clamp(simd.ptr(), low, high, components, float_count);
+			PackedArraySIMD::clamp_scalar(scalar.ptr(), low, high, components, float_count);
+			CHECK(floats_match(simd.ptr(), scalar.ptr(), float_count));
+		}
+	}
+}
+
+TEST_CASE("[PackedArraySIMD] Vector3 kernels match the scalar versions") {
+	RandomPCG rng(42);
+
+	Transform3D transform;
+	transform.basis = Basis(Vector3(1, 2, 3).normalized(), 0.7).scaled(Vector3(1, 2, 3));
+	transform.origin = Vector3(4, -5, 6);
+
+	for (int count = 1; count < 20; count++) {
+		LocalVector<Vector3> points;
+		LocalVector<Vector3> other;
+		for (int i = 0; i < count; i++) {
+			points.push_back(Vector3(rng.random(-100.0f, 100.0f), rng.random(-100.0f, 100.0f), rng.random(-100.0f, 100.0f)));
+			other.push_back(Vector3(rng.random(-100.0f, 100.0f), rng.random(-100.0f, 100.0f), rng.random(-100.0f, 100.0f)));
+		}
+
+		LocalVector<float> result;
+		LocalVector<float> expected;
+		result.resize(count);
+		expected.resize(count);
+		PackedArraySIMD::lengths(points.ptr(), count, result.ptr());
+		PackedArraySIMD::lengths_scalar(points.ptr(), count, expected.ptr());
+		CHECK(floats_match(result.ptr(), expected.ptr(), count));
+		PackedArraySIMD::dots(points.ptr(), other.ptr(), count, result.ptr());
+		PackedArraySIMD::dots_scalar(points.ptr(), other.ptr(), count, expected.ptr());
+		CHECK(floats_match(result.ptr(), expected.ptr(), count));
+
+		LocalVector<Vector3> transformed = points;
+		PackedArraySIMD::transform(transformed.ptr(), count, transform);
+		PackedArraySIMD::transform_scalar(points.ptr(), count, transform);
+		for (int i = 0; i < count; i++) {
+			CHECK(transformed[i] == points[i]);
+		}
+	}
+}
+
+TEST_BENCHMARK("[PackedArraySIMD] Bulk math methods on 100000 elements") {
+	const int count = 100000;
+	PackedFloat32Array values;
+	PackedVector3Array points;
+	values.resize(count);
+	points.resize(count);
+	for (int i = 0; i < count; i++) {
+		values.set(i, (i % 1000) / 1000.0f);
+		points.set(i, Vector3(i % 7, i % 11, i % 13));
+	}
+	PackedFloat32Array weights = values.duplicate();
+	weights.reverse();
+	const Transform3D transform(Basis(Vector3(0, 1, 0), 0.1), Vector3(1, 2, 3));
+
+	// Called through Variant, like scripts do.
+	Variant values_variant = values;
+	Variant points_variant = points;
+	double total = 0.0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 100; i++) {
+		values_variant.call("scale", 0.5);
+		values_variant.call("add_elements", weights);
+		values_variant.call("clamp_elements", 0.0, 1.0);
+		total += double(values_variant.call("sum")) + double(values_variant.call("dot", weights)) + double(values_variant.call("max"));
+		points_variant.call("transform", transform);
+		total += double(points_variant.call("lengths").call("sum"));
+	}
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(Math::is_finite(total));
+
+	float *ptr = values.ptrw();
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 100; i++) {
+		total += PackedArraySIMD::sum(ptr, count);
+	}
+	uint64_t simd_elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 100; i++) {
+		total += PackedArraySIMD::sum_scalar(ptr, count);
+	}
+	uint64_t scalar_elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("Kernels: %s.", PackedArraySIMD::get_instruction_set()));
+	MESSAGE(vformat("100 rounds of methods: %d usec.", elapsed));
+	MESSAGE(vformat("100 sums: %d usec, scalar: %d usec.", simd_elapsed, scalar_elapsed));
+}
+
+} // namespace TestPackedArraySIMD
+
+#endif // TEST_PACKED_ARRAY_SIMD_H
@@ -31,6 +31,7 @@
 #ifndef TEST_VARIANT_H
 #define TEST_VARIANT_H
 
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
@@ -738,6 +739,77 @@ TEST_CASE("[Variant] Writer and parser array") {
 	CHECK_MESSAGE(a_parsed == Variant(a), "Should parse back.");
 }
 
+TEST_CASE("[Variant] Writer and parser packed arrays") {
+	const Variant arrays[] = {
+		PackedByteArray({ 0, 1, 255 }),
+		PackedInt32Array({ -2147483647, 0, 2147483647 }),
+		PackedInt64Array({ -INT64_MAX, -1, INT64_MAX }),
+		PackedFloat32Array({ -1.5, 0.0, 1e-10, 3.25e12 }),
+		PackedFloat64Array({ -1.5, 0.1, 1e300 }),
+		PackedVector2Array({ Vector2(1, -2), Vector2(0.5, 4) }),
+		PackedVector3Array({ Vector3(1, -2, 3), Vector3(0.25, 0, -8) }),
+		PackedColorArray({ Color(1, 0, 0.5, 1), Color(0, 0.25, 1, 0.75) }),
+		PackedFloat32Array(),
+	};
+
+	for (const Variant &array : arrays) {
+		String array_str;
+		VariantWriter::write_to_string(array, array_str);
+
+		VariantParser::StreamString ss;
+		ss.s = array_str;
+		String errs;
+		int line = 1;
+		Variant array_parsed;
+		CHECK(VariantParser::parse(&ss, array_parsed, errs, line) == OK);
+		CHECK_MESSAGE(array_parsed == array, vformat("Should parse back: %s", array_str));
+	}
+
+	// Whitespace, comments and special values.
+	VariantParser::StreamString ss;
+	ss.s = "PackedFloat64Array( 1,\n\t-2.5e2 ; comment\n, inf, nan,inf_neg )";
+	String errs;
+	int line = 1;
+	Variant parsed;
+	REQUIRE(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	const PackedFloat64Array parsed_array = parsed;
+	REQUIRE(parsed_array.size() == 5);
+	CHECK(parsed_array[0] == 1.0);
+	CHECK(parsed_array[1] == -250.0);
+	CHECK(parsed_array[2] == INFINITY);
+	CHECK(Math::is_nan(parsed_array[3]));
+	CHECK(parsed_array[4] == -INFINITY);
+	CHECK(line == 3);
+
+	ss.s = "PackedInt32Array(1, 2 3)";
+	ERR_PRINT_OFF;
+	CHECK(VariantParser::parse(&ss, parsed, errs, line) == ERR_PARSE_ERROR);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Variant] Parser UTF-8 strings") {
+	const String str = String::utf8("Ünïcödé \"quoted\" ✓");
+	const String path = OS::get_singleton()->get_cache_path().path_join("variant_parser_utf8.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		// Escaped code points are decoded too.
+		f->store_string(String::utf8("[\"Ünïcödé \\\"quoted\\\" \\u2713\", \"\"]"));
+	}
+
+	VariantParser::StreamFile sf;
+	sf.f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(sf.f.is_valid());
+	String errs;
+	int line = 1;
+	Variant parsed;
+	REQUIRE(VariantParser::parse(&sf, parsed, errs, line) == OK);
+	const Array parsed_array = parsed;
+	REQUIRE(parsed_array.size() == 2);
+	CHECK(parsed_array[0] == Variant(str));
+	CHECK(parsed_array[1] == Variant(String()));
+}
+
 TEST_CASE("[Variant] Writer recursive array") {
 	// There is no way to accurately represent a recursive array,
 	// the only thing we can do is make sure the writer doesn't blow up
@@ -1171,6 +1243,30 @@ TEST_CASE("[Variant] Utility functions") {
 	}
 }
 
+TEST_CASE("[Variant] Builtin method lookup") {
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		Variant::Type type = Variant::Type(i);
+		List<StringName> method_names;
+		Variant::get_builtin_method_list(type, &method_names);
+
+		for (const StringName &E : method_names) {
+			TEST_COND(!Variant::has_builtin_method(type, E),
+					vformat("Method '%s' of type '%s' can't be found.", E, Variant::get_type_name(type)));
+		}
+		CHECK_FALSE(Variant::has_builtin_method(type, StringName()));
+		CHECK_FALSE(Variant::has_builtin_method(type, "_not_a_builtin_method"));
+	}
+
+	Variant string = "Godot";
+	Callable::CallError ce;
+	Variant ret;
+	string.callp("to_upper", nullptr, 0, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK(ret == Variant("GODOT"));
+	string.callp("_not_a_builtin_method", nullptr, 0, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD);
+}
+
 } // namespace TestVariant
 
 #endif // TEST_VARIANT_H
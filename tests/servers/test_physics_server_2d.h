@@ -0,0 +1,164 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+// A space with gravity and a static floor at y = 0, with a row of rigid circles of radius 16 falling onto it.
+// The floor is the first body.
+static RID create_falling_circles(PhysicsServer2D *p_server, int p_count, real_t p_spacing, Vector<RID> &r_bodies, Vector<RID> &r_shapes) {
+	RID space = p_server->space_create();
+	p_server->space_set_active(space, true);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	RID floor_shape = p_server->rectangle_shape_create();
+	p_server->shape_set_data(floor_shape, Vector2(p_count * p_spacing, 10));
+	r_shapes.push_back(floor_shape);
+	RID circle = p_server->circle_shape_create();
+	p_server->shape_set_data(circle, 16);
+	r_shapes.push_back(circle);
+
+	RID floor = p_server->body_create();
+	p_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	p_server->body_add_shape(floor, floor_shape);
+	p_server->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 10)));
+	p_server->body_set_space(floor, space);
+	r_bodies.push_back(floor);
+
+	for (int i = 0; i < p_count; i++) {
+		RID body = p_server->body_create();
+		p_server->body_add_shape(body, circle);
+		// Staggered heights, so they don't all land at once.
+		Vector2 position((i - p_count * 0.5) * p_spacing, -20 - (i % 4) * 40);
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, position));
+		p_server->body_set_space(body, space);
+		r_bodies.push_back(body);
+	}
+	return space;
+}
+
+static void get_body_states(PhysicsServer2D *p_server, const Vector<RID> &p_bodies, Vector<Transform2D> &r_transforms, Vector<Vector2> &r_velocities, Vector<bool> &r_sleeping) {
+	r_transforms.clear();
+	r_velocities.clear();
+	r_sleeping.clear();
+	for (const RID &body : p_bodies) {
+		r_transforms.push_back(p_server->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM));
+		r_velocities.push_back(p_server->body_get_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY));
+		r_sleeping.push_back(p_server->body_get_state(body, PhysicsServer2D::BODY_STATE_SLEEPING));
+	}
+}
+
+static int count_true(const Vector<bool> &p_values) {
+	int count = 0;
+	for (bool value : p_values) {
+		count += value ? 1 : 0;
+	}
+	return count;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Save and restore space state") {
+	PhysicsServer2D *server = PhysicsServer2D::get_singleton();
+
+	// The circles are close enough for the broadphase to pair neighbors that never touch,
+	// and those pairs decide which circles are in the same island when they fall asleep.
+	Vector<RID> bodies;
+	Vector<RID> shapes;
+	RID space = create_falling_circles(server, 32, 36, bodies, shapes);
+
+	// Save while the circles are landing, so there are contacts to warm start from,
+	// the highest ones only fall asleep in the steps after that.
+	for (int i = 0; i < 30; i++) {
+		server->step(1.0 / 60.0);
+	}
+	PackedByteArray state = server->space_save_state(space);
+	REQUIRE_FALSE(state.is_empty());
+
+	Vector<Transform2D> saved_transforms;
+	Vector<Vector2> saved_velocities;
+	Vector<bool> saved_sleeping;
+	get_body_states(server, bodies, saved_transforms, saved_velocities, saved_sleeping);
+
+	// Leaves the broadphase with a different history than the one of the space when saving.
+	for (int i = 0; i < 60; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	CHECK(server->space_restore_state(space, state) == OK);
+
+	Vector<Transform2D> transforms;
+	Vector<Vector2> velocities;
+	Vector<bool> sleeping;
+	get_body_states(server, bodies, transforms, velocities, sleeping);
+	CHECK_MESSAGE(transforms == saved_transforms, "Restoring should move the bodies back.");
+	CHECK_MESSAGE(velocities == saved_velocities, "Restoring should give back the velocities.");
+	CHECK_MESSAGE(sleeping == saved_sleeping, "Restoring should give back the sleep state.");
+
+	for (int i = 0; i < 60; i++) {
+		server->step(1.0 / 60.0);
+	}
+	Vector<Transform2D> first_transforms;
+	Vector<Vector2> first_velocities;
+	Vector<bool> first_sleeping;
+	get_body_states(server, bodies, first_transforms, first_velocities, first_sleeping);
+	CHECK_MESSAGE(count_true(first_sleeping) > count_true(saved_sleeping), "More circles should fall asleep after the restore.");
+
+	CHECK(server->space_restore_state(space, state) == OK);
+	for (int i = 0; i < 60; i++) {
+		server->step(1.0 / 60.0);
+	}
+	get_body_states(server, bodies, transforms, velocities, sleeping);
+	CHECK_MESSAGE(transforms == first_transforms, "Stepping after restoring the same state should give the exact same transforms.");
+	CHECK_MESSAGE(velocities == first_velocities, "Stepping after restoring the same state should give the exact same velocities.");
+	CHECK_MESSAGE(sleeping == first_sleeping, "Stepping after restoring the same state should put the same circles to sleep.");
+
+	ERR_PRINT_OFF;
+	CHECK(server->space_restore_state(space, PackedByteArray()) == ERR_INVALID_DATA);
+	CHECK(server->space_restore_state(space, state.slice(0, state.size() - 1)) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	for (const RID &shape : shapes) {
+		server->free(shape);
+	}
+	server->free(space);
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
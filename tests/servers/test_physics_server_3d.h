@@ -0,0 +1,599 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/physics_3d/godot_simd_3d.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// A static box with half extents of 1 at each of the given positions.
+static void create_boxes(PhysicsServer3D *p_server, RID p_space, RID p_shape, const Vector<Vector3> &p_positions, Vector<RID> &r_bodies) {
+	for (const Vector3 &position : p_positions) {
+		RID body = p_server->body_create();
+		p_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		p_server->body_add_shape(body, p_shape);
+		p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+		p_server->body_set_space(body, p_space);
+		r_bodies.push_back(body);
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched ray and shape queries") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	RID box = server->box_shape_create();
+	server->shape_set_data(box, Vector3(1, 1, 1));
+
+	Vector<Vector3> positions;
+	positions.push_back(Vector3(0, 0, 0));
+	positions.push_back(Vector3(10, 0, 0));
+	Vector<RID> bodies;
+	create_boxes(server, space, box, positions, bodies);
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	// Goes through the same methods as scripts. Enough rays to be split across several worker threads.
+	PackedVector3Array from;
+	PackedVector3Array to;
+	for (int i = 0; i < 500; i++) {
+		const real_t height = (i % 5) * 0.5 - 0.75;
+		from.push_back(Vector3(-5 + (i % 3) * 10, height, 0));
+		to.push_back(Vector3(20, height, 0));
+	}
+
+	Ref<PhysicsRayQueryParameters3D> ray_query;
+	ray_query.instantiate();
+	Dictionary rays = space_state->call("intersect_rays_batch", ray_query, from, to);
+	const PackedVector3Array ray_positions = rays["position"];
+	const PackedVector3Array ray_normals = rays["normal"];
+	const PackedInt32Array ray_shapes = rays["shape"];
+	REQUIRE(ray_positions.size() == from.size());
+
+	for (int i = 0; i < from.size(); i++) {
+		ray_query->set_from(from[i]);
+		ray_query->set_to(to[i]);
+		Dictionary ray = space_state->call("intersect_ray", ray_query);
+
+		CHECK_MESSAGE(ray.is_empty() == (ray_shapes[i] == -1), vformat("Ray %d should hit the same as intersect_ray().", i));
+		if (!ray.is_empty()) {
+			CHECK(ray_positions[i].is_equal_approx(ray["position"]));
+			CHECK(ray_normals[i].is_equal_approx(ray["normal"]));
+		}
+	}
+
+	// The first ray starts left of both boxes, every fifth one passes over them.
+	CHECK(ray_positions[0].is_equal_approx(Vector3(-1, -0.75, 0)));
+	CHECK(ray_normals[0].is_equal_approx(Vector3(-1, 0, 0)));
+	CHECK(ray_shapes[4] == -1);
+
+	RID sphere = server->sphere_shape_create();
+	server->shape_set_data(sphere, 0.5);
+
+	Ref<PhysicsShapeQueryParameters3D> shape_query;
+	shape_query.instantiate();
+	shape_query->set_shape_rid(sphere);
+
+	PackedVector3Array shape_positions;
+	shape_positions.push_back(Vector3(0, 1.25, 0));
+	shape_positions.push_back(Vector3(5, 0, 0));
+	shape_positions.push_back(Vector3(10, 0, 0));
+	Dictionary shapes = space_state->call("intersect_shapes_batch", shape_query, shape_positions, 4);
+	const PackedInt32Array result_counts = shapes["result_count"];
+	const PackedInt64Array collider_ids = shapes["collider_id"];
+	REQUIRE(result_counts.size() == 3);
+	CHECK(collider_ids.size() == 12);
+	CHECK(result_counts[0] == 1);
+	CHECK(result_counts[1] == 0);
+	CHECK(result_counts[2] == 1);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(sphere);
+	server->free(box);
+	server->free(space);
+}
+
+// A space with gravity and a static floor at y = 0, with a grid of rigid spheres of radius 0.5 falling onto it.
+// The floor is the first body.
+static RID create_falling_spheres(PhysicsServer3D *p_server, int p_grid_size, Vector<RID> &r_bodies, Vector<RID> &r_shapes, real_t p_spacing = 1.5) {
+	RID space = p_server->space_create();
+	p_server->space_set_active(space, true);
+	p_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	p_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	RID floor_shape = p_server->box_shape_create();
+	p_server->shape_set_data(floor_shape, Vector3(p_grid_size * 2, 1, p_grid_size * 2));
+	r_shapes.push_back(floor_shape);
+	RID sphere = p_server->sphere_shape_create();
+	p_server->shape_set_data(sphere, 0.5);
+	r_shapes.push_back(sphere);
+
+	Vector<Vector3> floor_position;
+	floor_position.push_back(Vector3(0, -1, 0));
+	create_boxes(p_server, space, floor_shape, floor_position, r_bodies);
+
+	for (int x = 0; x < p_grid_size; x++) {
+		for (int z = 0; z < p_grid_size; z++) {
+			RID body = p_server->body_create();
+			p_server->body_add_shape(body, sphere);
+			// Staggered heights, so they don't all land at once.
+			Vector3 position((x - p_grid_size * 0.5) * p_spacing, 1 + (x + z) % 4, (z - p_grid_size * 0.5) * p_spacing);
+			p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+			p_server->body_set_space(body, space);
+			r_bodies.push_back(body);
+		}
+	}
+	return space;
+}
+
+static void free_rids(PhysicsServer3D *p_server, const Vector<RID> &p_rids) {
+	for (const RID &rid : p_rids) {
+		p_server->free(rid);
+	}
+}
+
+// The vertices of a box with the given half extents, for convex polygon shapes.
+static PackedVector3Array get_box_points(const Vector3 &p_half_extents) {
+	PackedVector3Array points;
+	for (int i = 0; i < 8; i++) {
+		points.push_back(Vector3((i & 1) ? 1 : -1, (i & 2) ? 1 : -1, (i & 4) ? 1 : -1) * p_half_extents);
+	}
+	return points;
+}
+
+// Deepest penetration between the shape at the transform and the bodies in the space, or 0 if they don't collide.
+static real_t get_penetration_depth(PhysicsDirectSpaceState3D *p_space_state, RID p_shape, const Transform3D &p_transform) {
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	parameters.shape_rid = p_shape;
+	parameters.transform = p_transform;
+
+	const int max_pairs = 16;
+	Vector3 points[max_pairs * 2];
+	int pair_count = 0;
+	if (!p_space_state->collide_shape(parameters, points, max_pairs, pair_count)) {
+		return 0;
+	}
+
+	real_t depth = 0;
+	for (int i = 0; i < pair_count; i++) {
+		depth = MAX(depth, points[i * 2].distance_to(points[i * 2 + 1]));
+	}
+	return depth;
+}
+
+TEST_CASE("[PhysicsServer3D] SIMD convex kernels match the scalar versions") {
+	RandomPCG rng(42);
+
+	for (int test = 0; test < 500; test++) {
+		// Points on a coarse grid, so there are ties for the support point.
+		LocalVector<Vector3> points;
+		int point_count = 1 + rng.rand() % 40;
+		for (int i = 0; i < point_count; i++) {
+			points.push_back(Vector3(rng.rand() % 9, rng.rand() % 9, rng.rand() % 9) - Vector3(4, 4, 4));
+		}
+		Vector3 dir = Vector3(rng.rand() % 5, rng.rand() % 5, rng.rand() % 5) - Vector3(2, 2, 2);
+
+		real_t min = 0, max = 0, scalar_min = 0, scalar_max = 0;
+		GodotSIMD3D::project_range(points.ptr(), point_count, dir, min, max);
+		GodotSIMD3D::project_range_scalar(points.ptr(), point_count, dir, scalar_min, scalar_max);
+		CHECK(min == scalar_min);
+		CHECK(max == scalar_max);
+
+		CHECK(GodotSIMD3D::get_support_index(points.ptr(), point_count, dir) == GodotSIMD3D::get_support_index_scalar(points.ptr(), point_count, dir));
+
+		// Arcs between consecutive points, against the arc from dir to the first point.
+		int stride = GodotSIMD3D::get_arc_stride(point_count);
+		LocalVector<real_t> arcs;
+		arcs.resize(stride * 9);
+		memset(arcs.ptr(), 0, sizeof(real_t) * arcs.size());
+		for (int i = 0; i < point_count; i++) {
+			const Vector3 &c = points[i];
+			const Vector3 &d = points[(i + 1) % point_count];
+			GodotSIMD3D::set_arc(arcs.ptr(), stride, i, c, d, d.cross(c));
+		}
+
+		Vector3 a = dir;
+		Vector3 b = points[0] + Vector3(0.25, 0.5, -0.75);
+		LocalVector<int> found;
+		LocalVector<int> scalar_found;
+		found.resize(stride);
+		scalar_found.resize(stride);
+		int found_count = GodotSIMD3D::find_minkowski_faces(a, b, b.cross(a), arcs.ptr(), stride, point_count, found.ptr());
+		int scalar_found_count = GodotSIMD3D::find_minkowski_faces_scalar(a, b, b.cross(a), arcs.ptr(), stride, point_count, scalar_found.ptr());
+		REQUIRE(found_count == scalar_found_count);
+		for (int i = 0; i < found_count; i++) {
+			CHECK(found[i] == scalar_found[i]);
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Convex collision") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	RID box = server->box_shape_create();
+	server->shape_set_data(box, Vector3(1, 1, 1));
+	RID convex = server->convex_polygon_shape_create();
+	server->shape_set_data(convex, get_box_points(Vector3(1, 1, 1)));
+
+	RID small_box = server->box_shape_create();
+	server->shape_set_data(small_box, Vector3(0.5, 0.5, 0.5));
+	RID small_convex = server->convex_polygon_shape_create();
+	server->shape_set_data(small_convex, get_box_points(Vector3(0.5, 0.5, 0.5)));
+	RID capsule = server->capsule_shape_create();
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.5;
+	capsule_data["height"] = 2.0;
+	server->shape_set_data(capsule, capsule_data);
+
+	RID body = server->body_create();
+	server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_set_space(body, space);
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	SUBCASE("Box against box") {
+		server->body_add_shape(body, box);
+		CHECK(get_penetration_depth(space_state, small_box, Transform3D(Basis(), Vector3(1.4, 0, 0))) == doctest::Approx(0.1).epsilon(0.01));
+		CHECK(get_penetration_depth(space_state, small_box, Transform3D(Basis(), Vector3(0.2, 1.25, 0.3))) == doctest::Approx(0.25).epsilon(0.01));
+		CHECK(get_penetration_depth(space_state, small_box, Transform3D(Basis(), Vector3(1.6, 0, 0))) == 0);
+	}
+
+	SUBCASE("Capsule against convex") {
+		server->body_add_shape(body, convex);
+		CHECK(get_penetration_depth(space_state, capsule, Transform3D(Basis(), Vector3(1.4, 0, 0))) == doctest::Approx(0.1).epsilon(0.01));
+		CHECK(get_penetration_depth(space_state, capsule, Transform3D(Basis(), Vector3(0, 0, -1.3))) == doctest::Approx(0.2).epsilon(0.01));
+		CHECK(get_penetration_depth(space_state, capsule, Transform3D(Basis(), Vector3(1.6, 0, 0))) == 0);
+		// Lying down over the top face.
+		CHECK(get_penetration_depth(space_state, capsule, Transform3D(Basis(Vector3(0, 0, 1), Math_PI / 2), Vector3(0, 1.3, 0))) == doctest::Approx(0.2).epsilon(0.01));
+	}
+
+	SUBCASE("Convex against convex") {
+		server->body_add_shape(body, convex);
+		CHECK(get_penetration_depth(space_state, small_convex, Transform3D(Basis(), Vector3(1.4, 0, 0))) == doctest::Approx(0.1).epsilon(0.01));
+
+		// Turned on its edge, the small box reaches sqrt(0.5) towards the big one.
+		Basis turned(Vector3(0, 1, 0), Math_PI / 4);
+		CHECK(get_penetration_depth(space_state, small_convex, Transform3D(turned, Vector3(1.6, 0, 0))) == doctest::Approx(1.0 + Math_SQRT12 - 1.6).epsilon(0.01));
+		CHECK(get_penetration_depth(space_state, small_convex, Transform3D(turned, Vector3(1.8, 0, 0))) == 0);
+
+		// Turned around two axes, only its corners and edges face the big box, so the edge-edge axes are tested.
+		// The plane x = 1 separates them once the leftmost corner is past it.
+		Basis tilted = Basis(Vector3(0, 0, 1), Math_PI / 4) * turned;
+		PackedVector3Array corners = get_box_points(Vector3(0.5, 0.5, 0.5));
+		real_t reach = 0;
+		for (const Vector3 &corner : corners) {
+			reach = MAX(reach, -tilted.xform(corner).x);
+		}
+		CHECK(get_penetration_depth(space_state, small_convex, Transform3D(tilted, Vector3(1 + reach - 0.05, 0, 0))) > 0);
+		CHECK(get_penetration_depth(space_state, small_convex, Transform3D(tilted, Vector3(1 + reach + 0.05, 0, 0))) == 0);
+	}
+
+	SUBCASE("Large convex against large convex") {
+		// Enough edges for the edge tests to use a per-thread buffer instead of the stack.
+		PackedVector3Array sphere_points;
+		for (int i = 0; i < 16; i++) {
+			for (int j = 0; j < 16; j++) {
+				real_t polar = Math_PI * (i + 0.5) / 16;
+				real_t azimuth = Math_TAU * j / 16;
+				sphere_points.push_back(Vector3(Math::sin(polar) * Math::cos(azimuth), Math::cos(polar), Math::sin(polar) * Math::sin(azimuth)));
+			}
+		}
+		RID sphere = server->convex_polygon_shape_create();
+		server->shape_set_data(sphere, sphere_points);
+		server->body_add_shape(body, sphere);
+
+		Basis rotation(Vector3(1, 1, 0).normalized(), 0.3);
+		CHECK(get_penetration_depth(space_state, sphere, Transform3D(rotation, Vector3(1.8, 0.1, 0))) > 0);
+		CHECK(get_penetration_depth(space_state, sphere, Transform3D(rotation, Vector3(2.2, 0.1, 0))) == 0);
+
+		server->body_remove_shape(body, 0);
+		server->free(sphere);
+	}
+
+	server->free(body);
+	server->free(capsule);
+	server->free(small_convex);
+	server->free(small_box);
+	server->free(convex);
+	server->free(box);
+	server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Bodies fall and come to rest") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	Vector<RID> bodies;
+	Vector<RID> shapes;
+	RID space = create_falling_spheres(server, 12, bodies, shapes);
+
+	// Enough bodies that they are integrated on several worker threads.
+	for (int i = 0; i < 240; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	for (int i = 1; i < bodies.size(); i++) {
+		Transform3D transform = server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(transform.origin.y == doctest::Approx(0.5).epsilon(0.05), vformat("Sphere %d should rest on the floor.", i));
+	}
+
+	free_rids(server, bodies);
+	free_rids(server, shapes);
+	server->free(space);
+}
+
+static void get_body_states(PhysicsServer3D *p_server, const Vector<RID> &p_bodies, Vector<Transform3D> &r_transforms, Vector<Vector3> &r_velocities, Vector<bool> &r_sleeping) {
+	r_transforms.clear();
+	r_velocities.clear();
+	r_sleeping.clear();
+	for (const RID &body : p_bodies) {
+		r_transforms.push_back(p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		r_velocities.push_back(p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY));
+		r_sleeping.push_back(p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_SLEEPING));
+	}
+}
+
+static int count_true(const Vector<bool> &p_values) {
+	int count = 0;
+	for (bool value : p_values) {
+		count += value ? 1 : 0;
+	}
+	return count;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Save and restore space state") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	// The spheres are close enough for the broadphase to pair neighbors that never touch,
+	// and those pairs decide which spheres are in the same island when they fall asleep.
+	Vector<RID> bodies;
+	Vector<RID> shapes;
+	RID space = create_falling_spheres(server, 8, bodies, shapes, 1.1);
+
+	// Save while the spheres are landing, so there are contacts to warm start from,
+	// the highest ones only fall asleep in the steps after that.
+	for (int i = 0; i < 60; i++) {
+		server->step(1.0 / 60.0);
+	}
+	PackedByteArray state = server->space_save_state(space);
+	REQUIRE_FALSE(state.is_empty());
+
+	Vector<Transform3D> saved_transforms;
+	Vector<Vector3> saved_velocities;
+	Vector<bool> saved_sleeping;
+	get_body_states(server, bodies, saved_transforms, saved_velocities, saved_sleeping);
+
+	// Leaves the broadphase with a different history than the one of the space when saving.
+	for (int i = 0; i < 60; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	CHECK(server->space_restore_state(space, state) == OK);
+
+	Vector<Transform3D> transforms;
+	Vector<Vector3> velocities;
+	Vector<bool> sleeping;
+	get_body_states(server, bodies, transforms, velocities, sleeping);
+	CHECK_MESSAGE(transforms == saved_transforms, "Restoring should move the bodies back.");
+	CHECK_MESSAGE(velocities == saved_velocities, "Restoring should give back the velocities.");
+	CHECK_MESSAGE(sleeping == saved_sleeping, "Restoring should give back the sleep state.");
+
+	for (int i = 0; i < 60; i++) {
+		server->step(1.0 / 60.0);
+	}
+	Vector<Transform3D> first_transforms;
+	Vector<Vector3> first_velocities;
+	Vector<bool> first_sleeping;
+	get_body_states(server, bodies, first_transforms, first_velocities, first_sleeping);
+	CHECK_MESSAGE(count_true(first_sleeping) > count_true(saved_sleeping), "More spheres should fall asleep after the restore.");
+
+	CHECK(server->space_restore_state(space, state) == OK);
+	for (int i = 0; i < 60; i++) {
+		server->step(1.0 / 60.0);
+	}
+	get_body_states(server, bodies, transforms, velocities, sleeping);
+	CHECK_MESSAGE(transforms == first_transforms, "Stepping after restoring the same state should give the exact same transforms.");
+	CHECK_MESSAGE(velocities == first_velocities, "Stepping after restoring the same state should give the exact same velocities.");
+	CHECK_MESSAGE(sleeping == first_sleeping, "Stepping after restoring the same state should put the same spheres to sleep.");
+
+	ERR_PRINT_OFF;
+	CHECK(server->space_restore_state(space, PackedByteArray()) == ERR_INVALID_DATA);
+	CHECK(server->space_restore_state(space, state.slice(0, state.size() - 1)) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+
+	free_rids(server, bodies);
+	free_rids(server, shapes);
+	server->free(space);
+}
+
+TEST_BENCHMARK("[SceneTree][PhysicsServer3D] Step falling bodies") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	// A scene small enough to be integrated serially, a typical one, and a large one with 50176 bodies.
+	const int grid_sizes[] = { 8, 70, 224 };
+	const int step_counts[] = { 600, 120, 30 };
+
+	for (int i = 0; i < 3; i++) {
+		Vector<RID> bodies;
+		Vector<RID> shapes;
+		RID space = create_falling_spheres(server, grid_sizes[i], bodies, shapes);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int j = 0; j < step_counts[i]; j++) {
+			server->step(1.0 / 60.0);
+		}
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%d bodies: %d steps in %d usec, %d usec per step.", bodies.size() - 1, step_counts[i], elapsed, elapsed / step_counts[i]));
+
+		free_rids(server, bodies);
+		free_rids(server, shapes);
+		server->free(space);
+	}
+}
+
+TEST_BENCHMARK("[SceneTree][PhysicsServer3D] Line of sight rays") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	RID box = server->box_shape_create();
+	server->shape_set_data(box, Vector3(1, 1, 1));
+
+	Vector<Vector3> positions;
+	for (int x = 0; x < 32; x++) {
+		for (int z = 0; z < 32; z++) {
+			positions.push_back(Vector3(x * 4, 0, z * 4));
+		}
+	}
+	Vector<RID> bodies;
+	create_boxes(server, space, box, positions, bodies);
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	const int ray_count = 20000;
+	PackedVector3Array from;
+	PackedVector3Array to;
+	for (int i = 0; i < ray_count; i++) {
+		from.push_back(Vector3((i * 7) % 128, 0.5, (i * 13) % 128));
+		to.push_back(Vector3((i * 31) % 128, 0.5, (i * 17) % 128));
+	}
+
+	Ref<PhysicsRayQueryParameters3D> ray_query;
+	ray_query.instantiate();
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < ray_count; i++) {
+		ray_query->set_from(from[i]);
+		ray_query->set_to(to[i]);
+		space_state->call("intersect_ray", ray_query);
+	}
+	uint64_t single_elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	space_state->call("intersect_rays_batch", ray_query, from, to);
+	uint64_t batch_elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("intersect_ray: %d usec, intersect_rays_batch: %d usec.", single_elapsed, batch_elapsed));
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(box);
+	server->free(space);
+}
+
+TEST_BENCHMARK("[SceneTree][PhysicsServer3D] Convex collision") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+
+	// A rounded convex hull with a few dozen vertices, as generated for typical meshes.
+	PackedVector3Array hull_points;
+	for (int i = 0; i < 6; i++) {
+		for (int j = 0; j < 8; j++) {
+			real_t polar = Math_PI * (i + 0.5) / 6;
+			real_t azimuth = Math_TAU * j / 8;
+			hull_points.push_back(Vector3(Math::sin(polar) * Math::cos(azimuth), Math::cos(polar), Math::sin(polar) * Math::sin(azimuth)));
+		}
+	}
+
+	RID box = server->box_shape_create();
+	server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	RID hull = server->convex_polygon_shape_create();
+	server->shape_set_data(hull, hull_points);
+	RID capsule = server->capsule_shape_create();
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.5;
+	capsule_data["height"] = 2.0;
+	server->shape_set_data(capsule, capsule_data);
+
+	struct ShapePair {
+		const char *name;
+		RID body_shape;
+		RID query_shape;
+	};
+	const ShapePair pairs[] = {
+		{ "box/box", box, box },
+		{ "convex/capsule", hull, capsule },
+		{ "convex/convex", hull, hull },
+	};
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	MESSAGE(vformat("Convex kernels: %s.", GodotSIMD3D::get_instruction_set()));
+
+	for (const ShapePair &pair : pairs) {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(body, pair.body_shape);
+		server->body_set_space(body, space);
+
+		// Slightly overlapping, at varying angles.
+		const int query_count = 20000;
+		Vector3 points[16];
+		int pair_count = 0;
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = pair.query_shape;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			Basis rotation(Vector3(1, 1, 0).normalized(), i * 0.01);
+			parameters.transform = Transform3D(rotation, rotation.xform(Vector3(1.2, 0, 0)));
+			space_state->collide_shape(parameters, points, 8, pair_count);
+		}
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%s: %d collide_shape() in %d usec.", pair.name, query_count, elapsed));
+
+		server->free(body);
+	}
+
+	server->free(capsule);
+	server->free(hull);
+	server->free(box);
+	server->free(space);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
@@ -48,6 +48,10 @@
 // The test case is marked as failed, but does not fail the entire test run.
 #define TEST_CASE_MAY_FAIL(name) TEST_CASE(name *doctest::may_fail())
 
+// The test is a benchmark, those only run with `--test --benchmark`, which runs nothing else.
+// Pick some with `--test-case` as usual. Timings are reported with `MESSAGE()`.
+#define TEST_BENCHMARK(name) TEST_CASE(name *doctest::test_suite("[Benchmark]"))
+
 // Provide aliases to conform with Godot naming conventions (see error macros).
 #define TEST_COND(cond, ...) DOCTEST_CHECK_FALSE_MESSAGE(cond, __VA_ARGS__)
 #define TEST_FAIL(cond, ...) DOCTEST_FAIL(cond, __VA_ARGS__)
@@ -45,6 +45,7 @@
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
 #include "tests/core/math/test_basis.h"
+#include "tests/core/math/test_bvh.h"
 #include "tests/core/math/test_color.h"
 #include "tests/core/math/test_expression.h"
 #include "tests/core/math/test_geometry_2d.h"
@@ -66,9 +67,11 @@
 #include "tests/core/object/test_class_db.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
+#include "tests/core/os/test_frame_allocator.h"
 #include "tests/core/os/test_os.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/templates/test_command_queue.h"
 #include "tests/core/templates/test_hash_map.h"
@@ -78,6 +81,7 @@
 #include "tests/core/templates/test_lru.h"
 #include "tests/core/templates/test_paged_array.h"
 #include "tests/core/templates/test_rid.h"
+#include "tests/core/templates/test_thread_cached_pool.h"
 #include "tests/core/templates/test_vector.h"
 #include "tests/core/test_crypto.h"
 #include "tests/core/test_hashing_context.h"
@@ -85,6 +89,7 @@
 #include "tests/core/threads/test_worker_thread_pool.h"
 #include "tests/core/variant/test_array.h"
 #include "tests/core/variant/test_dictionary.h"
+#include "tests/core/variant/test_packed_array_simd.h"
 #include "tests/core/variant/test_variant.h"
 #include "tests/scene/test_animation.h"
 #include "tests/scene/test_arraymesh.h"
@@ -103,6 +108,8 @@
 #include "tests/scene/test_theme.h"
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
+#include "tests/servers/test_physics_server_2d.h"
+#include "tests/servers/test_physics_server_3d.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 
@@ -148,11 +155,14 @@ int test_main(int argc, char *argv[]) {
 	// Doctest runner.
 	doctest::Context test_context;
 	List<String> test_args;
+	bool run_benchmarks = false;
 
-	// Clean arguments of "--test" from the args.
+	// Clean arguments of "--test" and "--benchmark" from the args.
 	for (int x = 0; x < argc; x++) {
 		String arg = String(argv[x]);
-		if (arg != "--test") {
+		if (arg == "--benchmark") {
+			run_benchmarks = true;
+		} else if (arg != "--test") {
 			test_args.push_back(arg);
 		}
 	}
@@ -178,6 +188,13 @@ int test_main(int argc, char *argv[]) {
 		delete[] doctest_args;
 	}
 
+	// Benchmarks take long and their timings are only meaningful on their own, see `TEST_BENCHMARK`.
+	if (run_benchmarks) {
+		test_context.addFilter("test-suite", "[Benchmark]");
+	} else {
+		test_context.addFilter("test-suite-exclude", "[Benchmark]");
+	}
+
 	return test_context.run();
 }
 